@@ -0,0 +1,142 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <freeflow/sdn/topology.hpp>
+#include <freeflow/proto/ofp/v1.0/message.hpp>
+
+#include "discovery.hpp"
+
+using namespace ff;
+
+namespace v1_0 = ff::ofp::v1_0;
+
+namespace {
+
+// Probes are sent out of every port this often.
+constexpr Seconds probe_interval = 5_s;
+
+// A link is taken down if no probe crosses it for this long.
+constexpr Seconds link_timeout = 15_s;
+
+} // namespace
+
+/// The application factory.
+static Factory factory_;
+
+extern "C" void*
+factory() { return &factory_; }
+
+ff::Application* 
+Factory::create(ff::Controller& c) { return new Discovery(c); }
+
+void 
+Factory::destroy(ff::Application* a) { delete a; }
+
+/// Subscribe to returning probes and build the probe template.
+Discovery::Discovery(ff::Controller& c)
+  : ff::Application(c), probed_(now())
+{
+  Subscription s;
+  s.events = Event_set {Event::UNBIND, Event::FEATURES_KNOWN, 
+                        Event::PACKET_IN};
+  s.eth_types = {eth_type::LLDP};
+  subscribe(s);
+
+  v1_0::Packet_out po = v1_0::Packet_out();
+  po.buffer_id = Packet::NO_BUFFER;
+  po.port = v1_0::Port::NONE;
+  po.actions.push_back(v1_0::output_action());
+  po.actions_len = bytes(po.actions);
+  packet_.encode(v1_0::Header(v1_0::PACKET_OUT, 8 + bytes(po), 0), po);
+}
+
+/// Remove the switch, and its links, from the topology.
+void
+Discovery::unbind(ff::Switch& sw) {
+  auto iter = switches_.find(&sw);
+  if (iter == switches_.end())
+    return;
+  Uint64 dpid = iter->second;
+  controller().topology().remove_switch(dpid);
+  seen_.erase(seen_.lower_bound(Port_id(dpid, 0)), 
+              seen_.upper_bound(Port_id(dpid, Uint16(-1))));
+  switches_.erase(iter);
+}
+
+/// Add the switch to the topology and probe its ports.
+void
+Discovery::features_known(ff::Switch& sw) {
+  Uint64 dpid = sw.datapath().datapath_id;
+  switches_[&sw] = dpid;
+  controller().topology().add_switch(dpid);
+  probe(sw, dpid);
+}
+
+/// A returning probe brings up the link it crossed.
+void
+Discovery::packet_in(ff::Switch& sw, const ff::Packet& p) {
+  auto iter = switches_.find(&sw);
+  Uint64 src;
+  Uint16 port;
+  if (iter == switches_.end() or not read_probe(p, src, port))
+    return;
+  if (not controller().topology().contains(src))
+    return;
+  controller().topology().link_up(Link {src, port, iter->second, 
+                                        p.key().in_port});
+  seen_[Port_id(src, port)] = now();
+}
+
+/// Probe every switch once per interval, and take down the links that
+/// have not been seen recently.
+void
+Discovery::tick() {
+  Time_point t = now();
+  if (t - probed_ < probe_interval)
+    return;
+  for (auto& s : switches_)
+    probe(*s.first, s.second);
+  probed_ = t;
+  expire(t);
+}
+
+// Send a probe out of each physical port of the switch.
+void
+Discovery::probe(ff::Switch& sw, Uint64 dpid) {
+  for (const ff::Port& p : sw.datapath().ports) {
+    if (p.port_number > v1_0::Port::MAX)
+      continue;
+    Uint16 port = p.port_number;
+    Buffer b = packet_.buffer();
+    patch(b, v1_0::packet_out_output_port, port);
+    Buffer f = make_probe(dpid, port);
+    b.insert(b.end(), f.begin(), f.end());
+    patch(b, ofp::header_length, Uint16(b.size()));
+    sw.flows().push(std::move(b));
+  }
+}
+
+// Take down the links last seen before the timeout.
+void
+Discovery::expire(Time_point t) {
+  for (auto iter = seen_.begin(); iter != seen_.end(); ) {
+    if (t - iter->second >= link_timeout) {
+      controller().topology().link_down(iter->first.first, 
+                                        iter->first.second);
+      iter = seen_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef APPS_DISCOVERY_HPP
+#define APPS_DISCOVERY_HPP
+
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include <freeflow/sdn/application.hpp>
+#include <freeflow/sdn/controller.hpp>
+#include <freeflow/sdn/switch.hpp>
+#include <freeflow/proto/ofp/template.hpp>
+
+namespace ff = freeflow;
+
+class Factory;
+class Discovery;
+
+/// The Discovery application maintains the controller's topology. When
+/// a switch's features are known, it is added to the topology and an
+/// LLDP probe is sent out of each of its ports. Probes are repeated
+/// periodically. A probe returned by another switch reveals the link
+/// from the probed port to the port it arrived on. Links that are not
+/// seen again within a few probe intervals are taken down.
+///
+/// Routing applications query the topology through the controller.
+/// Only OpenFlow 1.0 is supported.
+class Discovery : public ff::Application {
+public:
+  Discovery(ff::Controller&);
+
+  void unbind(ff::Switch&) override;
+  void features_known(ff::Switch&) override;
+  void packet_in(ff::Switch&, const ff::Packet&) override;
+  void tick() override;
+
+private:
+  using Port_id = std::pair<ff::Uint64, ff::Uint16>;
+
+  void probe(ff::Switch&, ff::Uint64);
+  void expire(ff::Time_point);
+
+  std::unordered_map<ff::Switch*, ff::Uint64> switches_; // Known datapaths
+  std::map<Port_id, ff::Time_point> seen_; // Last sighting of each link
+
+  ff::Time_point            probed_; // When probes were last sent
+  ff::ofp::Message_template packet_; // A packet-out with one output
+};
+
+
+/// Create instances of the Discovery application.
+class Factory : public ff::Application_factory {
+  ff::Application* create(ff::Controller&);
+  void destroy(ff::Application*);
+};
+
+#endif
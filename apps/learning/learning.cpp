@@ -0,0 +1,186 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <freeflow/proto/ofp/v1.0/message.hpp>
+
+#include "learning.hpp"
+
+using namespace ff;
+
+namespace v1_0 = ff::ofp::v1_0;
+
+namespace {
+
+// Flows idle for this many seconds are removed by the switch.
+constexpr Uint16 idle_timeout = 10;
+
+// Flows are removed after this many seconds regardless, so that a host
+// that moves is eventually re-learned.
+constexpr Uint16 hard_timeout = 60;
+
+inline bool
+is_multicast(const Uint8* mac) { return mac[0] & 0x01; }
+
+// Returns true if the address is one of the reserved link-local groups
+// 01:80:c2:00:00:00 through 0f, which bridges must not forward.
+inline bool
+is_link_local(const Uint8* mac) {
+  return mac[0] == 0x01 and mac[1] == 0x80 and mac[2] == 0xc2
+     and mac[3] == 0x00 and mac[4] == 0x00 and (mac[5] & 0xf0) == 0x00;
+}
+
+} // namespace
+
+/// The application factory.
+static Factory factory_;
+
+extern "C" void*
+factory() { return &factory_; }
+
+ff::Application* 
+Factory::create(ff::Controller& c) { return new Learning(c); }
+
+void 
+Factory::destroy(ff::Application* a) { delete a; }
+
+Learning::Switch_state::Switch_state()
+  : swept(now()), batches(0) { }
+
+/// Subscribe to packet-ins and build the message templates.
+Learning::Learning(ff::Controller& c)
+  : ff::Application(c) 
+{
+  Subscription s;
+  s.events = Event_set {Event::BIND, Event::UNBIND, Event::PACKET_IN};
+  subscribe(s);
+
+  v1_0::Flow_mod fm = v1_0::Flow_mod();
+  fm.command = v1_0::Flow_mod::ADD;
+  fm.idle_timeout = idle_timeout;
+  fm.hard_timeout = hard_timeout;
+  fm.priority = 0x8000;
+  fm.buffer_id = Packet::NO_BUFFER;
+  fm.out_port = v1_0::Port::NONE;
+  fm.actions.push_back(v1_0::output_action());
+  flow_.encode(v1_0::Header(v1_0::FLOW_MOD, 8 + bytes(fm), 0), fm);
+
+  v1_0::Packet_out po = v1_0::Packet_out();
+  po.buffer_id = Packet::NO_BUFFER;
+  po.port = v1_0::Port::NONE;
+  po.actions.push_back(v1_0::output_action());
+  po.actions_len = bytes(po.actions);
+  packet_.encode(v1_0::Header(v1_0::PACKET_OUT, 8 + bytes(po), 0), po);
+}
+
+/// Start learning on the switch. Acknowledged batches of rules release
+/// the flows held while the rules were in flight.
+void
+Learning::bind(ff::Switch& sw) {
+  Switch_state& s = switches_[&sw];
+  s.batches = sw.flows().on_batch([this, &sw](const Flow_batch& b) {
+    auto iter = switches_.find(&sw);
+    if (iter != switches_.end())
+      acknowledge(sw, iter->second, b.last);
+  });
+}
+
+/// Discard the learning state of the switch.
+void
+Learning::unbind(ff::Switch& sw) {
+  auto iter = switches_.find(&sw);
+  if (iter == switches_.end())
+    return;
+  sw.flows().off_batch(iter->second.batches);
+  switches_.erase(iter);
+}
+
+/// Learn the source of the packet and forward or flood it. Frames sent
+/// to the reserved link-local groups, such as STP and LACP, are dropped.
+void
+Learning::packet_in(ff::Switch& sw, const ff::Packet& p) {
+  auto iter = switches_.find(&sw);
+  if (iter == switches_.end() or not p.has(Packet_header::ETHERNET))
+    return;
+  Switch_state& s = iter->second;
+  const Packet_key& k = p.key();
+
+  Time_point t = now();
+  if (not is_multicast(k.dl_src))
+    s.macs.learn(k.dl_src, k.in_port, t);
+  if (t - s.swept >= s.macs.max_age()) {
+    s.macs.sweep(t);
+    s.swept = t;
+  }
+
+  if (is_link_local(k.dl_dst))
+    return;
+
+  Uint16 port;
+  if (is_multicast(k.dl_dst) or not s.macs.find(k.dl_dst, t, port))
+    return packet_out(sw, p, v1_0::Port::FLOOD);
+
+  // The destination is on the port the packet arrived on. Dropping the
+  // packet lets the switch discard its buffer.
+  if (port == k.in_port)
+    return;
+
+  forward(sw, s, p, port);
+}
+
+// Install a rule forwarding the packet's flow to the port. The rule
+// applies to the buffered packet. If the packet was not buffered, it is
+// sent separately.
+void
+Learning::forward(ff::Switch& sw, Switch_state& s, const ff::Packet& p, 
+                  Uint16 port) {
+  Buffer b = flow_.buffer();
+  patch(b, v1_0::flow_mod_match, exact_match(p.key()));
+  patch(b, v1_0::flow_mod_buffer_id, p.buffer_id());
+  patch(b, v1_0::flow_mod_output_port, port);
+  Uint64 seq = sw.flows().push(std::move(b));
+
+  if (sw.hold(p))
+    s.setups.push_back(Setup {seq, p.key()});
+
+  if (p.buffer_id() == Packet::NO_BUFFER)
+    packet_out(sw, p, port);
+}
+
+// Send the packet out of the port, either by its buffer id or by
+// including its data.
+void
+Learning::packet_out(ff::Switch& sw, const ff::Packet& p, Uint16 port) {
+  Buffer b = packet_.buffer();
+  patch(b, v1_0::packet_out_buffer_id, p.buffer_id());
+  patch(b, v1_0::packet_out_in_port, p.key().in_port);
+  patch(b, v1_0::packet_out_output_port, port);
+  if (p.buffer_id() == Packet::NO_BUFFER) {
+    b.insert(b.end(), p.data(), p.data() + p.size());
+    patch(b, ofp::header_length, Uint16(b.size()));
+  }
+  sw.flows().push(std::move(b));
+}
+
+// Release the flows whose rules were sent in or before the acknowledged
+// batch, whose last message has the sequence number last. The channel
+// is shared with other applications, so the batch may hold messages
+// other than ours.
+void
+Learning::acknowledge(ff::Switch& sw, Switch_state& s, Uint64 last) {
+  while (not s.setups.empty() and s.setups.front().seq <= last) {
+    if (not sw.release(s.setups.front().key))
+      break;
+    s.setups.pop_front();
+  }
+}
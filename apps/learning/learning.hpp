@@ -0,0 +1,89 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef APPS_LEARNING_HPP
+#define APPS_LEARNING_HPP
+
+#include <deque>
+#include <unordered_map>
+
+#include <freeflow/sdn/application.hpp>
+#include <freeflow/sdn/controller.hpp>
+#include <freeflow/sdn/switch.hpp>
+#include <freeflow/proto/ofp/template.hpp>
+
+#include "mac_table.hpp"
+
+namespace ff = freeflow;
+
+class Factory;
+class Learning;
+
+/// The Learning application is a reactive L2 learning switch. For each
+/// packet-in, it learns the port of the source address. If the port of
+/// the destination is known, it installs an exact-match rule forwarding
+/// the packet's flow to that port. Otherwise, the packet is flooded.
+///
+/// Rules are sent through the switch's flow channel and carry the buffer
+/// id of the packet, so the buffered packet is forwarded by the new rule
+/// without a separate packet-out. While a rule is in flight, the flow is
+/// held by the switch so that duplicate packet-ins are absorbed; it is
+/// released when the batch containing the rule is acknowledged.
+///
+/// The application also serves as a benchmark of reactive flow setup.
+/// Only OpenFlow 1.0 is supported.
+class Learning : public ff::Application {
+public:
+  Learning(ff::Controller&);
+
+  void bind(ff::Switch&) override;
+  void unbind(ff::Switch&) override;
+  void packet_in(ff::Switch&, const ff::Packet&) override;
+
+private:
+  // A flow whose rule has been sent but not acknowledged. The rule's
+  // sequence number in the flow channel is seq.
+  struct Setup {
+    ff::Uint64     seq;
+    ff::Packet_key key;
+  };
+
+  // The learning state of a switch.
+  struct Switch_state {
+    Switch_state();
+
+    Mac_table                    macs;
+    std::deque<Setup>            setups;  // Unacknowledged setups, oldest first
+    ff::Time_point               swept;   // When the MAC table was last swept
+    ff::Flow_channel::Handler_id batches; // The flow channel's batch handler
+  };
+
+  void forward(ff::Switch&, Switch_state&, const ff::Packet&, ff::Uint16);
+  void packet_out(ff::Switch&, const ff::Packet&, ff::Uint16);
+  void acknowledge(ff::Switch&, Switch_state&, ff::Uint64);
+
+  std::unordered_map<ff::Switch*, Switch_state> switches_;
+
+  ff::ofp::Message_template flow_;   // An exact-match rule with one output
+  ff::ofp::Message_template packet_; // A packet-out with one output
+};
+
+
+/// Create instances of the Learning application.
+class Factory : public ff::Application_factory {
+  ff::Application* create(ff::Controller&);
+  void destroy(ff::Application*);
+};
+
+#endif
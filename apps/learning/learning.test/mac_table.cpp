@@ -0,0 +1,109 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+
+#include <cassert>
+
+#include "../mac_table.hpp"
+
+// Test that the MAC table learns addresses, follows hosts that move
+// between ports, expires idle entries and grows when its buckets fill.
+
+using namespace ff;
+
+// Returns the address 02:00:00:00:hi:lo.
+struct Mac {
+  explicit Mac(Uint16 n) : addr {2, 0, 0, 0, Uint8(n >> 8), Uint8(n)} { }
+
+  Uint8 addr[6];
+};
+
+void test_learning() {
+  Mac_table t(10_s, 16);
+  Time_point t0 = now();
+  Uint16 port;
+
+  assert(not t.find(Mac(1).addr, t0, port));
+  t.learn(Mac(1).addr, 3, t0);
+  t.learn(Mac(2).addr, 4, t0);
+  assert(t.size() == 2);
+  assert(t.find(Mac(1).addr, t0, port) and port == 3);
+  assert(t.find(Mac(2).addr, t0, port) and port == 4);
+
+  // Learning an address again does not add an entry.
+  t.learn(Mac(1).addr, 3, t0);
+  assert(t.size() == 2);
+
+  assert(t.forget(Mac(2).addr));
+  assert(not t.forget(Mac(2).addr));
+  assert(not t.find(Mac(2).addr, t0, port));
+  assert(t.size() == 1);
+}
+
+void test_move() {
+  // A host seen on a new port replaces its old entry.
+  Mac_table t(10_s, 16);
+  Time_point t0 = now();
+  Uint16 port;
+
+  t.learn(Mac(1).addr, 3, t0);
+  t.learn(Mac(1).addr, 7, t0 + 1_s);
+  assert(t.size() == 1);
+  assert(t.find(Mac(1).addr, t0 + 1_s, port) and port == 7);
+}
+
+void test_aging() {
+  Mac_table t(10_s, 16);
+  Time_point t0 = now();
+  Uint16 port;
+
+  t.learn(Mac(1).addr, 1, t0);
+  t.learn(Mac(2).addr, 2, t0 + 5_s);
+
+  // Expired entries are absent before they are swept.
+  assert(not t.find(Mac(1).addr, t0 + 10_s, port));
+  assert(t.find(Mac(2).addr, t0 + 10_s, port) and port == 2);
+  assert(t.size() == 2);
+
+  // Refreshing an entry restarts its age.
+  t.learn(Mac(2).addr, 2, t0 + 10_s);
+  assert(t.sweep(t0 + 16_s) == 1);
+  assert(t.size() == 1);
+  assert(t.find(Mac(2).addr, t0 + 16_s, port));
+}
+
+void test_growth() {
+  Mac_table t(10_s, 8);
+  Time_point t0 = now();
+  Uint16 port;
+
+  std::size_t cap = t.capacity();
+  for (Uint16 i = 0; i < 1000; ++i)
+    t.learn(Mac(i).addr, i, t0);
+  assert(t.size() == 1000);
+  assert(t.capacity() > cap);
+  for (Uint16 i = 0; i < 1000; ++i)
+    assert(t.find(Mac(i).addr, t0, port) and port == i);
+
+  t.clear();
+  assert(t.size() == 0);
+  assert(not t.find(Mac(1).addr, t0, port));
+}
+
+int main() {
+  test_learning();
+  test_move();
+  test_aging();
+  test_growth();
+}
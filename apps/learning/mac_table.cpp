@@ -0,0 +1,219 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cstring>
+
+#include "mac_table.hpp"
+
+using namespace ff;
+
+namespace {
+
+constexpr Uint64 used_bit = Uint64(1) << 63;
+
+// The number of entries moved in an attempt to make room for a new
+// address before the table is grown.
+constexpr int max_kicks = 64;
+
+inline Uint64
+mix(Uint64 k, Uint64 m) {
+  k ^= k >> 31;
+  k *= m;
+  return k ^ (k >> 29);
+}
+
+} // namespace
+
+constexpr std::size_t Mac_table::slots;
+
+/// Construct a table whose entries expire after the given age, with
+/// room for at least n addresses.
+Mac_table::Mac_table(Seconds age, std::size_t n)
+  : mask_(0), size_(0), age_(age) {
+  std::size_t b = 2;
+  while (b * slots < n)
+    b *= 2;
+  buckets_.assign(b, Bucket());
+  mask_ = b - 1;
+}
+
+/// Returns the number of stored entries, including stale ones that have
+/// not yet been reclaimed.
+std::size_t
+Mac_table::size() const { return size_; }
+
+/// Returns the number of slots in the table.
+std::size_t
+Mac_table::capacity() const { return buckets_.size() * slots; }
+
+/// Returns the age after which an entry expires.
+Seconds
+Mac_table::max_age() const { return age_; }
+
+/// Find the port of the address at time t. Returns false if the address
+/// is unknown or its entry has expired.
+bool
+Mac_table::find(const Uint8* mac, Time_point t, Uint16& port) const {
+  Uint64 k = make_key(mac);
+  for (std::size_t b : {first(k), second(k)}) {
+    for (const Entry& e : buckets_[b].entries) {
+      if (e.key == k) {
+        if (stale(e, t))
+          return false;
+        port = e.port;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/// Record that the address was seen on the port at time t.
+void
+Mac_table::learn(const Uint8* mac, Uint16 port, Time_point t) {
+  Uint64 k = make_key(mac);
+  if (Entry* e = lookup(k)) {
+    e->port = port;
+    e->seen = t;
+    return;
+  }
+  insert(Entry {k, t, port}, t);
+}
+
+/// Remove the address. Returns false if it was not in the table.
+bool
+Mac_table::forget(const Uint8* mac) {
+  if (Entry* e = lookup(make_key(mac))) {
+    e->key = 0;
+    --size_;
+    return true;
+  }
+  return false;
+}
+
+/// Remove all entries that have expired by time t. Returns the number
+/// of entries removed.
+std::size_t
+Mac_table::sweep(Time_point t) {
+  std::size_t n = 0;
+  for (Bucket& b : buckets_) {
+    for (Entry& e : b.entries) {
+      if (e.key and stale(e, t)) {
+        e.key = 0;
+        ++n;
+      }
+    }
+  }
+  size_ -= n;
+  return n;
+}
+
+/// Remove all entries.
+void
+Mac_table::clear() {
+  for (Bucket& b : buckets_)
+    b = Bucket();
+  size_ = 0;
+}
+
+// Pack the 48-bit address into an integer, marking it as used.
+Uint64
+Mac_table::make_key(const Uint8* mac) {
+  Uint64 k = 0;
+  for (int i = 0; i < 6; ++i)
+    k = (k << 8) | mac[i];
+  return k | used_bit;
+}
+
+std::size_t
+Mac_table::first(Uint64 k) const { 
+  return mix(k, 0x9e3779b97f4a7c15ull) & mask_; 
+}
+
+std::size_t
+Mac_table::second(Uint64 k) const { 
+  return mix(k, 0xc2b2ae3d27d4eb4full) & mask_; 
+}
+
+// Returns the candidate bucket of k that is not b.
+std::size_t
+Mac_table::other(Uint64 k, std::size_t b) const {
+  std::size_t b1 = first(k);
+  return b == b1 ? second(k) : b1;
+}
+
+bool
+Mac_table::stale(const Entry& e, Time_point t) const {
+  return e.seen + age_ <= t;
+}
+
+Mac_table::Entry*
+Mac_table::lookup(Uint64 k) {
+  for (std::size_t b : {first(k), second(k)})
+    for (Entry& e : buckets_[b].entries)
+      if (e.key == k)
+        return &e;
+  return nullptr;
+}
+
+// Store the entry in a free or expired slot of bucket b.
+bool
+Mac_table::place(std::size_t b, const Entry& e, Time_point t) {
+  for (Entry& s : buckets_[b].entries) {
+    if (not s.key) {
+      s = e;
+      ++size_;
+      return true;
+    }
+    if (stale(s, t)) {
+      s = e;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Insert an entry for a new address. If both of its buckets are full,
+// residents are moved to their alternate buckets to make room. The victim
+// in each bucket is chosen round-robin so that the walk does not cycle
+// between two entries. If the walk ends with an entry still homeless,
+// the table is grown and that entry is inserted again.
+void
+Mac_table::insert(Entry e, Time_point t) {
+  while (true) {
+    if (place(first(e.key), e, t) or place(second(e.key), e, t))
+      return;
+    std::size_t b = first(e.key);
+    for (int i = 0; i < max_kicks; ++i) {
+      std::swap(e, buckets_[b].entries[i % slots]);
+      b = other(e.key, b);
+      if (place(b, e, t))
+        return;
+    }
+    grow(t);
+  }
+}
+
+// Double the number of buckets and reinsert the unexpired entries.
+void
+Mac_table::grow(Time_point t) {
+  std::vector<Bucket> old(buckets_.size() * 2);
+  old.swap(buckets_);
+  mask_ = buckets_.size() - 1;
+  size_ = 0;
+  for (const Bucket& b : old)
+    for (const Entry& e : b.entries)
+      if (e.key and not stale(e, t))
+        insert(e, t);
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef APPS_LEARNING_MAC_TABLE_HPP
+#define APPS_LEARNING_MAC_TABLE_HPP
+
+#include <vector>
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/time.hpp>
+
+namespace ff = freeflow;
+
+/// A Mac_table maps Ethernet addresses to the switch ports on which they
+/// were last seen. Entries that have not been refreshed within the
+/// maximum age are treated as absent and are reclaimed by later
+/// insertions or by an explicit sweep.
+///
+/// The table is a bucketized cuckoo hash. Each address has two candidate
+/// buckets of four slots, so a lookup examines at most eight slots in
+/// two cache lines, regardless of the load. When both buckets of a new
+/// address are full, resident entries are moved to their alternate
+/// buckets to make room. If no room can be made, the table doubles.
+class Mac_table {
+public:
+  static constexpr std::size_t slots = 4;
+
+  explicit Mac_table(ff::Seconds = ff::Seconds(300), std::size_t = 1024);
+
+  // Observers
+  std::size_t size() const;
+  std::size_t capacity() const;
+  ff::Seconds max_age() const;
+
+  // Lookup
+  bool find(const ff::Uint8*, ff::Time_point, ff::Uint16&) const;
+
+  // Mutators
+  void learn(const ff::Uint8*, ff::Uint16, ff::Time_point);
+  bool forget(const ff::Uint8*);
+  std::size_t sweep(ff::Time_point);
+  void clear();
+
+private:
+  struct Entry {
+    ff::Uint64     key;  // The address with the used bit set, or 0
+    ff::Time_point seen; // When the address was last seen
+    ff::Uint16     port;
+  };
+
+  struct Bucket {
+    Entry entries[slots];
+  };
+
+  static ff::Uint64 make_key(const ff::Uint8*);
+  std::size_t first(ff::Uint64) const;
+  std::size_t second(ff::Uint64) const;
+  std::size_t other(ff::Uint64, std::size_t) const;
+  bool stale(const Entry&, ff::Time_point) const;
+
+  Entry* lookup(ff::Uint64);
+  bool place(std::size_t, const Entry&, ff::Time_point);
+  void insert(Entry, ff::Time_point);
+  void grow(ff::Time_point);
+
+  std::vector<Bucket> buckets_;
+  std::size_t         mask_;  // The number of buckets less one
+  std::size_t         size_;  // The number of used slots
+  ff::Seconds         age_;
+};
+
+#endif
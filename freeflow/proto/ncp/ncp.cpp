@@ -0,0 +1,296 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <sstream>
+
+#include "ncp.hpp"
+
+namespace freeflow {
+namespace ncp {
+
+// -------------------------------------------------------------------------- //
+// Framing
+
+/// Read a frame header from the n bytes at p. Returns false if fewer
+/// than header_size bytes are given.
+bool
+load_header(const Byte* p, std::size_t n, Header& h) {
+  if (n < header_size)
+    return false;
+  h.length = get_uint32(p);
+  h.type = Message_type(p[4] << 8 | p[5]);
+  h.format = Format(p[6]);
+  h.flags = p[7];
+  h.id = get_uint32(p + 8);
+  return true;
+}
+
+/// Split the frame at the start of the bytes [p, last) into f. If a
+/// complete frame is found, p is advanced past it. A frame is malformed
+/// if its length is smaller than its header or larger than max, or if
+/// its format is unknown.
+Split
+split_frame(const Byte*& p, const Byte* last, Frame& f, std::size_t max) {
+  std::size_t n = last - p;
+  if (not load_header(p, n, f.header))
+    return Split::PARTIAL;
+  const Header& h = f.header;
+  if (h.length < header_size or h.length > max or h.format > JSON)
+    return Split::MALFORMED;
+  if (h.length > n)
+    return Split::PARTIAL;
+  f.payload = p + header_size;
+  f.size = h.length - header_size;
+  p += h.length;
+  return Split::FRAME;
+}
+
+/// Returns space for reading n bytes. Bytes of frames already returned
+/// are discarded, invalidating those frames.
+Byte*
+Frame_reader::prepare(std::size_t n) {
+  if (first_ != 0) {
+    std::memmove(buf_.data(), buf_.data() + first_, last_ - first_);
+    last_ -= first_;
+    first_ = 0;
+  }
+  if (buf_.size() < last_ + n)
+    buf_.resize(last_ + n);
+  return buf_.data() + last_;
+}
+
+/// Get the next complete frame. Returns false if no complete frame has
+/// been received, or if the received bytes are malformed.
+bool
+Frame_reader::next(Frame& f) {
+  if (bad_)
+    return false;
+  const Byte* p = buf_.data() + first_;
+  switch (split_frame(p, buf_.data() + last_, f, max_)) {
+  case Split::FRAME:
+    first_ = p - buf_.data();
+    return true;
+  case Split::MALFORMED:
+    bad_ = true;
+    return false;
+  default:
+    return false;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+// Frame construction
+
+/// Append the header of a frame to the buffer, returning its offset.
+/// The payload is appended next, and the frame is completed by
+/// end_frame. Frames may be nested in this way.
+std::size_t
+begin_frame(Buffer& b, Message_type t, Format f, Uint32 id) {
+  std::size_t n = b.size();
+  put_uint32(b, 0);
+  b.push_back(Byte(t >> 8));
+  b.push_back(Byte(t));
+  b.push_back(f);
+  b.push_back(0);
+  put_uint32(b, id);
+  return n;
+}
+
+/// Complete the frame that starts at offset n by writing its length.
+void
+end_frame(Buffer& b, std::size_t n) {
+  Uint32 len = Byte_order::msbf(Uint32(b.size() - n));
+  std::memcpy(b.data() + n, &len, sizeof(len));
+}
+
+/// Append a frame with the given payload to the buffer.
+void
+put_frame(Buffer& b, Message_type t, Format f, Uint32 id, 
+          const void* p, std::size_t n) {
+  std::size_t k = begin_frame(b, t, f, id);
+  const Byte* q = static_cast<const Byte*>(p);
+  b.insert(b.end(), q, q + n);
+  end_frame(b, k);
+}
+
+/// Append a frame with a JSON payload to the buffer.
+void
+put_frame(Buffer& b, Message_type t, Uint32 id, const json::Value& v) {
+  std::stringstream ss;
+  ss << v;
+  std::string s = ss.str();
+  put_frame(b, t, JSON, id, s.data(), s.size());
+}
+
+/// Append an error to the buffer, in the given format.
+void
+put_error(Buffer& b, Format f, Uint32 id, Error_code c, 
+          const std::string& msg) {
+  if (f == JSON) {
+    put_frame(b, ERROR, id, {
+      {quote("code"), int(c)},
+      {quote("message"), quote(msg)}
+    });
+  } else {
+    std::size_t k = begin_frame(b, ERROR, BINARY, id);
+    b.push_back(Byte(c >> 8));
+    b.push_back(Byte(c));
+    b.insert(b.end(), msg.begin(), msg.end());
+    end_frame(b, k);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+// JSON payloads
+
+/// Parse the JSON payload of the frame. Returns a null value if the
+/// payload is not well-formed.
+json::Value
+parse_payload(const Frame& f) {
+  try {
+    return json::parse(std::string(f.payload, f.payload + f.size));
+  } catch (...) {
+    return json::Value();
+  }
+}
+
+/// Returns s as a quoted JSON string. Quotes, backslashes and control
+/// characters in s are escaped. JSON strings, including the keys of
+/// objects, keep their quotes in json::Value.
+std::string
+quote(const std::string& s) {
+  static const char hex[] = "0123456789abcdef";
+  std::string r = "\"";
+  for (char c : s) {
+    switch (c) {
+    case '"':  r += "\\\""; break;
+    case '\\': r += "\\\\"; break;
+    case '\b': r += "\\b"; break;
+    case '\f': r += "\\f"; break;
+    case '\n': r += "\\n"; break;
+    case '\r': r += "\\r"; break;
+    case '\t': r += "\\t"; break;
+    default:
+      if (Byte(c) < 0x20) {
+        r += "\\u00";
+        r += hex[Byte(c) >> 4];
+        r += hex[Byte(c) & 0xf];
+      } else {
+        r += c;
+      }
+      break;
+    }
+  }
+  r += '"';
+  return r;
+}
+
+namespace {
+
+// Returns the value of the hex digit c, or -1 if c is not a hex digit.
+int
+hex_value(char c) {
+  if (c >= '0' and c <= '9')
+    return c - '0';
+  if (c >= 'a' and c <= 'f')
+    return c - 'a' + 10;
+  if (c >= 'A' and c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+// Reads the four hex digits at s[i], storing their value in n. Returns
+// false if they are not all hex digits.
+bool
+get_hex4(const std::string& s, std::size_t i, Uint32& n) {
+  n = 0;
+  for (std::size_t j = i; j < i + 4; ++j) {
+    int d = j < s.size() ? hex_value(s[j]) : -1;
+    if (d < 0)
+      return false;
+    n = n << 4 | d;
+  }
+  return true;
+}
+
+// Append the UTF-8 encoding of the code point c.
+void
+put_utf8(std::string& r, Uint32 c) {
+  if (c < 0x80) {
+    r += char(c);
+  } else if (c < 0x800) {
+    r += char(0xc0 | c >> 6);
+    r += char(0x80 | (c & 0x3f));
+  } else if (c < 0x10000) {
+    r += char(0xe0 | c >> 12);
+    r += char(0x80 | (c >> 6 & 0x3f));
+    r += char(0x80 | (c & 0x3f));
+  } else {
+    r += char(0xf0 | c >> 18);
+    r += char(0x80 | (c >> 12 & 0x3f));
+    r += char(0x80 | (c >> 6 & 0x3f));
+    r += char(0x80 | (c & 0x3f));
+  }
+}
+
+} // namespace
+
+/// Returns the contents of a quoted JSON string, replacing its escape
+/// sequences with the characters they denote. Escaped surrogate pairs
+/// are combined into one code point.
+std::string
+unquote(const std::string& s) {
+  if (s.size() < 2 or s.front() != '"' or s.back() != '"')
+    return s;
+  std::string r;
+  std::size_t n = s.size() - 1;
+  for (std::size_t i = 1; i < n; ++i) {
+    if (s[i] != '\\' or i + 1 == n) {
+      r += s[i];
+      continue;
+    }
+    char c = s[++i];
+    switch (c) {
+    case 'b': r += '\b'; break;
+    case 'f': r += '\f'; break;
+    case 'n': r += '\n'; break;
+    case 'r': r += '\r'; break;
+    case 't': r += '\t'; break;
+    case 'u': {
+      Uint32 u;
+      if (i + 4 >= n or not get_hex4(s, i + 1, u)) {
+        r += c;
+        break;
+      }
+      i += 4;
+      Uint32 lo;
+      if (u >= 0xd800 and u < 0xdc00 and i + 6 < n and s[i + 1] == '\\'
+          and s[i + 2] == 'u' and get_hex4(s, i + 3, lo) 
+          and lo >= 0xdc00 and lo < 0xe000) {
+        u = 0x10000 + ((u - 0xd800) << 10) + (lo - 0xdc00);
+        i += 6;
+      }
+      put_utf8(r, u);
+      break;
+    }
+    default: 
+      r += c; 
+      break;
+    }
+  }
+  return r;
+}
+
+} // namespace ncp
+} // namespace freeflow
@@ -0,0 +1,182 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_NCP_HPP
+#define FREEFLOW_NCP_HPP
+
+#include <cassert>
+#include <cstring>
+#include <string>
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/buffer.hpp>
+#include <freeflow/sys/json.hpp>
+
+/// \file ncp.hpp
+/// The northbound control protocol.
+///
+/// NCP carries commands from management clients such as noctl to the
+/// controller over TCP or Unix domain stream sockets. Every message is
+/// a frame: a 12-byte header followed by a payload.
+///
+///   length -- Uint32, the size of the frame, including the header
+///   type   -- Uint16, the request or reply type
+///   format -- Uint8, the encoding of the payload: binary or JSON
+///   flags  -- Uint8, reserved and zero
+///   id     -- Uint32, chosen by the client and echoed in the reply
+///
+/// Header fields are in network byte order. A client may send any
+/// number of requests without waiting for replies. The controller
+/// executes requests in the order received and answers each with a
+/// REPLY or ERROR frame carrying the request's id and format.
+///
+/// Bulk operations use one frame for many items. A FLOWS request
+/// carries any number of encoded OpenFlow flow-mods for one switch, and
+/// a BATCH request carries a sequence of request frames whose replies
+/// are returned together in a single BATCH reply.
+///
+/// The binary payloads of each request and its reply are:
+///
+///   ECHO     -- any bytes; the reply carries the same bytes
+///   BATCH    -- request frames; the reply carries their reply frames
+///   LOAD     -- an application library name; the reply is empty
+///   UNLOAD   -- an application library name; the reply is empty
+///   START    -- an application name; the reply is empty
+///   SWITCHES -- empty; the reply is a Uint32 count and that many
+///               Uint64 datapath ids
+///   FLOWS    -- a Uint64 datapath id followed by OpenFlow messages;
+///               the reply is the Uint32 number of messages queued
+///   ERROR    -- a Uint16 error code followed by a message
+///
+/// JSON payloads are objects with the same content: {"name": ...} for
+/// application commands, {"switches": [...]} for the switch list, and
+/// {"code": ..., "message": ...} for errors. FLOWS requests are binary
+/// only.
+
+namespace freeflow {
+namespace ncp {
+
+/// The types of NCP messages.
+enum Message_type : Uint16 {
+  REPLY    = 0, // The successful result of a request
+  ERROR    = 1, // The failure of a request
+  ECHO     = 2, // Echo the payload
+  BATCH    = 3, // A sequence of requests, or their replies
+  LOAD     = 4, // Load an application library
+  UNLOAD   = 5, // Unload an application library
+  START    = 6, // Start an application
+  SWITCHES = 7, // List the connected switches
+  FLOWS    = 8  // Queue flow modifications on a switch
+};
+
+/// The encoding of a payload.
+enum Format : Uint8 {
+  BINARY = 0,
+  JSON   = 1
+};
+
+/// The error codes carried by ERROR messages.
+enum Error_code : Uint16 {
+  BAD_FRAME   = 1, // The frame header is malformed
+  BAD_TYPE    = 2, // The message type is not a request
+  BAD_FORMAT  = 3, // The request is not supported in its format
+  BAD_PAYLOAD = 4, // The payload is malformed
+  NO_SWITCH   = 5, // No switch has the given datapath id
+  FAILED      = 6  // The command failed
+};
+
+/// The header of an NCP frame.
+struct Header {
+  Uint32       length;
+  Message_type type;
+  Format       format;
+  Uint8        flags;
+  Uint32       id;
+};
+
+/// The size of a frame header.
+constexpr std::size_t header_size = 12;
+
+/// The default bound on the size of a frame.
+constexpr std::size_t max_frame = 1 << 26;
+
+/// A Frame is a received message. The payload refers to the bytes of
+/// the message where they were received.
+struct Frame {
+  Header      header;
+  const Byte* payload;
+  std::size_t size;
+};
+
+/// The result of splitting a frame from a sequence of bytes.
+enum class Split {
+  FRAME,     // A complete frame was split
+  PARTIAL,   // The bytes hold only part of a frame
+  MALFORMED  // The frame header is invalid
+};
+
+// Framing
+bool load_header(const Byte*, std::size_t, Header&);
+Split split_frame(const Byte*&, const Byte*, Frame&, std::size_t = max_frame);
+
+/// A Frame_reader accumulates the bytes received on a connection and
+/// splits them into frames. Bytes are read directly into the reader's
+/// storage, and frames refer to that storage, so no message is copied.
+/// A frame remains valid until the next call to prepare.
+class Frame_reader {
+public:
+  explicit Frame_reader(std::size_t = max_frame);
+
+  // Reading
+  Byte* prepare(std::size_t);
+  void commit(std::size_t);
+  bool next(Frame&);
+
+  // Observers
+  bool bad() const;
+  std::size_t buffered() const;
+
+private:
+  Buffer      buf_;
+  std::size_t first_; // The start of unread bytes
+  std::size_t last_;  // The end of received bytes
+  std::size_t max_;   // The largest accepted frame
+  bool        bad_;   // True if a malformed header was received
+};
+
+// Frame construction
+std::size_t begin_frame(Buffer&, Message_type, Format, Uint32);
+void end_frame(Buffer&, std::size_t);
+void put_frame(Buffer&, Message_type, Format, Uint32, 
+               const void* = nullptr, std::size_t = 0);
+void put_frame(Buffer&, Message_type, Uint32, const json::Value&);
+void put_error(Buffer&, Format, Uint32, Error_code, const std::string&);
+
+// Binary payloads
+void put_uint32(Buffer&, Uint32);
+void put_uint64(Buffer&, Uint64);
+Uint32 get_uint32(const Byte*);
+Uint64 get_uint64(const Byte*);
+
+// JSON payloads
+json::Value parse_payload(const Frame&);
+std::string quote(const std::string&);
+std::string unquote(const std::string&);
+
+} // namespace ncp
+} // namespace freeflow
+
+#include <freeflow/proto/ncp/ncp.ipp>
+
+#endif
@@ -0,0 +1,71 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+namespace ncp {
+
+inline
+Frame_reader::Frame_reader(std::size_t m)
+  : first_(0), last_(0), max_(m), bad_(false) { }
+
+/// Record that n bytes were read into the space returned by prepare.
+inline void
+Frame_reader::commit(std::size_t n) {
+  assert(last_ + n <= buf_.size());
+  last_ += n;
+}
+
+/// Returns true if a malformed frame was received. No further frames
+/// are returned after a malformed frame.
+inline bool
+Frame_reader::bad() const { return bad_; }
+
+/// Returns the number of received bytes not yet returned as frames.
+inline std::size_t
+Frame_reader::buffered() const { return last_ - first_; }
+
+/// Append n to the buffer in network byte order.
+inline void
+put_uint32(Buffer& b, Uint32 n) {
+  n = Byte_order::msbf(n);
+  const Byte* p = reinterpret_cast<const Byte*>(&n);
+  b.insert(b.end(), p, p + sizeof(n));
+}
+
+/// Append n to the buffer in network byte order.
+inline void
+put_uint64(Buffer& b, Uint64 n) {
+  n = Byte_order::msbf(n);
+  const Byte* p = reinterpret_cast<const Byte*>(&n);
+  b.insert(b.end(), p, p + sizeof(n));
+}
+
+/// Read a Uint32 in network byte order from p.
+inline Uint32
+get_uint32(const Byte* p) {
+  Uint32 n;
+  std::memcpy(&n, p, sizeof(n));
+  return Byte_order::msbf(n);
+}
+
+/// Read a Uint64 in network byte order from p.
+inline Uint64
+get_uint64(const Byte* p) {
+  Uint64 n;
+  std::memcpy(&n, p, sizeof(n));
+  return Byte_order::msbf(n);
+}
+
+} // namespace ncp
+} // namespace freeflow
@@ -0,0 +1,154 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <vector>
+
+#include <freeflow/proto/ncp/ncp.hpp>
+
+// Test that frames are built and split correctly, that pipelined
+// frames received in arbitrary pieces are recovered in order, that
+// batches nest frames, and that malformed frames are detected.
+
+using namespace freeflow;
+using namespace freeflow::ncp;
+
+// Feed the bytes of b to the reader n at a time, returning the ids of
+// the frames received.
+std::vector<Uint32>
+feed(Frame_reader& r, const Buffer& b, std::size_t n) {
+  std::vector<Uint32> ids;
+  for (std::size_t i = 0; i < b.size(); i += n) {
+    std::size_t k = std::min(n, b.size() - i);
+    std::copy(b.begin() + i, b.begin() + i + k, r.prepare(k));
+    r.commit(k);
+    Frame f;
+    while (r.next(f))
+      ids.push_back(f.header.id);
+  }
+  return ids;
+}
+
+int main() {
+  // A frame round-trips through its header.
+  Buffer b;
+  put_frame(b, ECHO, BINARY, 7, "hello", 5);
+  assert(b.size() == header_size + 5);
+  const Byte* p = b.data();
+  Frame f;
+  assert(split_frame(p, b.data() + b.size(), f) == Split::FRAME);
+  assert(p == b.data() + b.size());
+  assert(f.header.type == ECHO);
+  assert(f.header.format == BINARY);
+  assert(f.header.id == 7);
+  assert(std::string(f.payload, f.payload + f.size) == "hello");
+
+  // Incomplete frames are not split.
+  p = b.data();
+  assert(split_frame(p, b.data() + 4, f) == Split::PARTIAL);
+  assert(split_frame(p, b.data() + b.size() - 1, f) == Split::PARTIAL);
+  assert(p == b.data());
+
+  // Pipelined frames are recovered in order, however they arrive.
+  Buffer pipe;
+  for (Uint32 i = 0; i < 100; ++i)
+    put_frame(pipe, ECHO, BINARY, i, pipe.data(), i % 17);
+  for (std::size_t n : {1, 5, 12, 13, 1000, 100000}) {
+    Frame_reader r;
+    std::vector<Uint32> ids = feed(r, pipe, n);
+    assert(ids.size() == 100);
+    for (Uint32 i = 0; i < 100; ++i)
+      assert(ids[i] == i);
+    assert(r.buffered() == 0);
+  }
+
+  // A batch carries nested frames, and its length covers them.
+  Buffer batch;
+  std::size_t k = begin_frame(batch, BATCH, BINARY, 1);
+  put_frame(batch, SWITCHES, BINARY, 2);
+  std::size_t j = begin_frame(batch, FLOWS, BINARY, 3);
+  put_uint64(batch, 0x0102030405060708);
+  end_frame(batch, j);
+  end_frame(batch, k);
+  p = batch.data();
+  assert(split_frame(p, batch.data() + batch.size(), f) == Split::FRAME);
+  assert(f.header.type == BATCH);
+  const Byte* q = f.payload;
+  const Byte* last = f.payload + f.size;
+  Frame g;
+  assert(split_frame(q, last, g) == Split::FRAME);
+  assert(g.header.type == SWITCHES and g.header.id == 2 and g.size == 0);
+  assert(split_frame(q, last, g) == Split::FRAME);
+  assert(g.header.type == FLOWS and g.header.id == 3);
+  assert(get_uint64(g.payload) == 0x0102030405060708);
+  assert(q == last);
+
+  // Frames too short or too long, and unknown formats, are malformed.
+  Buffer bad;
+  put_frame(bad, ECHO, BINARY, 1);
+  bad[3] = 4;
+  p = bad.data();
+  assert(split_frame(p, bad.data() + bad.size(), f) == Split::MALFORMED);
+  Buffer big;
+  put_frame(big, ECHO, BINARY, 1, pipe.data(), 100);
+  p = big.data();
+  assert(split_frame(p, big.data() + big.size(), f, 64) == Split::MALFORMED);
+  Buffer fmt;
+  put_frame(fmt, ECHO, Format(9), 1);
+  Frame_reader r;
+  assert(feed(r, fmt, 100).empty());
+  assert(r.bad());
+
+  // JSON payloads are parsed, and errors are encoded in either format.
+  Buffer js;
+  put_frame(js, START, 4, {{quote("name"), quote("a \"b\"")}});
+  p = js.data();
+  assert(split_frame(p, js.data() + js.size(), f) == Split::FRAME);
+  assert(f.header.format == JSON);
+  json::Value v = parse_payload(f);
+  assert(v.type() == json::Value::OBJECT);
+  const json::Object& o = v.as_object();
+  auto iter = o.find(quote("name"));
+  assert(iter != o.end());
+  assert(unquote(iter->second.as_string()) == "a \"b\"");
+
+  // Control characters are escaped, so they survive a JSON payload.
+  const std::string ctl("x\ny\r\t\0\x01z", 8);
+  std::string qc = quote(ctl);
+  assert(qc == "\"x\\ny\\r\\t\\u0000\\u0001z\"");
+  js.clear();
+  put_frame(js, START, 6, {{quote("name"), qc}});
+  p = js.data();
+  assert(split_frame(p, js.data() + js.size(), f) == Split::FRAME);
+  v = parse_payload(f);
+  assert(v.type() == json::Value::OBJECT);
+  iter = v.as_object().find(quote("name"));
+  assert(iter != v.as_object().end());
+  assert(unquote(iter->second.as_string()) == ctl);
+  assert(unquote("\"\\u00e9\\ud83d\\ude00\"") == "\xc3\xa9\xf0\x9f\x98\x80");
+
+  Buffer err;
+  put_error(err, BINARY, 5, NO_SWITCH, "none");
+  p = err.data();
+  assert(split_frame(p, err.data() + err.size(), f) == Split::FRAME);
+  assert(f.header.type == ERROR and f.header.id == 5);
+  assert(f.size == 6 and f.payload[1] == NO_SWITCH);
+  err.clear();
+  put_error(err, JSON, 5, NO_SWITCH, "none");
+  p = err.data();
+  assert(split_frame(p, err.data() + err.size(), f) == Split::FRAME);
+  assert(parse_payload(f).type() == json::Value::OBJECT);
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+#include <cassert>
+
+#include "keepalive.hpp"
+
+namespace freeflow {
+namespace ofp {
+
+/// Track the session, whose last traffic was received at time t.
+/// Returns the id of the session. If the table was empty, the session
+/// becomes the host of the sweep timer.
+Keepalive::Id
+Keepalive::insert(Protocol* p, Time_point t) {
+  assert(p);
+  Id id;
+  if (free_.empty()) {
+    id = entries_.size();
+    entries_.push_back({t, t, p});
+  } else {
+    id = free_.back();
+    free_.pop_back();
+    entries_[id] = {t, t, p};
+  }
+  if (size_++ == 0)
+    host_ = id;
+  return id;
+}
+
+/// Stop tracking the session with the given id. Returns true if the
+/// session hosted the sweep timer and another session has become its
+/// host. The new host is given by host().
+bool
+Keepalive::erase(Id id) {
+  assert(entries_[id].session);
+  entries_[id].session = nullptr;
+  free_.push_back(id);
+  --size_;
+  if (id != host_ or size_ == 0)
+    return false;
+
+  auto i = std::find_if(entries_.begin(), entries_.end(), [](const Entry& e) {
+    return e.session != nullptr;
+  });
+  host_ = i - entries_.begin();
+  return true;
+}
+
+/// Determine which sessions have been idle as of time t. The ids of
+/// sessions that have not received traffic within the dead duration are
+/// appended to dead. The ids of sessions that have not received traffic,
+/// and have not been probed, within the idle duration are appended to
+/// probe, and are marked as probed at time t.
+void
+Keepalive::sweep(Time_point t, std::vector<Id>& probe, std::vector<Id>& dead) {
+  for (Id id = 0; id < entries_.size(); ++id) {
+    Entry& e = entries_[id];
+    if (not e.session)
+      continue;
+    if (t - e.seen >= dead_) {
+      dead.push_back(id);
+    } else if (t - std::max(e.seen, e.probed) >= idle_) {
+      probe.push_back(id);
+      e.probed = t;
+    }
+  }
+}
+
+} // namespace ofp
+} // namespace freeflow
@@ -0,0 +1,89 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_OFP_KEEPALIVE_HPP
+#define FREEFLOW_OFP_KEEPALIVE_HPP
+
+#include <vector>
+
+#include <freeflow/sys/time.hpp>
+
+/// \file keepalive.hpp
+/// Controller-wide liveness tracking of switch connections.
+///
+/// Rather than maintaining a ping timer and a timeout timer for each
+/// connection, every established session records the time at which it
+/// last received traffic in a shared Keepalive table. A single periodic
+/// sweep over the table determines which sessions have been idle long
+/// enough to be probed with an echo request, and which have been silent
+/// long enough to be considered dead. Receiving a message is a single
+/// store into the table.
+
+namespace freeflow {
+namespace ofp {
+
+class Protocol;
+
+/// The Keepalive table records the last time that traffic was received
+/// on each established session. Sessions are identified by the index
+/// returned when they are inserted. Indexes of erased sessions are
+/// reused.
+///
+/// One session hosts the periodic sweep timer. When the host is erased,
+/// another session must take over the timer.
+class Keepalive {
+public:
+  using Id = std::size_t;
+
+  /// An entry in the table. The entry is free when session is null.
+  struct Entry {
+    Time_point seen;    // Last time traffic was received
+    Time_point probed;  // Last time an echo request was sent
+    Protocol*  session;
+  };
+
+  Keepalive(Microseconds, Microseconds, Microseconds);
+
+  // Observers
+  bool empty() const;
+  std::size_t size() const;
+  Microseconds interval() const;
+  Protocol* session(Id) const;
+  Protocol* host() const;
+
+  // Mutators
+  Id insert(Protocol*, Time_point);
+  bool erase(Id);
+  void touch(Id, Time_point);
+
+  // Sweeping
+  void sweep(Time_point, std::vector<Id>&, std::vector<Id>&);
+
+private:
+  std::vector<Entry> entries_;
+  std::vector<Id>    free_;
+  std::size_t        size_;
+  Id                 host_;
+
+  Microseconds idle_;     // Idle time before probing
+  Microseconds dead_;     // Idle time before closing
+  Microseconds interval_; // Time between sweeps
+};
+
+} // namespace ofp
+} // namespace freeflow
+
+#include <freeflow/proto/ofp/keepalive.ipp>
+
+#endif
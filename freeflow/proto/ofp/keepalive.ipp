@@ -0,0 +1,54 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+namespace ofp {
+
+/// Initialize the table. Sessions idle for the idle duration are
+/// probed, and sessions idle for the dead duration are closed. The
+/// table is swept once per interval, so the interval bounds the error
+/// of both durations.
+inline
+Keepalive::Keepalive(Microseconds idle, Microseconds dead, Microseconds i)
+  : size_(0), host_(0), idle_(idle), dead_(dead), interval_(i)
+{ }
+
+/// Returns true when no sessions are tracked.
+inline bool
+Keepalive::empty() const { return size_ == 0; }
+
+/// Returns the number of tracked sessions.
+inline std::size_t
+Keepalive::size() const { return size_; }
+
+/// Returns the time between sweeps of the table.
+inline Microseconds
+Keepalive::interval() const { return interval_; }
+
+/// Returns the session with the given id.
+inline Protocol*
+Keepalive::session(Id id) const { return entries_[id].session; }
+
+/// Returns the session hosting the sweep timer, or nullptr if there
+/// are no sessions.
+inline Protocol*
+Keepalive::host() const { return empty() ? nullptr : entries_[host_].session; }
+
+/// Record that traffic was received on the session at time t. This is
+/// called for every received message, so it does nothing else.
+inline void
+Keepalive::touch(Id id, Time_point t) { entries_[id].seen = t; }
+
+} // namespace ofp
+} // namespace freeflow
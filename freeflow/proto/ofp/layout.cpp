@@ -12,4 +12,4 @@
 // or implied. See the License for the specific language governing
 // permissions and limitations under the License.
 
-#include "queue.hpp"
+#include "layout.hpp"
@@ -0,0 +1,226 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_OFP_LAYOUT_HPP
+#define FREEFLOW_OFP_LAYOUT_HPP
+
+#include <cstring>
+#include <utility>
+
+#include <freeflow/sys/meta.hpp>
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/buffer.hpp>
+#include <freeflow/proto/ofp/ofp.hpp>
+
+/// \file layout.hpp
+/// Compile-time descriptions of fixed-size wire formats.
+///
+/// A layout is a list of fields and padding that describes how a
+/// structure is laid out on the wire. The size of a layout and the offset
+/// of each field are constant expressions, so encoding or decoding a
+/// structure with a layout requires a single bounds check followed by
+/// a sequence of loads, byte swaps and stores at fixed offsets.
+///
+/// A structure is given a layout by declaring (but not defining) a
+/// function named wire_layout in the structure's namespace:
+///
+///   using Match_layout = Layout<
+///     Field<Match, Match::Wildcards, &Match::wildcards>,
+///     Field<Match, Uint16, &Match::in_port>,
+///     Pad<2>,
+///     ...
+///   >;
+///
+///   Match_layout wire_layout(const Match&);
+///
+/// After which Wire<Match> describes the encoding, and the structure can
+/// be nested as a field of other layouts.
+
+namespace freeflow {
+namespace ofp {
+
+// -------------------------------------------------------------------------- //
+// Wire types
+
+/// The Wire class describes the encoding of a fixed-size type. Every
+/// specialization provides the following:
+///
+///   size         -- the number of bytes in the encoding
+///   load(p, x)   -- read x from the bytes starting at p
+///   store(p, x)  -- write x to the bytes starting at p
+///
+/// Neither load nor store check bounds. That is the responsibility of
+/// the caller.
+///
+/// Unless otherwise specialized, the encoding of T is given by the
+/// layout returned by wire_layout(T), found by argument dependent lookup.
+template<typename T, typename = void>
+  struct Wire : decltype(wire_layout(std::declval<const T&>())) { };
+
+/// The encoding of integral values in network byte order.
+template<typename T>
+  struct Wire_integer {
+    static constexpr std::size_t size = sizeof(T);
+
+    static void load(const Byte*, T&);
+    static void store(Byte*, T);
+  };
+
+template<> struct Wire<Uint8> : Wire_integer<Uint8> { };
+template<> struct Wire<Uint16> : Wire_integer<Uint16> { };
+template<> struct Wire<Uint32> : Wire_integer<Uint32> { };
+template<> struct Wire<Uint64> : Wire_integer<Uint64> { };
+
+/// Enumerations are encoded as their underlying type.
+template<typename T>
+  struct Wire<T, Requires<Enum<T>()>> {
+    using U = Underlying_type<T>;
+
+    static constexpr std::size_t size = sizeof(U);
+
+    static void load(const Byte*, T&);
+    static void store(Byte*, T);
+  };
+
+/// The encoding of an uninterpreted sequence of N bytes. Strings and
+/// addresses are encoded this way.
+template<std::size_t N>
+  struct Wire_bytes {
+    static constexpr std::size_t size = N;
+
+    template<typename T>
+      static void load(const Byte*, T&);
+
+    template<typename T>
+      static void store(Byte*, const T&);
+  };
+
+template<std::size_t N>
+  struct Wire<String<N>> : Wire_bytes<N> { };
+
+template<> struct Wire<Mac_addr> : Wire_bytes<6> { };
+template<> struct Wire<Ipv4_addr> : Wire_bytes<4> { };
+template<> struct Wire<Ipv6_addr> : Wire_bytes<16> { };
+
+// -------------------------------------------------------------------------- //
+// Layouts
+
+/// A Field describes the encoding of the member M of the class C. The
+/// member is encoded using Wire<T>.
+template<typename C, typename T, T C::* M>
+  struct Field {
+    static constexpr std::size_t size = Wire<T>::size;
+
+    static void load(const Byte*, C&);
+    static void store(Byte*, const C&);
+  };
+
+/// A Pad describes N bytes of padding. Padding is ignored when loading
+/// and zero-filled when storing.
+template<std::size_t N>
+  struct Pad {
+    static constexpr std::size_t size = N;
+
+    template<typename C>
+      static void load(const Byte*, C&);
+
+    template<typename C>
+      static void store(Byte*, const C&);
+  };
+
+/// A Layout is a sequence of fields and padding. The fields are encoded
+/// in order, with no additional padding between them.
+template<typename... Fs>
+  struct Layout;
+
+template<>
+  struct Layout<> {
+    static constexpr std::size_t size = 0;
+
+    template<typename C>
+      static void load(const Byte*, C&) { }
+
+    template<typename C>
+      static void store(Byte*, const C&) { }
+  };
+
+template<typename F, typename... Fs>
+  struct Layout<F, Fs...> {
+    static constexpr std::size_t size = F::size + Layout<Fs...>::size;
+
+    template<typename C>
+      static void load(const Byte*, C&);
+
+    template<typename C>
+      static void store(Byte*, const C&);
+  };
+
+/// The Layout_offset trait gives the offset of the Ith element of the
+/// layout L. For example, Layout_offset<Match_layout, 2>::value is the
+/// offset of the third field or padding in a Match.
+template<typename L, std::size_t I>
+  struct Layout_offset;
+
+template<typename F, typename... Fs>
+  struct Layout_offset<Layout<F, Fs...>, 0>
+    : std::integral_constant<std::size_t, 0> { };
+
+template<typename F, typename... Fs, std::size_t I>
+  struct Layout_offset<Layout<F, Fs...>, I>
+    : std::integral_constant<
+        std::size_t, F::size + Layout_offset<Layout<Fs...>, I - 1>::value
+      > { };
+
+// -------------------------------------------------------------------------- //
+// Common layouts
+
+/// The wire layout of the OpenFlow header.
+using Header_layout = Layout<
+  Field<Header, Uint8, &Header::version>,
+  Field<Header, Uint8, &Header::type>,
+  Field<Header, Uint16, &Header::length>,
+  Field<Header, Uint32, &Header::xid>
+>;
+
+Header_layout wire_layout(const Header&);
+
+// -------------------------------------------------------------------------- //
+// Decoding hints
+
+template<typename T>
+  constexpr std::size_t min_bytes(const Sequence<T>&);
+
+// -------------------------------------------------------------------------- //
+// Encoding
+
+// Layout encoding
+template<typename L, typename T>
+  bool store_layout(View&, const T&);
+
+template<typename L, typename T>
+  bool load_layout(View&, T&);
+
+// Wire encoding
+template<typename T>
+  bool store(View&, const T&);
+
+template<typename T>
+  bool load(View&, T&);
+
+} // namespace ofp
+} // namespace freeflow
+
+#include <freeflow/proto/ofp/layout.ipp>
+
+#endif
@@ -0,0 +1,175 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+namespace ofp {
+
+// -------------------------------------------------------------------------- //
+// Wire types
+
+template<typename T>
+  constexpr std::size_t Wire_integer<T>::size;
+
+// Note that the copies are used to avoid unaligned accesses. Compilers
+// reduce them to a single (possibly swapping) load or store.
+template<typename T>
+  inline void
+  Wire_integer<T>::load(const Byte* p, T& x) {
+    T n;
+    std::memcpy(&n, p, sizeof(T));
+    x = Byte_order::msbf(n);
+  }
+
+template<typename T>
+  inline void
+  Wire_integer<T>::store(Byte* p, T x) {
+    T n = Byte_order::msbf(x);
+    std::memcpy(p, &n, sizeof(T));
+  }
+
+template<typename T>
+  constexpr std::size_t Wire<T, Requires<Enum<T>()>>::size;
+
+template<typename T>
+  inline void
+  Wire<T, Requires<Enum<T>()>>::load(const Byte* p, T& x) {
+    U n;
+    Wire<U>::load(p, n);
+    x = static_cast<T>(n);
+  }
+
+template<typename T>
+  inline void
+  Wire<T, Requires<Enum<T>()>>::store(Byte* p, T x) {
+    Wire<U>::store(p, static_cast<U>(x));
+  }
+
+template<std::size_t N>
+  constexpr std::size_t Wire_bytes<N>::size;
+
+template<std::size_t N>
+  template<typename T>
+    inline void
+    Wire_bytes<N>::load(const Byte* p, T& x) {
+      static_assert(sizeof(T) == N, "incompatible byte encoding");
+      std::memcpy(&x, p, N);
+    }
+
+template<std::size_t N>
+  template<typename T>
+    inline void
+    Wire_bytes<N>::store(Byte* p, const T& x) {
+      static_assert(sizeof(T) == N, "incompatible byte encoding");
+      std::memcpy(p, &x, N);
+    }
+
+// -------------------------------------------------------------------------- //
+// Layouts
+
+template<typename C, typename T, T C::* M>
+  constexpr std::size_t Field<C, T, M>::size;
+
+template<typename C, typename T, T C::* M>
+  inline void
+  Field<C, T, M>::load(const Byte* p, C& x) { Wire<T>::load(p, x.*M); }
+
+template<typename C, typename T, T C::* M>
+  inline void
+  Field<C, T, M>::store(Byte* p, const C& x) { Wire<T>::store(p, x.*M); }
+
+template<std::size_t N>
+  constexpr std::size_t Pad<N>::size;
+
+template<std::size_t N>
+  template<typename C>
+    inline void
+    Pad<N>::load(const Byte*, C&) { }
+
+template<std::size_t N>
+  template<typename C>
+    inline void
+    Pad<N>::store(Byte* p, const C&) { std::memset(p, 0, N); }
+
+template<typename F, typename... Fs>
+  constexpr std::size_t Layout<F, Fs...>::size;
+
+template<typename F, typename... Fs>
+  template<typename C>
+    inline void
+    Layout<F, Fs...>::load(const Byte* p, C& x) {
+      F::load(p, x);
+      Layout<Fs...>::load(p + F::size, x);
+    }
+
+template<typename F, typename... Fs>
+  template<typename C>
+    inline void
+    Layout<F, Fs...>::store(Byte* p, const C& x) {
+      F::store(p, x);
+      Layout<Fs...>::store(p + F::size, x);
+    }
+
+// -------------------------------------------------------------------------- //
+// Decoding hints
+
+/// Returns the minimum number of bytes in the encoding of an element of
+/// the sequence. This is used to bound the number of elements that can
+/// be decoded from a view. By default, elements have a fixed-size wire
+/// encoding. Sequences of variable-length elements must overload this
+/// function in the namespace of the element type.
+template<typename T>
+  constexpr std::size_t
+  min_bytes(const Sequence<T>&) { return Wire<T>::size; }
+
+// -------------------------------------------------------------------------- //
+// Encoding
+
+/// Writes x into the view using the layout L and advances the view.
+/// Returns false, leaving the view unchanged, if fewer than L::size bytes
+/// remain in the view.
+template<typename L, typename T>
+  inline bool
+  store_layout(View& v, const T& x) {
+    if (not v.available(L::size))
+      return false;
+    L::store(v.first, x);
+    v.advance(L::size);
+    return true;
+  }
+
+/// Reads x from the view using the layout L and advances the view.
+/// Returns false, leaving the view unchanged, if fewer than L::size bytes
+/// remain in the view.
+template<typename L, typename T>
+  inline bool
+  load_layout(View& v, T& x) {
+    if (not v.available(L::size))
+      return false;
+    L::load(v.first, x);
+    v.advance(L::size);
+    return true;
+  }
+
+/// Writes x into the view using its wire encoding.
+template<typename T>
+  inline bool
+  store(View& v, const T& x) { return store_layout<Wire<T>>(v, x); }
+
+/// Reads x from the view using its wire encoding.
+template<typename T>
+  inline bool
+  load(View& v, T& x) { return load_layout<Wire<T>>(v, x); }
+
+} // namespace ofp
+} // namespace freeflow
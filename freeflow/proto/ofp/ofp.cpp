@@ -15,34 +15,26 @@
 #include <iostream>
 
 #include "ofp.hpp"
+#include "layout.hpp"
 
 namespace freeflow {
 namespace ofp {
 
 Error 
 to_view(View& v, const Header& h) {
-  if (v.remaining() < bytes(h))
-    return make_error_code(errc::header_overflow);
-
   // Minimum semantic checking
-  if (h.length < bytes(h));
+  if (h.length < bytes(h))
     return make_error_code(errc::bad_header_length);
 
-  to_view(v, h.version);
-  to_view(v, h.type);
-  to_view(v, h.length);
-  to_view(v, h.xid);
+  if (not store(v, h))
+    return make_error_code(errc::header_overflow);
+  return {};
 }
 
 Error 
 from_view(View& v, Header& h) {
-  if (v.remaining() < bytes(h))
+  if (not load(v, h))
     return make_error_code(errc::header_overflow);
-  
-  from_view(v, h.version);
-  from_view(v, h.type);
-  from_view(v, h.length);
-  from_view(v, h.xid);
 
   // Minimum semantic checking
   if (h.length < bytes(h))
@@ -22,6 +22,7 @@
 #include <freeflow/sys/data.hpp>
 #include <freeflow/sys/error.hpp>
 #include <freeflow/sys/buffer.hpp>
+#include <freeflow/sys/arena.hpp>
 #include <freeflow/proto/ofp/error.hpp>
 
 namespace freeflow {
@@ -66,10 +67,12 @@ template<std::size_t N>
 
 
 /// The Sequence class represents a repeated collection of objects of
-/// a particular type.
+/// a particular type. Sequences allocate from the memory resource that
+/// is current when they are constructed, so that messages decoded in a
+/// Resource_scope allocate their storage from its arena.
 template<typename T>
-  struct Sequence : public std::vector<T> {
-    using std::vector<T>::vector;
+  struct Sequence : public std::vector<T, Resource_allocator<T>> {
+    using std::vector<T, Resource_allocator<T>>::vector;
   };
 
 
@@ -117,7 +117,7 @@ bytes(const Empty&) { return 0; }
 
 /// Returns the number of bytes required by the integral type. This
 /// is the same as its size.
-template<typename T, typename = Requires<Integral<T>()>>
+template<typename T, typename X>
   constexpr std::size_t 
   bytes(T) { return sizeof(T); }
 
@@ -297,15 +297,22 @@ template<std::size_t N>
 ///
 /// Note that elements for which bytes() is not a constant expression
 /// have indeterminate size until they are read. Because of this, the
-/// algorithm must check each construction.
+/// algorithm must check each construction. Capacity is reserved up front
+/// for the largest number of elements that could fit in the view, as
+/// given by min_bytes(), so the sequence is allocated once. Elements are
+/// decoded in place. If any element cannot be read, the elements read by
+/// this call are removed, leaving the sequence as it was.
 template<typename T>
   Error
   from_view(View& v, Sequence<T>& s) {
+    std::size_t n = s.size();
+    s.reserve(n + v.remaining() / min_bytes(s));
     while (v.remaining()) {
-      T t;
-      if (Trap err = from_view(v, t))
+      s.emplace_back();
+      if (Trap err = from_view(v, s.back())) {
+        s.erase(s.begin() + n, s.end());
         return static_cast<Error>(err.error());
-      s.push_back(std::move(t));
+      }
     }
     return {};
   }
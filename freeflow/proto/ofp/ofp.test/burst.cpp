@@ -0,0 +1,99 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/proto/ofp/v1.0/burst.hpp>
+
+// Test that a burst decodes every complete message in a buffer and
+// allocates their sequences from its arena.
+
+using namespace freeflow;
+using namespace freeflow::ofp::v1_0;
+
+// Append the encoded message to the buffer.
+template<typename T>
+  void
+  append(Buffer& b, Message_type t, Uint32 xid, const T& m) {
+    Header h(t, 8 + bytes(m), xid);
+    std::size_t n = b.size();
+    b.resize(n + h.length);
+    View v(b, b.data() + n, b.data() + b.size());
+    assert(to_view(v, h));
+    assert(to_view(v, m));
+    assert(v.remaining() == 0);
+  }
+
+int main() {
+  Flow_mod fm = Flow_mod();
+  fm.match.wildcards = Match::ALL;
+  fm.command = Flow_mod::ADD;
+  fm.buffer_id = 0xffffffff;
+  fm.out_port = Port::NONE;
+  for (Uint16 i = 1; i <= 4; ++i) {
+    Action a;
+    a.header.type = ACTION_OUTPUT;
+    a.header.length = 8;
+    a.payload.output.port = Port::Id(i);
+    a.payload.output.max_len = 0;
+    fm.actions.push_back(a);
+  }
+
+  Echo_request echo;
+  echo.data.assign(16, 0xab);
+
+  Buffer b;
+  append(b, FLOW_MOD, 1, fm);
+  append(b, ECHO_REQUEST, 2, echo);
+  append(b, FLOW_MOD, 3, fm);
+
+  // A trailing partial message remains in the view.
+  std::size_t n = b.size();
+  append(b, ECHO_REQUEST, 4, echo);
+  b.resize(n + 10);
+
+  View v(b);
+  Burst burst;
+  assert(burst.decode(v));
+  assert(burst.size() == 3);
+  assert(v.remaining() == 10);
+
+  assert(burst[0].header.xid == 1);
+  assert(burst[1].header.xid == 2);
+  assert(burst[2].header.xid == 3);
+  assert(burst[1].payload.echo_req.data.size() == 16);
+  for (Message& m : burst) {
+    if (m.header.type != FLOW_MOD)
+      continue;
+    const Action_list& as = m.payload.flow_mod.actions;
+    assert(as.size() == 4);
+    assert(as[3].payload.output.port == 4);
+    assert(as.get_allocator().resource() == &burst.arena());
+  }
+  assert(burst.arena().allocated() > 0);
+
+  // A malformed message stops decoding and is left in the view.
+  Buffer bad;
+  append(bad, ECHO_REQUEST, 5, echo);
+  append(bad, ECHO_REQUEST, 6, echo);
+  bad[echo.data.size() + 8 + 1] = 0xff; // Invalid message type
+  View w(bad);
+  assert(not burst.decode(w));
+  assert(burst.size() == 1);
+  assert(w.remaining() == echo.data.size() + 8);
+
+  burst.release();
+  assert(burst.empty());
+  assert(burst.arena().allocated() == 0);
+}
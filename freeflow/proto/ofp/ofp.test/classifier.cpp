@@ -0,0 +1,135 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/sdn/packet.hpp>
+#include <freeflow/proto/ofp/v1.0/classifier.hpp>
+
+// Test that the classifier finds the highest priority matching rule
+// across subtables, honors network prefixes and exact-match precedence,
+// and detects overlapping rules.
+
+using namespace freeflow;
+using namespace freeflow::ofp;
+using namespace freeflow::ofp::v1_0;
+
+// Returns a match on all fields of a TCP packet.
+Match
+packet(Uint16 port, Uint8 src, Uint8 dst, Uint16 tp_dst) {
+  Match m {};
+  m.in_port = port;
+  m.dl_type = 0x0800;
+  m.nw_proto = 6;
+  m.nw_src = Ipv4_addr{{10, 0, 0, src}};
+  m.nw_dst = Ipv4_addr{{10, 0, 1, dst}};
+  m.tp_dst = tp_dst;
+  return m;
+}
+
+Match
+wildcard(Match m, Uint32 w) {
+  m.wildcards = Match::Wildcards(w);
+  return m;
+}
+
+int main() {
+  Classifier<int> c;
+  assert(c.empty());
+  assert(c.lookup(packet(1, 1, 1, 80)) == nullptr);
+
+  // Everything on port 1.
+  Uint32 any_but_port = Match::ALL & ~Match::IN_PORT;
+  assert(c.insert(wildcard(packet(1, 0, 0, 0), any_but_port), 10, 1));
+
+  // TCP port 80 to 10.0.1.0/24.
+  Uint32 web = Match::ALL & ~(Match::DL_TYPE | Match::NW_PROTO
+             | Match::TP_DST | Match::NW_DST);
+  web = (web & ~Match::NW_DST) | (8 << 14);
+  assert(c.insert(wildcard(packet(0, 0, 0, 80), web), 20, 2));
+
+  // An exact match at the lowest priority.
+  assert(c.insert(packet(1, 7, 7, 80), 0, 3));
+  assert(c.size() == 3);
+  assert(c.subtables() == 3);
+
+  assert(c.lookup(packet(1, 1, 1, 22))->value == 1);
+  assert(c.lookup(packet(1, 1, 1, 80))->value == 2);
+  assert(c.lookup(packet(2, 1, 9, 80))->value == 2);
+  assert(c.lookup(packet(1, 7, 7, 80))->value == 3);
+  assert(c.lookup(packet(2, 1, 1, 22)) == nullptr);
+
+  // Replacing a rule keeps the rule count.
+  assert(not c.insert(packet(1, 7, 7, 80), 0, 4));
+  assert(c.size() == 3);
+  assert(c.find(packet(1, 7, 7, 80), 0)->value == 4);
+  assert(c.find(packet(1, 7, 7, 80), 1) == nullptr);
+
+  // Prefixes longer than 32 bits are the same as 32.
+  Uint32 all = Match::ALL | (63 << 8);
+  assert(c.insert(wildcard(Match {}, all), 5, 5));
+  assert(c.subtables() == 4);
+  assert(c.find(wildcard(Match {}, Match::ALL), 5)->value == 5);
+  assert(c.lookup(packet(2, 1, 1, 22))->value == 5);
+
+  // Overlap checking only considers rules with the same priority.
+  assert(c.overlaps(wildcard(packet(1, 0, 0, 0), Match::ALL), 10));
+  assert(not c.overlaps(wildcard(packet(2, 0, 0, 0), any_but_port), 10));
+  assert(not c.overlaps(wildcard(packet(1, 0, 0, 0), any_but_port), 11));
+  assert(overlaps(packet(1, 7, 7, 80), wildcard(packet(0, 0, 0, 80), web)));
+  assert(not overlaps(packet(1, 7, 7, 22), wildcard(packet(0, 0, 0, 80), web)));
+
+  // Removing the last rule of a subtable removes the subtable.
+  assert(c.remove(wildcard(packet(0, 0, 0, 80), web), 20));
+  assert(not c.remove(wildcard(packet(0, 0, 0, 80), web), 20));
+  assert(c.subtables() == 3);
+  assert(c.lookup(packet(2, 1, 9, 80))->value == 5);
+  assert(c.lookup(packet(1, 1, 1, 80))->value == 1);
+
+  // Raising the highest priority of a subtable moves it ahead of the
+  // subtables it now outranks, and lowering it moves it back. Lookup
+  // stops at the first subtable that cannot hold a better match, so a
+  // misplaced subtable would be skipped.
+  Uint32 tp_only = Match::ALL & ~Match::TP_DST;
+  assert(c.insert(wildcard(packet(0, 0, 0, 22), tp_only), 1, 7));
+  assert(c.lookup(packet(1, 1, 1, 22))->value == 1);
+  assert(c.insert(wildcard(packet(0, 0, 0, 22), tp_only), 30, 8));
+  assert(c.lookup(packet(1, 1, 1, 22))->value == 8);
+  assert(c.lookup(packet(1, 7, 7, 80))->value == 4);
+  assert(c.remove(wildcard(packet(0, 0, 0, 22), tp_only), 30));
+  assert(c.lookup(packet(1, 1, 1, 22))->value == 1);
+  assert(c.lookup(packet(2, 1, 1, 22))->value == 5);
+  assert(c.remove(wildcard(packet(0, 0, 0, 22), tp_only), 1));
+  assert(c.subtables() == 3);
+
+  // The key of a parsed packet gives an exact match.
+  Buffer f(54, 0);
+  f[12] = 0x08;                       // IPv4
+  f[14] = 0x45;
+  f[23] = 6;                          // TCP
+  f[26] = 10; f[29] = 1;              // 10.0.0.1
+  f[30] = 10; f[32] = 1; f[33] = 9;   // 10.0.1.9
+  f[37] = 80;                         // Port 80
+  f[46] = 0x50;
+  Match m = exact_match(Packet(f, 1).key());
+  Match want = packet(1, 1, 9, 80);
+  want.dl_vlan = Packet_key::NO_VLAN;
+  assert(is_exact(m.wildcards));
+  assert(flow_key(m) == flow_key(want));
+  assert(c.lookup(m)->value == 1);
+
+  c.clear();
+  assert(c.empty());
+  assert(c.lookup(packet(1, 1, 1, 80)) == nullptr);
+}
@@ -0,0 +1,81 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/proto/ofp/keepalive.hpp>
+
+// Test that idle sessions are probed once per idle period, that silent
+// sessions are reported dead, and that the sweep timer is handed off
+// when its host is erased.
+
+using namespace freeflow;
+using namespace freeflow::ofp;
+
+int main() {
+  // Sessions are only identified by address.
+  char sessions[4];
+  auto session = [&](int n) { return reinterpret_cast<Protocol*>(&sessions[n]); };
+
+  Keepalive k(Seconds(10), Seconds(60), Seconds(1));
+  assert(k.empty());
+  assert(k.host() == nullptr);
+
+  Time_point t0 = now();
+  Keepalive::Id a = k.insert(session(0), t0);
+  Keepalive::Id b = k.insert(session(1), t0);
+  Keepalive::Id c = k.insert(session(2), t0);
+  assert(k.size() == 3);
+  assert(k.host() == session(0));
+
+  std::vector<Keepalive::Id> idle;
+  std::vector<Keepalive::Id> dead;
+
+  // Nothing is idle yet.
+  k.sweep(t0 + Seconds(5), idle, dead);
+  assert(idle.empty() and dead.empty());
+
+  // Traffic on b keeps it from being probed.
+  k.touch(b, t0 + Seconds(5));
+  k.sweep(t0 + Seconds(10), idle, dead);
+  assert(idle.size() == 2 and dead.empty());
+  assert(idle[0] == a and idle[1] == c);
+
+  // Probed sessions are not probed again until another idle period
+  // has elapsed.
+  idle.clear();
+  k.sweep(t0 + Seconds(15), idle, dead);
+  assert(idle.size() == 1 and idle[0] == b);
+  idle.clear();
+  k.sweep(t0 + Seconds(20), idle, dead);
+  assert(idle.size() == 2);
+
+  // Sessions that never reply are dead.
+  idle.clear();
+  k.touch(c, t0 + Seconds(30));
+  k.sweep(t0 + Seconds(60), idle, dead);
+  assert(dead.size() == 1 and dead[0] == a);
+
+  // Erasing the host hands the timer to another session.
+  assert(k.erase(a));
+  assert(k.host() == session(1));
+  assert(not k.erase(c));
+  assert(k.host() == session(1));
+
+  // Erased ids are reused.
+  Keepalive::Id d = k.insert(session(3), t0);
+  assert(d == a or d == c);
+  assert(k.session(d) == session(3));
+  assert(k.size() == 2);
+}
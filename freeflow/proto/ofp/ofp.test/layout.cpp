@@ -0,0 +1,71 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/proto/ofp/layout.hpp>
+#include <freeflow/proto/ofp/v1.0/match.hpp>
+#include <freeflow/proto/ofp/v1.0/stats.hpp>
+
+// Test compile-time wire layouts. Structures are encoded with their
+// padding in place and round-trip through a view.
+
+using namespace freeflow;
+using namespace freeflow::ofp;
+
+int main() {
+  static_assert(Wire<Header>::size == 8, "");
+  static_assert(Wire<v1_0::Match>::size == 40, "");
+  static_assert(Wire<v1_0::Port_stats_entry>::size == 104, "");
+  static_assert(Layout_offset<v1_0::Match_layout, 7>::value == 22, "");
+
+  v1_0::Match m1 = v1_0::Match();
+  m1.wildcards = v1_0::Match::NW_TOS;
+  m1.in_port = 0x0102;
+  m1.dl_pcp = 0x03;
+  m1.dl_type = 0x0800;
+  m1.nw_proto = 0x06;
+  m1.tp_dst = 0x0050;
+
+  // Padding is zero-filled on output.
+  Buffer b(40, 0xff);
+  View v1(b);
+  assert(store(v1, m1));
+  assert(v1.remaining() == 0);
+  assert(b[0] == 0x00 and b[1] == 0x20 and b[2] == 0x00 and b[3] == 0x00);
+  assert(b[4] == 0x01 and b[5] == 0x02);
+  assert(b[18] == 0x00 and b[19] == 0x00 and b[20] == 0x03 and b[21] == 0);
+  assert(b[22] == 0x08 and b[23] == 0x00);
+  assert(b[25] == 0x06 and b[26] == 0 and b[27] == 0);
+  assert(b[38] == 0x00 and b[39] == 0x50);
+
+  // A full view is required to write.
+  assert(not store(v1, m1));
+
+  View v2(b);
+  v1_0::Match m2;
+  assert(load(v2, m2));
+  assert(v2.remaining() == 0);
+  assert(m2.wildcards == m1.wildcards);
+  assert(m2.in_port == m1.in_port);
+  assert(m2.dl_pcp == m1.dl_pcp);
+  assert(m2.dl_type == m1.dl_type);
+  assert(m2.nw_proto == m1.nw_proto);
+  assert(m2.tp_dst == m1.tp_dst);
+
+  // A partial view is not read.
+  View v3(b, 39);
+  assert(not load(v3, m2));
+  assert(v3.remaining() == 39);
+}
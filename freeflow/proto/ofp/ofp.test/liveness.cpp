@@ -0,0 +1,171 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+#include <cassert>
+
+#include <sys/socket.h>
+
+#include <freeflow/sys/socket.hpp>
+#include <freeflow/sdn/controller.hpp>
+#include <freeflow/proto/ofp/v1.0/protocol.hpp>
+
+// Test that the keepalive timer runs when the switch is silent, that an
+// idle session is probed with an echo request, and that a session whose
+// switch never answers is closed. Flow modifications queued while the
+// switch is silent are sent without waiting for it.
+
+using namespace freeflow;
+using namespace freeflow::ofp;
+
+// A session driven by the reactor. Liveness is tracked by the given
+// keepalive table.
+struct Session : Socket_handler {
+  Session(Controller& c, Socket&& s, Keepalive& k)
+    : Socket_handler(c, READ_EVENTS | TIME_EVENTS, std::move(s))
+    , proto(&c, this, &k), closed(false)
+  { }
+
+  bool on_open() { return proto.on_open(reactor()) and flush(); }
+
+  bool on_close() { 
+    closed = true;
+    return proto.on_close(reactor()); 
+  }
+
+  bool on_read() {
+    Byte buf[1024];
+    System_result res = rc().read(buf, sizeof(buf));
+    if (res.failed() or res.value() == 0)
+      return false;
+    if (not proto.read.put_bytes(buf, res.value()))
+      return false;
+    while (not proto.read.empty())
+      if (not proto.on_recv(reactor()))
+        return false;
+    return flush();
+  }
+
+  bool on_write() { return flush(); }
+
+  bool on_time(int t) { return proto.on_time(reactor(), t) and flush(); }
+
+  // The peer always has room for the few messages in this test.
+  bool flush() {
+    while (not proto.write.empty()) {
+      const Buffer& b = proto.write.front();
+      if (rc().write(b.data(), b.size()).failed())
+        return false;
+      proto.write.pop();
+    }
+    reactor().unsubscribe_events(this, WRITE_EVENTS);
+    return true;
+  }
+
+  Protocol proto;
+  bool     closed;
+};
+
+// Returns an encoding of the message as if sent by the switch.
+template<typename P>
+  Buffer
+  encode(const P& m, Uint32 xid) {
+    v1_0::Header h(P::Kind, 8 + bytes(m), xid);
+    Buffer b(h.length);
+    View v(b);
+    assert(to_view(v, h));
+    assert(to_view(v, m));
+    return b;
+  }
+
+// Read the messages sent to the switch, returning the types received.
+std::vector<Uint8>
+receive(int fd) {
+  std::vector<Uint8> types;
+  Byte buf[1024];
+  ssize_t n = ::recv(fd, buf, sizeof(buf), MSG_DONTWAIT);
+  for (ssize_t i = 0; i + 8 <= n; ) {
+    types.push_back(buf[i + 1]);
+    Uint16 len;
+    Wire<Uint16>::load(buf + i + 2, len);
+    i += len;
+  }
+  return types;
+}
+
+bool
+contains(const std::vector<Uint8>& v, Uint8 t) {
+  return std::find(v.begin(), v.end(), t) != v.end();
+}
+
+int main() {
+  int fds[2];
+  assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  Address a {Local_sockaddr("")};
+
+  // The switch completes the handshake and then falls silent.
+  v1_0::Feature_reply f = v1_0::Feature_reply();
+  f.datapath_id = 0x42;
+  Buffer hello = encode(v1_0::Hello{}, 1);
+  Buffer features = encode(f, 2);
+  assert(::write(fds[1], hello.data(), hello.size()) == ssize_t(hello.size()));
+  assert(::write(fds[1], features.data(), features.size()) 
+         == ssize_t(features.size()));
+
+  Controller c;
+  Keepalive k(Milliseconds(20), Milliseconds(60), Milliseconds(5));
+  Session s(c, Socket(fds[0], Socket::TCP, a, a), k);
+  c.add_handler(&s);
+
+  // Run until the session is established.
+  Time_point t0 = now();
+  while (not c.find_switch(0x42) and now() - t0 < Seconds(1))
+    c.run(Milliseconds(1));
+  assert(c.find_switch(0x42));
+  assert(k.size() == 1);
+  std::vector<Uint8> sent = receive(fds[1]);
+  assert(contains(sent, v1_0::HELLO));
+  assert(contains(sent, v1_0::FEATURE_REQUEST));
+
+  // A flow modification queued from outside the session wakes it. The
+  // message is sent, followed by a barrier.
+  v1_0::Flow_mod fm = v1_0::Flow_mod();
+  fm.command = v1_0::Flow_mod::ADD;
+  c.find_switch(0x42)->flows().push(encode(fm, 0));
+  bool probed = false;
+  bool pushed = false;
+  while (not pushed and now() - t0 < Seconds(1)) {
+    c.run(Milliseconds(1));
+    sent = receive(fds[1]);
+    probed |= contains(sent, v1_0::ECHO_REQUEST);
+    pushed = contains(sent, v1_0::FLOW_MOD);
+  }
+  assert(pushed);
+  assert(contains(sent, v1_0::BARRIER_REQUEST));
+
+  // With no traffic from the switch, only timers wake the reactor. The
+  // idle session is probed, and then closed.
+  while (not s.closed and now() - t0 < Seconds(2)) {
+    c.run(Milliseconds(1));
+    if (contains(receive(fds[1]), v1_0::ECHO_REQUEST))
+      probed = true;
+  }
+  assert(probed);
+  assert(s.closed);
+  assert(c.find_switch(0x42) == nullptr);
+  assert(k.empty());
+  assert(now() - t0 >= Milliseconds(60));
+
+  ::close(fds[1]);
+}
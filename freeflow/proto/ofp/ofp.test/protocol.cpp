@@ -0,0 +1,200 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+#include <sys/socket.h>
+
+#include <freeflow/sys/socket.hpp>
+#include <freeflow/sdn/controller.hpp>
+#include <freeflow/sdn/snapshot.hpp>
+#include <freeflow/proto/ofp/v1.0/protocol.hpp>
+
+// Test that a session negotiates the protocol version and discovers
+// the switch's features, that messages split across reads are framed,
+// that established sessions answer echo requests, and that replies and
+// errors complete the transactions of requests. Switches connected by
+// sessions are saved in the controller's snapshot.
+
+using namespace freeflow;
+using namespace freeflow::ofp;
+
+// A session connected to one end of a socket pair. The session is
+// driven directly rather than by the reactor.
+struct Session : Socket_handler {
+  Session(Controller& c, Socket&& s)
+    : Socket_handler(c, READ_EVENTS, std::move(s))
+    , proto(&c, this, &c.keepalive())
+  { }
+
+  Protocol proto;
+};
+
+// Returns an encoding of the message as if sent by the switch.
+template<typename P>
+  Buffer
+  encode(const P& m, Uint32 xid) {
+    v1_0::Header h(P::Kind, 8 + bytes(m), xid);
+    Buffer b(h.length);
+    View v(b);
+    assert(to_view(v, h));
+    assert(to_view(v, m));
+    return b;
+  }
+
+// Deliver the bytes [first, last) of b to the session, dispatching each
+// complete message.
+bool
+feed(Session& s, Controller& c, const Buffer& b, 
+     std::size_t first, std::size_t last) {
+  if (not s.proto.read.put_bytes(b.data() + first, last - first))
+    return false;
+  while (not s.proto.read.empty())
+    if (not s.proto.on_recv(c))
+      return false;
+  return true;
+}
+
+bool
+feed(Session& s, Controller& c, const Buffer& b) {
+  return feed(s, c, b, 0, b.size());
+}
+
+// Remove the next message written by the session, returning its header.
+Header
+take(Session& s) {
+  assert(not s.proto.write.empty());
+  Buffer b;
+  s.proto.write.get_buffer(b);
+  View v(b);
+  Header h;
+  assert(from_view(v, h));
+  assert(h.length == b.size());
+  return h;
+}
+
+int main() {
+  int fds[2];
+  assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  Address a {Local_sockaddr("")};
+
+  Controller c;
+  Session s(c, Socket(fds[0], Socket::TCP, a, a));
+
+  // The session opens with a hello.
+  assert(s.proto.on_open(c));
+  Header h1 = take(s);
+  assert(h1.version == 1);
+  assert(h1.type == v1_0::HELLO);
+  assert(h1.length == 8);
+
+  // The switch's hello is answered with a feature request.
+  assert(feed(s, c, encode(v1_0::Hello{}, 1)));
+  Header h2 = take(s);
+  assert(h2.type == v1_0::FEATURE_REQUEST);
+  assert(s.proto.write.empty());
+
+  // The feature reply arrives in pieces. A partial header is held until
+  // the rest of the message is received.
+  v1_0::Port p = v1_0::Port();
+  p.port_id = 3;
+  std::strcpy(p.name.data, "eth3");
+  v1_0::Feature_reply f = v1_0::Feature_reply();
+  f.datapath_id = 0x1234;
+  f.ports.push_back(p);
+  Buffer b3 = encode(f, h2.xid);
+  assert(feed(s, c, b3, 0, 5));
+  assert(s.proto.read.empty());
+  assert(c.find_switch(0x1234) == nullptr);
+  assert(feed(s, c, b3, 5, 40));
+  assert(c.find_switch(0x1234) == nullptr);
+  assert(feed(s, c, b3, 40, b3.size()));
+
+  // The switch is registered, and its datapath is configured.
+  Switch* sw = c.find_switch(0x1234);
+  assert(sw);
+  assert(sw->protocol_version() == 1);
+  assert(sw->datapath().datapath_id == 0x1234);
+  assert(sw->datapath().ports.status(3));
+  assert(c.keepalive().size() == 1);
+
+  // The identified switch is saved in a snapshot.
+  const std::string path = "ofp_protocol.snapshot";
+  Snapshot snap;
+  assert(c.save_snapshot(path));
+  assert(snap.open(path));
+  assert(snap.size() == 1 and snap.contains(0x1234));
+
+  // Several messages in one read are dispatched in order. Echo requests
+  // are answered with the same xid and data.
+  v1_0::Echo_request e;
+  e.data = Buffer(3, 'x');
+  Buffer b4 = encode(e, 7);
+  Buffer b5 = encode(e, 8);
+  b4.insert(b4.end(), b5.begin(), b5.end());
+  assert(feed(s, c, b4));
+  Header h4 = take(s);
+  assert(h4.type == v1_0::ECHO_REPLY);
+  assert(h4.xid == 7);
+  assert(h4.length == 11);
+  Header h5 = take(s);
+  assert(h5.xid == 8);
+
+  // Replies to requests complete their transactions, and errors fail
+  // them. Requests are sent when the session next services the switch,
+  // e.g., after any reply.
+  Reply_future f1 = sw->barrier();
+  Reply_future f2 = sw->barrier();
+  assert(feed(s, c, encode(v1_0::Echo_reply{}, 99)));
+  Header h6 = take(s);
+  Header h7 = take(s);
+  assert(h6.type == v1_0::BARRIER_REQUEST);
+  assert(h7.type == v1_0::BARRIER_REQUEST);
+  assert(not f1.ready() and not f2.ready());
+
+  assert(feed(s, c, encode(v1_0::Barrier_reply{}, h6.xid)));
+  assert(f1.ready() and not f1.failed() and not f1.expired());
+
+  v1_0::Error_message err = v1_0::Error_message();
+  err.type = v1_0::Error_message::BAD_REQUEST;
+  err.code = v1_0::Error_message::BR_BAD_TYPE;
+  Buffer b7 = encode(err, h7.xid);
+  assert(feed(s, c, b7));
+  assert(f2.ready() and f2.failed() and not f2.expired());
+  assert(f2.get() == b7);
+
+  // An error that answers no request is discarded.
+  assert(feed(s, c, encode(err, 1000)));
+  assert(s.proto.write.empty());
+
+  // A header whose length is shorter than the header cannot be framed.
+  Buffer b6 = encode(v1_0::Hello{}, 9);
+  b6[3] = 4;
+  assert(not s.proto.read.put_bytes(b6.data(), b6.size()));
+
+  // Closing the session disconnects the switch.
+  assert(s.proto.on_close(c));
+  assert(c.find_switch(0x1234) == nullptr);
+  assert(c.keepalive().empty());
+
+  // The state of the disconnected switch is retained for the snapshot.
+  assert(c.save_snapshot(path));
+  assert(snap.open(path));
+  assert(snap.contains(0x1234));
+  std::remove(path.c_str());
+
+  ::close(fds[1]);
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/proto/ofp/v1.0/reconcile.hpp>
+
+// Test that reconciling a desired rule set against installed flows
+// produces only the flow mods needed to make them agree.
+
+using namespace freeflow;
+using namespace freeflow::ofp;
+using namespace freeflow::ofp::v1_0;
+
+Action
+output(Port::Id p) {
+  Action a;
+  a.header.type = ACTION_OUTPUT;
+  a.header.length = 8;
+  a.payload.output.port = p;
+  a.payload.output.max_len = 0;
+  return a;
+}
+
+// Returns a rule that forwards traffic on port p to port q.
+Flow_rule
+rule(Port::Id p, Port::Id q, Uint64 cookie) {
+  Flow_rule r {};
+  r.match.wildcards = Match::Wildcards(Match::ALL & ~Match::IN_PORT);
+  r.match.in_port = p;
+  r.priority = 100;
+  r.cookie = cookie;
+  r.actions.push_back(output(q));
+  return r;
+}
+
+// Returns the flow reported for the installed rule.
+Flow_stats_entry
+installed(const Flow_rule& r) {
+  Flow_stats_entry e {};
+  e.match = r.match;
+  e.priority = r.priority;
+  e.cookie = r.cookie;
+  e.idle_timeout = r.idle_timeout;
+  e.hard_timeout = r.hard_timeout;
+  e.actions = r.actions;
+  return e;
+}
+
+int main() {
+  Flow_rules want;
+  Flow_stats have;
+  for (Port::Id p = 1; p <= 10; ++p) {
+    want.push_back(rule(p, p + 1, 1));
+    have.push_back(installed(want.back()));
+  }
+
+  // Switches may report garbage in wildcarded fields.
+  have[0].match.tp_dst = 80;
+
+  // Nothing to do when the tables agree.
+  std::vector<Flow_mod> delta;
+  reconcile(want, have, delta);
+  assert(delta.empty());
+
+  // Port 2's rule has new actions, port 3's a new timeout, port 4's a
+  // new cookie, port 5's rule is no longer wanted, and port 11 is new.
+  want[1].actions[0] = output(20);
+  want[2].idle_timeout = 30;
+  want[3].cookie = 2;
+  want.erase(want.begin() + 4);
+  want.push_back(rule(11, 1, 1));
+
+  // Port 12's flow was installed by someone else.
+  have.push_back(installed(rule(12, 1, 7)));
+
+  reconcile(want, have, delta);
+  assert(delta.size() == 6);
+
+  // Deletions come first.
+  assert(delta[0].command == Flow_mod::DELETE_STRICT);
+  assert(delta[0].match.in_port == 5);
+  assert(delta[1].command == Flow_mod::DELETE_STRICT);
+  assert(delta[1].match.in_port == 12);
+
+  assert(delta[2].command == Flow_mod::MODIFY_STRICT);
+  assert(delta[2].match.in_port == 2);
+  assert(delta[2].actions[0].payload.output.port == 20);
+  assert(delta[3].command == Flow_mod::ADD);
+  assert(delta[3].match.in_port == 3);
+  assert(delta[3].idle_timeout == 30);
+  assert(delta[4].command == Flow_mod::ADD);
+  assert(delta[4].match.in_port == 4);
+  assert(delta[4].cookie == 2);
+  assert(delta[5].command == Flow_mod::ADD);
+  assert(delta[5].match.in_port == 11);
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/proto/ofp/v1.0/stats.hpp>
+
+// Test the bulk decoding of stats replies against the encoding of
+// individual entries.
+
+using namespace freeflow;
+using namespace freeflow::ofp;
+using namespace freeflow::ofp::v1_0;
+
+int main() {
+  constexpr std::size_t N = 7;
+
+  // Port stats
+  Port_stats ps1;
+  for (std::size_t i = 0; i < N; ++i) {
+    Port_stats_entry e = Port_stats_entry();
+    e.port_number = i + 1;
+    e.rx_packets = 0x0102030405060708ull + i;
+    e.tx_bytes = 0x1000 * i;
+    e.collisions = 0xff00ff00ff00ff00ull - i;
+    ps1.push_back(e);
+  }
+
+  Buffer b1(N * bytes(ps1[0]));
+  View v1(b1);
+  for (const Port_stats_entry& e : ps1)
+    assert(to_view(v1, e));
+  assert(v1.remaining() == 0);
+
+  View v2(b1);
+  Port_stats ps2;
+  assert(from_view(v2, ps2));
+  assert(v2.remaining() == 0);
+  assert(ps2.size() == N);
+  for (std::size_t i = 0; i < N; ++i) {
+    assert(ps2[i].port_number == ps1[i].port_number);
+    assert(ps2[i].rx_packets == ps1[i].rx_packets);
+    assert(ps2[i].tx_bytes == ps1[i].tx_bytes);
+    assert(ps2[i].rx_crc_err == 0);
+    assert(ps2[i].collisions == ps1[i].collisions);
+  }
+
+  // A truncated entry is an error.
+  View v3(b1, b1.size() - 1);
+  Port_stats ps3;
+  assert(not from_view(v3, ps3));
+
+  // Queue stats
+  Queue_stats qs1;
+  for (std::size_t i = 0; i < N; ++i) {
+    Queue_stats_entry e = Queue_stats_entry();
+    e.port_no = Port::Id(i + 1);
+    e.queue_id = 0x01020304 + i;
+    e.tx_bytes = 0x0102030405060708ull * i;
+    e.tx_errors = i;
+    qs1.push_back(e);
+  }
+
+  Buffer b2(N * bytes(qs1[0]));
+  View v4(b2);
+  for (const Queue_stats_entry& e : qs1)
+    assert(to_view(v4, e));
+
+  // Each entry begins with a port number and two bytes of padding.
+  assert(b2[0] == 0 and b2[1] == 1 and b2[2] == 0 and b2[3] == 0);
+
+  View v5(b2);
+  Queue_stats qs2;
+  assert(from_view(v5, qs2));
+  assert(qs2.size() == N);
+  for (std::size_t i = 0; i < N; ++i) {
+    assert(qs2[i].port_no == qs1[i].port_no);
+    assert(qs2[i].queue_id == qs1[i].queue_id);
+    assert(qs2[i].tx_bytes == qs1[i].tx_bytes);
+    assert(qs2[i].tx_packets == 0);
+    assert(qs2[i].tx_errors == qs1[i].tx_errors);
+  }
+
+  // A truncated reply does not change the sequence.
+  View v8(b2, b2.size() - 8);
+  assert(not from_view(v8, qs2));
+  assert(qs2.size() == N);
+
+  // Flow stats are reserved from the view length and allocated from
+  // the current arena.
+  Flow_stats fs1;
+  for (std::size_t i = 0; i < N; ++i) {
+    Flow_stats_entry e = Flow_stats_entry();
+    e.match.wildcards = Match::ALL;
+    e.cookie = i;
+    for (Uint16 j = 0; j < 3; ++j) {
+      Action a;
+      a.header.type = ACTION_OUTPUT;
+      a.header.length = 8;
+      a.payload.output.port = Port::Id(j + 1);
+      a.payload.output.max_len = 0;
+      e.actions.push_back(a);
+    }
+    e.length = bytes(e);
+    fs1.push_back(e);
+  }
+
+  Buffer b3(bytes(fs1));
+  View v6(b3);
+  assert(to_view(v6, fs1));
+
+  Arena arena;
+  {
+    Resource_scope scope(arena);
+    View v7(b3);
+    Flow_stats fs2;
+    assert(from_view(v7, fs2));
+    assert(fs2.size() == N);
+    assert(fs2.capacity() == b3.size() / 88);
+    for (std::size_t i = 0; i < N; ++i) {
+      assert(fs2[i].cookie == i);
+      assert(fs2[i].actions.size() == 3);
+      assert(fs2[i].actions.capacity() == 3);
+      assert(fs2[i].actions[2].payload.output.port == 3);
+      assert(fs2[i].actions.get_allocator().resource() == &arena);
+    }
+  }
+  assert(arena.blocks() == 1);
+
+  // An entry whose length overruns the reply discards the entries read
+  // before it.
+  Buffer b4 = b3;
+  b4[bytes(fs1[0])] = 0xff;
+  View v9(b4);
+  Flow_stats fs3;
+  fs3.push_back(fs1[0]);
+  assert(not from_view(v9, fs3));
+  assert(fs3.size() == 1);
+}
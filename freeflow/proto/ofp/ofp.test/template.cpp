@@ -0,0 +1,127 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/proto/ofp/template.hpp>
+#include <freeflow/proto/ofp/v1.0/message.hpp>
+
+// Test that messages sent from templates decode with their patched
+// fields.
+
+using namespace freeflow;
+using namespace freeflow::ofp::v1_0;
+
+int main() {
+  Flow_mod m1 = Flow_mod();
+  m1.match.wildcards = Match::ALL;
+  m1.command = Flow_mod::ADD;
+  m1.idle_timeout = 5;
+  m1.hard_timeout = 10;
+  m1.priority = 0x8000;
+  m1.buffer_id = 0xffffffff;
+  m1.out_port = Port::NONE;
+
+  Header h1(FLOW_MOD, 8 + bytes(m1), 0);
+  ofp::Message_template t;
+  assert(t.encode(h1, m1));
+  assert(t.size() == 72);
+
+  // Patch a copy of the message.
+  ofp::Mac_addr mac {{1, 2, 3, 4, 5, 6}};
+  Buffer b = t.buffer();
+  patch(b, ofp::header_xid, Uint32(42));
+  patch(b, flow_mod_dl_dst, mac);
+  patch(b, flow_mod_tp_dst, Uint16(80));
+  patch(b, flow_mod_priority, Uint16(7));
+  patch(b, flow_mod_out_port, Port::Id(3));
+
+  View v(b);
+  Header h2;
+  Flow_mod m2 = Flow_mod();
+  assert(from_view(v, h2));
+  assert(from_view(v, m2));
+  assert(v.remaining() == 0);
+
+  assert(h2.type == FLOW_MOD);
+  assert(h2.length == 72);
+  assert(h2.xid == 42);
+  for (int i = 0; i < 6; ++i)
+    assert(m2.match.dl_dst.addr[i] == mac.addr[i]);
+  assert(m2.match.tp_dst == 80);
+  assert(m2.match.wildcards == Match::ALL);
+  assert(m2.idle_timeout == 5);
+  assert(m2.hard_timeout == 10);
+  assert(m2.priority == 7);
+  assert(m2.buffer_id == 0xffffffff);
+  assert(m2.out_port == 3);
+
+  // The template itself is unchanged.
+  View v2(const_cast<Buffer&>(t.buffer()));
+  Header h3;
+  Flow_mod m3 = Flow_mod();
+  assert(from_view(v2, h3));
+  assert(from_view(v2, m3));
+  assert(h3.xid == 0);
+  assert(m3.priority == 0x8000);
+
+  // Patch the whole match and the port of the first output action.
+  Action a;
+  a.header.type = ACTION_OUTPUT;
+  a.header.length = 8;
+  a.payload.output.port = Port::FLOOD;
+  a.payload.output.max_len = 0;
+  m1.actions.push_back(a);
+  Header h4(FLOW_MOD, 8 + bytes(m1), 0);
+  assert(t.encode(h4, m1));
+
+  Match m = Match();
+  m.in_port = 2;
+  m.dl_type = 0x0800;
+  m.nw_dst = ofp::Ipv4_addr{{10, 0, 0, 1}};
+  Buffer b4 = t.buffer();
+  patch(b4, flow_mod_match, m);
+  patch(b4, flow_mod_output_port, Port::Id(9));
+
+  View v4(b4);
+  Flow_mod m4 = Flow_mod();
+  assert(from_view(v4, h4));
+  assert(from_view(v4, m4));
+  assert(m4.match.wildcards == 0);
+  assert(m4.match.in_port == 2);
+  assert(m4.match.dl_type == 0x0800);
+  assert(m4.match.nw_dst.addr[0] == 10 and m4.match.nw_dst.addr[3] == 1);
+  assert(m4.actions.size() == 1);
+  assert(m4.actions[0].payload.output.port == 9);
+
+  // A packet-out that does not fit its buffer is not encoded.
+  Packet_out p = Packet_out();
+  p.buffer_id = 0xffffffff;
+  p.port = Port::NONE;
+  p.actions.push_back(a);
+  p.actions_len = 8;
+  p.data = Buffer(4, 0xab);
+  Buffer b5(bytes(p));
+  View v5(b5);
+  assert(to_view(v5, p));
+  assert(v5.remaining() == 0);
+
+  Buffer b6(bytes(p) - 1);
+  View v6(b6);
+  assert(not to_view(v6, p));
+
+  p.actions_len = 12;
+  View v7(b5);
+  assert(not to_view(v7, p));
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/proto/ofp/transaction.hpp>
+
+// Test that transactions are found by xid, survive deletion of their
+// neighbors, are expired in bulk, and can be failed by an error.
+
+using namespace freeflow;
+using namespace freeflow::ofp;
+
+int main() {
+  constexpr Uint32 N = 1000;
+
+  Time_point t0 = now();
+  Transaction_table tab;
+  std::vector<std::shared_ptr<Transaction>> txns;
+  for (Uint32 x = 0; x < N; ++x) {
+    txns.push_back(std::make_shared<Transaction>());
+    assert(tab.insert(x, t0 + Seconds(x % 10), txns.back()));
+  }
+  assert(tab.size() == N);
+  assert(tab.capacity() >= 2 * N);
+  assert(not tab.insert(7, t0, std::make_shared<Transaction>()));
+  assert(tab.next_deadline() == t0);
+
+  // Complete every third transaction.
+  int notified = 0;
+  for (Uint32 x = 0; x < N; x += 3) {
+    auto t = tab.take(x);
+    assert(t == txns[x]);
+    t->complete();
+  }
+  assert(not tab.take(0));
+  for (Uint32 x = 0; x < N; ++x)
+    assert((tab.find(x) != nullptr) == (x % 3 != 0));
+
+  // Expire everything due in the first five seconds.
+  for (Uint32 x = 0; x < N; ++x)
+    Reply_future(txns[x]).then([&](const Transaction&) { ++notified; });
+  assert(notified == (N + 2) / 3);
+  notified = 0;
+
+  std::size_t n = tab.size();
+  std::size_t k = tab.expire(t0 + Seconds(4));
+  assert(k > 0);
+  assert(notified == int(k));
+  assert(tab.size() == n - k);
+  for (Uint32 x = 0; x < N; ++x) {
+    if (x % 3 == 0)
+      assert(not txns[x]->expired());
+    else if (x % 10 <= 4)
+      assert(txns[x]->expired() and not tab.find(x));
+    else
+      assert(txns[x]->pending() and tab.find(x) == txns[x].get());
+  }
+  assert(tab.next_deadline() == t0 + Seconds(5));
+  assert(tab.expire(t0 + Seconds(4)) == 0);
+
+  // Replies are accumulated until the transaction completes.
+  Transaction* t = tab.find(5);
+  Buffer b(8, 1);
+  t->append(b);
+  t->append(b);
+  tab.take(5)->complete();
+  Reply_future f(txns[5]);
+  assert(f.ready() and not f.expired());
+  assert(f.get().size() == 16);
+
+  // An error replaces any partial reply and fails the transaction.
+  t = tab.find(7);
+  t->append(b);
+  tab.take(7)->fail(Buffer(12, 2));
+  Reply_future e(txns[7]);
+  assert(e.ready() and e.failed() and not e.expired());
+  assert(e.get() == Buffer(12, 2));
+  assert(not f.failed());
+
+  tab.expire(Time_point::max());
+  assert(tab.empty());
+}
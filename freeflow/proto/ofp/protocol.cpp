@@ -13,11 +13,13 @@
 // permissions and limitations under the License.
 
 #include <algorithm>
+#include <vector>
 
 #include <freeflow/sys/socket.hpp>
 #include <freeflow/sdn/controller.hpp>
 
 #include <freeflow/proto/ofp/v1.0/message.hpp>
+#include <freeflow/proto/ofp/v1.0/burst.hpp>
 #include <freeflow/proto/ofp/v1.0/protocol.hpp>
 
 #include "protocol.hpp"
@@ -25,6 +27,68 @@
 namespace freeflow {
 namespace ofp {
 
+constexpr std::size_t Dispatch_table::size;
+
+namespace {
+
+// Returns a packet-out that sends a buffered packet through the flow
+// table. The buffer id and input port are patched when it is sent.
+v1_0::Packet_out
+make_resubmit() {
+  using namespace v1_0;
+  Action a;
+  a.header.type = ACTION_OUTPUT;
+  a.header.length = 8;
+  a.payload.output.port = Port::TABLE;
+  a.payload.output.max_len = 0;
+
+  Packet_out m;
+  m.buffer_id = Packet::NO_BUFFER;
+  m.port = Port::NONE;
+  m.actions.push_back(a);
+  m.actions_len = bytes(m.actions);
+  return m;
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------- //
+// Message queue
+
+/// Append bytes read from the connection to the queue. Each message
+/// completed by the bytes is queued, and any trailing part of a message
+/// is held until the rest of it is received. Returns false if a header
+/// gives a length shorter than the header itself, after which the
+/// stream cannot be framed.
+bool
+Message_queue::put_bytes(const Byte* p, std::size_t n) {
+  constexpr std::size_t hdr = Header_layout::size;
+  const Byte* last = p + n;
+  while (true) {
+    std::size_t need = hdr;
+    if (partial_.size() >= hdr) {
+      Uint16 len;
+      Wire<Uint16>::load(partial_.data() + 2, len);
+      if (len < hdr)
+        return false;
+      need = len;
+      if (partial_.size() == need) {
+        push(std::move(partial_));
+        partial_.clear();
+        continue;
+      }
+    }
+    if (p == last)
+      return true;
+    std::size_t k = std::min<std::size_t>(need - partial_.size(), last - p);
+    partial_.insert(partial_.end(), p, p + k);
+    p += k;
+  }
+}
+
+// -------------------------------------------------------------------------- //
+// Protocol
+
 /// FIXME: This doens't exist any more...
 
 bool 
@@ -45,30 +109,57 @@ Protocol::on_open(Reactor& r) {
 }
 
 /// When the connection is shutdown, release any switch-related
-/// resources in the controller.
+/// resources in the controller. Outstanding transactions expire, and
+/// the session is no longer tracked for liveness. If this session
+/// hosted the keepalive timer, it is handed to another session.
 bool
-Protocol::on_close(Reactor&) { 
+Protocol::on_close(Reactor& r) { 
+  txns_.expire(Time_point::max());
+  switch_->flows().on_push(nullptr);
+  ctrl_->poller().cancel(switch_->polling());
+  polls_.clear();
+  if (state_ == ESTABLISHED and alive_->erase(alive_id_))
+    r.schedule_timer(alive_->host()->handler_, ktime_, alive_->interval());
   ctrl_->disconnect(*switch_);
   return true; 
 }
 
+/// Read the header of the next message and act on it according to the
+/// current state. The header is read once and passed to the handler.
+/// Any traffic on an established connection is evidence of liveness.
+/// If no complete message has been received, the session waits for more
+/// bytes.
+///
+/// Packet-ins that exceed the switch's or the controller's admission
+/// limits are discarded here, before they are decoded.
 bool
 Protocol::on_recv(Reactor& r) {
+  Header h;
+  if (read.empty() or not read.peek_header(h))
+    return true;
+  if (state_ == ESTABLISHED) {
+    Time_point t = now();
+    alive_->touch(alive_id_, t);
+    if (h.type == v1_0::PACKET_IN 
+        and not ctrl_->admission().admit(switch_->admission(), t)) {
+      read.pop();
+      return true;
+    }
+    return established_recv(r, h);
+  }
   if (state_ == HELLO)
-    return hello_recv(r);
+    return hello_recv(r, h);
   if (state_ == FEATURE)
-    return feature_recv(r);
-  if (state_ == ESTABLISHED)
-    return established_recv(r);
+    return feature_recv(r, h);
   return true;
 }
 
 bool
 Protocol::on_time(Reactor& r, int t) { 
   if (state_ == HELLO)
-    return hello_recv(r);
+    return hello_time(r);
   if (state_ == FEATURE)
-    return feature_recv(r);
+    return feature_time(r);
   if (state_ == ESTABLISHED)
     return established_time(r, t);
   return true;
@@ -78,9 +169,13 @@ bool
 Protocol::open_to_hello(Reactor& r) {
   state_ = HELLO;
 
-  // Send the hello message.
-  // FIXME: Send hello from the highest protocol version supported.
-  put_message(v1_0::Hello{});
+  // Send the hello message from the highest protocol version supported.
+  // The switch's version is not known until its hello arrives.
+  v1_0::Hello m;
+  Header h { 
+    config_.current_version, v1_0::HELLO, Uint16(bytes(h) + bytes(m)), xid()
+  };
+  write.put_message(h, m);
 
   // Install a timeout timer.
   r.schedule_timer(handler_, ctime_, config_.connection_timeout);
@@ -91,15 +186,14 @@ Protocol::open_to_hello(Reactor& r) {
 /// \todo What do we do if the hello has extra data? Presumably we'd pass
 /// that to some kind of vendor extension?
 bool
-Protocol::hello_recv(Reactor& r) {
-  Header h;
-  read.peek_header(h);
+Protocol::hello_recv(Reactor& r, const Header& h) {
   if (h.type != v1_0::HELLO)
     return false;
+  read.pop();
 
   // Negotiate the current protocol version.
-  proto_ = negotiate(h.version);
-  if (not proto_)
+  dispatch_ = negotiate(h.version);
+  if (not dispatch_)
     return hello_to_close(r);
 
   // Service any events resulting from version negotiation.
@@ -132,26 +226,33 @@ bool
 Protocol::hello_to_close(Reactor& r) { return false; }
 
 bool
-Protocol::feature_recv(Reactor& r) {
-  // Reschedule the ping timer. 
-  r.reschedule_timer(handler_, mtime_, config_.message_timeout);
-
+Protocol::feature_recv(Reactor& r, const Header& h) {
   // Determine the kind of message.
-  // FIXME: Check against the negotiated version, not 1.0.
-  Header h;
-  read.peek_header(h);
   if (protocol_version(h) != switch_->protocol_version())
     return false;
   if (h.type != v1_0::FEATURE_REPLY)
     return false;
 
-  // FXIME: Actually update the switch with features and capabilities
-  // read from the reply. There should be a sequence of calls to the
-  // switch to initialize its configuration.
-  v1_0::Feature_reply p;
-  get_payload(h, p);
+  // The fingerprint of the reply excludes the header, whose xid varies.
+  Buffer& msg = read.front();
+  Uint64 fp = fingerprint(msg.data() + 8, msg.size() - 8);
 
-  datapath_config(switch_->datapath(), p);
+  // The reply is decoded into a burst so that its port list is allocated
+  // from the burst's arena, and freed with it when configuration is done.
+  v1_0::Burst burst;
+  View v(msg);
+  if (not burst.decode(v) or burst.size() != 1)
+    return false;
+  const v1_0::Feature_reply& p = burst[0].payload.feature_rep;
+
+  // Restore any state retained from a previous connection of the same
+  // datapath, or saved by a previous run of the controller. A datapath
+  // whose feature reply is unchanged needs no reconfiguration.
+  ctrl_->identify(*switch_, p.datapath_id);
+  if (not ctrl_->restore(*switch_, fp))
+    v1_0::datapath_config(switch_->datapath(), p);
+  burst.release();
+  read.pop();
 
   // Inidate that the switch is done being configured.
   switch_->configured();
@@ -168,8 +269,9 @@ Protocol::feature_recv(Reactor& r) {
 bool
 Protocol::feature_time(Reactor& r) { return feature_to_close(r); }
 
-/// When moving the the established state, we only need to initiate
-/// the echo timer.
+/// When moving the the established state, the session is tracked by
+/// the controller-wide keepalive table. The first tracked session hosts
+/// the keepalive timer.
 bool
 Protocol::feature_to_established(Reactor& r) {
   state_ = ESTABLISHED;
@@ -177,9 +279,22 @@ Protocol::feature_to_established(Reactor& r) {
   // Cancel the timeout timer.
   r.cancel_timer(handler_, ctime_);
 
-  // Set the message timer to send a ping if we haven't heard
-  // from the switch in a while.
-  r.schedule_timer(handler_, mtime_, config_.message_timeout);
+  // Track liveness. Probes are sent from a template.
+  make_template(echo_, v1_0::Echo_request{});
+  make_template(resubmit_, make_resubmit());
+  alive_id_ = alive_->insert(this, now());
+  if (alive_->host() == this)
+    r.schedule_timer(handler_, ktime_, alive_->interval());
+
+  // Start polling for statistics.
+  if (not ctrl_->poller().limits().kinds.empty())
+    r.schedule_timer(handler_, ptime_, 
+                     ctrl_->poller().start(switch_->polling()));
+
+  // Start sending any flow modifications queued during discovery, and
+  // wake when more are queued.
+  switch_->flows().on_push([this]() { wake(); });
+  pump(r);
 
   return true;
 }
@@ -187,26 +302,10 @@ Protocol::feature_to_established(Reactor& r) {
 bool
 Protocol::feature_to_close(Reactor& r) { return false; }
 
+/// Dispatch the message through the table of the negotiated version.
 bool
-Protocol::established_recv(Reactor& r) {
-  // Read and dispatch the message.
-  //
-  // FIXME: Dispatch according to version first.
-  Header h;
-  read.peek_header(h);
-  switch (h.type) {
-  case v1_0::ECHO_REPLY: return established_recv_echo(r);
-  default: return true;
-  }
-  return true;
-}
-
-/// After receiving an echo reply, cancel the timeout and schedule the
-/// next ping message.
-bool
-Protocol::established_recv_echo(Reactor& r) {
-  r.cancel_timer(handler_, ctime_);
-  return true;
+Protocol::established_recv(Reactor& r, const Header& h) {
+  return dispatch(*dispatch_, h.type)(*this, r, h);
 }
 
 /// Act on a timer.
@@ -214,27 +313,109 @@ bool
 Protocol::established_time(Reactor& r, int t) {
   if (t == ctime_)
     return established_to_close(r);
-  if (t == mtime_)
-    return ping(r);
+  if (t == ktime_)
+    return keepalive(r);
+  if (t == ttime_)
+    return sweep(r);
+  if (t == ptime_)
+    return poll(r);
+  if (t == wtime_)
+    return woken(r);
   return true;
 }
 
 bool
 Protocol::established_to_close(Reactor&) { return false; }
 
-/// Send an echo request and set the timer.
+/// Complete the transaction of the reply at the front of the read queue.
+/// If more is true, the reply is continued in later messages and the
+/// transaction remains outstanding. Replies to unknown or expired
+/// transactions are discarded.
 bool
-Protocol::ping(Reactor& r) {
-  v1_0::Echo_request m;
-  put_message(m);
-  r.schedule_timer(handler_, ctime_, config_.connection_timeout);
+Protocol::on_reply(Reactor& r, const Header& h, bool more) {
+  if (Transaction* t = txns_.find(h.xid)) {
+    t->append(read.front());
+    if (not more)
+      txns_.take(h.xid)->complete();
+  }
+  read.pop();
+  return service(r);
+}
+
+/// Fail the transaction of the request rejected by the error message at
+/// the front of the read queue. Errors that do not answer an outstanding
+/// request are discarded.
+bool
+Protocol::on_error(Reactor& r, const Header& h) {
+  if (txns_.find(h.xid))
+    txns_.take(h.xid)->fail(read.front());
+  read.pop();
+  return service(r);
+}
+
+/// Deliver the packet, which views the frame of the packet-in message at
+/// the front of the read queue, to the switch's applications. The
+/// message is discarded afterwards.
+///
+/// Packets of flows that are pending setup are absorbed here, before any
+/// application sees them.
+bool
+Protocol::on_packet_in(Reactor& r, const Packet& p) {
+  if (not switch_->pending().absorb(p, now()))
+    switch_->packet_in(p);
+  read.pop();
+  return service(r);
+}
+
+/// Expire transactions whose deadlines have passed. The timer is
+/// rescheduled while any transactions remain outstanding.
+bool
+Protocol::sweep(Reactor& r) {
+  txns_.expire(now());
+  if (not txns_.empty())
+    r.schedule_timer(handler_, ttime_, config_.request_timeout);
+  return service(r);
+}
+
+/// Sweep the keepalive table on behalf of all established sessions.
+/// Idle sessions are probed with an echo request, and dead sessions are
+/// closed. This is only called on the session hosting the timer, which
+/// also delivers the controller's periodic tick to its applications.
+bool
+Protocol::keepalive(Reactor& r) {
+  std::vector<Keepalive::Id> idle;
+  std::vector<Keepalive::Id> dead;
+  alive_->sweep(now(), idle, dead);
+  for (Keepalive::Id id : idle)
+    alive_->session(id)->probe(r);
+  for (Keepalive::Id id : dead)
+    alive_->session(id)->expire(r);
+  r.schedule_timer(handler_, ktime_, alive_->interval());
+  ctrl_->tick();
   return true;
 }
 
-// Configure the protocol version.
+/// Send an echo request. Any reply, or any other message, from the
+/// switch marks the session as live.
+void
+Protocol::probe(Reactor& r) {
+  put_template(echo_);
+  r.subscribe_events(handler_, WRITE_EVENTS);
+}
+
+/// Close the session the next time the reactor runs. Sessions are not
+/// closed during a sweep since the host session may be among them.
+void
+Protocol::expire(Reactor& r) {
+  r.schedule_timer(handler_, ctime_, Microseconds(0));
+}
+
+// Configure the protocol version, returning the dispatch table for
+// the negotiated version.
+//
 // Note that version negotiation should never fail, assuming that we've
 // actually impletemeted the full set of protocols.
-Protocol_handler*
+const Dispatch_table*
 Protocol::negotiate(Uint8 v) {
   Uint8 v0 = std::min(config_.current_version, v);
   Uint8 v1 = protocol_version(v0),
@@ -243,9 +424,9 @@ Protocol::negotiate(Uint8 v) {
   // Set protocol the protocol information on the switch.
   switch_->set_protocol(v1, ve);
 
-  switch (v) {
-  case 0:
-    return new v1_0::Handler(*this);
+  switch (v1) {
+  case v1_0::VERSION:
+    return &v1_0::dispatch_table();
   default:
     return nullptr; // Not supported.
   }
@@ -260,14 +441,70 @@ bool
 Protocol::service(Reactor& r) {
   bool result = true;
   Request_queue& reqs = switch_->requests();
-  while (not reqs.empty()) {
-    Request req = reqs.front();
+  while (Request* req = reqs.front()) {
+    result &= service(r, *req);
     reqs.pop();
-    result &= service(r, req);
   }
+
+  // Decode the replies of a stats poll round once all have arrived.
+  if (not polls_.empty())
+    collect(r);
+
+  // Release the packets of pending flows that have expired.
+  Pending_flows& pf = switch_->pending();
+  if (not pf.empty()) {
+    pf.expire(now(), held_);
+    release(held_);
+  }
+  if (state_ == ESTABLISHED)
+    pump(r);
   return result;
 }
 
+/// Send batches from the switch's flow channel until its backlog is
+/// empty or its window is full. Each batch is followed by a barrier
+/// whose reply acknowledges the batch and re-opens the window.
+void
+Protocol::pump(Reactor& r) {
+  Flow_channel& ch = switch_->flows();
+  std::vector<Buffer> batch;
+  while (ch.ready()) {
+    ch.take(batch);
+    for (Buffer& b : batch) {
+      patch(b, header_xid, xid());
+      write.put_buffer(std::move(b));
+    }
+    batch.clear();
+
+    auto t = std::make_shared<Transaction>();
+    t->then([&ch](const Transaction& t) { ch.acknowledge(not t.expired()); });
+    put_request(r, v1_0::Barrier_request{}, t);
+  }
+}
+
+/// Service the switch the next time the reactor runs. This is signaled
+/// when flow modifications are queued, possibly by a northbound client
+/// rather than in response to the switch, so that they are sent without
+/// waiting for traffic from the switch. Repeated signals before the
+/// session wakes have no further effect.
+void
+Protocol::wake() {
+  if (awake_)
+    return;
+  awake_ = true;
+  ctrl_->schedule_timer(handler_, wtime_, Microseconds(0));
+}
+
+/// Send the messages queued since the session was woken.
+bool
+Protocol::woken(Reactor& r) {
+  awake_ = false;
+  bool ok = service(r);
+  if (not write.empty())
+    r.subscribe_events(handler_, WRITE_EVENTS);
+  return ok;
+}
+
 /// Dispatch an appropriate response to the request. This function
 /// only returns false if a disconnection event is serviced.
 bool
@@ -275,6 +512,9 @@ Protocol::service(Reactor& r, const Request& req) {
   switch (req.type) {
   case Request::DISCONNECT: return on_disconnect(r, req);
   case Request::TERMINATE: return on_terminate(r, req);
+  case Request::STATS: return on_stats(r, req);
+  case Request::BARRIER: return on_barrier(r, req);
+  case Request::RELEASE: return on_release(r, req);
   default: return true;
   }
 }
@@ -294,5 +534,159 @@ Protocol::on_terminate(Reactor& r, const Request& req) {
   return true;
 }
 
+namespace {
+
+// Returns the stats request for the given kind. Requests cover all
+// flows, ports and queues.
+v1_0::Stats_request
+make_stats_request(Stats_kind k) {
+  using namespace v1_0;
+  Stats_request m;
+  m.header.flags = Stats_header::Flags();
+  switch (k) {
+  case Stats_kind::DESCRIPTION: 
+    m.header.type = STATS_DESC; 
+    break;
+  case Stats_kind::FLOW:
+  case Stats_kind::AGGREGATE:
+    m.header.type = k == Stats_kind::FLOW ? STATS_FLOW : STATS_AGGREGATE;
+    m.payload.flow = Flow_stats_request();
+    m.payload.flow.match.wildcards = Match::ALL;
+    m.payload.flow.table_id = 0xff;
+    m.payload.flow.out_port = Port::NONE;
+    break;
+  case Stats_kind::TABLE: 
+    m.header.type = STATS_TABLE; 
+    break;
+  case Stats_kind::PORT:
+    m.header.type = STATS_PORT;
+    m.payload.port.port_number = Port::NONE;
+    break;
+  case Stats_kind::QUEUE:
+    m.header.type = STATS_QUEUE;
+    m.payload.queue.port_number = Port::ALL;
+    m.payload.queue.queue_id = 0xffffffff;
+    break;
+  }
+  return m;
+}
+
+// Returns the key of a flow in the switch's counter store. A flow is
+// identified by its table, priority and match.
+Uint64
+flow_key(const v1_0::Flow_stats_entry& e) {
+  Byte k[v1_0::Match_layout::size + 3];
+  v1_0::Match_layout::store(k, e.match);
+  Wire<Uint16>::store(k + v1_0::Match_layout::size, e.priority);
+  k[v1_0::Match_layout::size + 2] = e.table_id;
+  return fingerprint(k, sizeof(k));
+}
+
+} // namespace
+
+/// Send a stats request to the switch, recording its transaction.
+bool
+Protocol::on_stats(Reactor& r, const Request& req) {
+  put_request(r, make_stats_request(req.data.stats.kind), req.txn);
+  return true;
+}
+
+/// Start a stats poll round, requesting each kind of statistics polled
+/// by the controller. The round is deferred if the controller's budget
+/// of outstanding requests is spent, or if packet-ins from the switch
+/// are currently being limited.
+bool
+Protocol::poll(Reactor& r) {
+  Stats_poller& sp = ctrl_->poller();
+  Switch_poll& p = switch_->polling();
+  const Token_bucket& b = switch_->admission().bucket;
+  const std::vector<Stats_kind>& kinds = sp.limits().kinds;
+  bool busy = not b.unlimited() and b.tokens(now()) < 1;
+  if (kinds.empty())
+    return true;
+  if (busy or not sp.acquire(p, kinds.size())) {
+    r.schedule_timer(handler_, ptime_, sp.defer(p));
+    return true;
+  }
+  for (Stats_kind k : kinds) {
+    auto t = std::make_shared<Transaction>();
+    put_request(r, make_stats_request(k), t);
+    polls_.emplace_back(k, std::move(t));
+  }
+  return true;
+}
+
+/// When every reply of the poll round has arrived or expired, make one
+/// pass over the replies. They are delivered to the poller's handlers,
+/// and the entries of port and flow stats are read in place, without
+/// decoding the replies into sequences. Their counters are recorded in
+/// the switch's counter store, and their packet counters are summed to
+/// adapt the switch's polling interval. The next round is then
+/// scheduled.
+void
+Protocol::collect(Reactor& r) {
+  for (const Poll& p : polls_)
+    if (p.second->pending())
+      return;
+
+  Stats_poller& sp = ctrl_->poller();
+  Counter_store& cs = switch_->counters();
+  Time_point t = now();
+  Uint64 total = 0;
+  for (const Poll& p : polls_) {
+    if (p.second->expired() or p.second->failed())
+      continue;
+    const Buffer& b = p.second->reply();
+    if (p.first == Stats_kind::PORT)
+      v1_0::scan_port_stats(b.data(), b.size(), 
+        [&](const v1_0::Port_stats_entry& e) {
+          const Uint64 v[] { 
+            e.rx_packets, e.tx_packets, e.rx_bytes, e.tx_bytes,
+            e.rx_dropped, e.tx_dropped, e.rx_errors, e.tx_errors
+          };
+          cs.add_port(e.port_number, t, v);
+          total += e.rx_packets + e.tx_packets;
+        });
+    else if (p.first == Stats_kind::FLOW)
+      v1_0::scan_flow_stats(b.data(), b.size(), 
+        [&](const v1_0::Flow_stats_entry& e) {
+          const Uint64 v[] { e.packet_count, e.byte_count };
+          cs.add_flow(flow_key(e), t, v);
+          total += e.packet_count;
+        });
+    sp.deliver(*switch_, p.first, b);
+  }
+  cs.expire(t);
+  polls_.clear();
+  r.schedule_timer(handler_, ptime_, sp.complete(switch_->polling(), total));
+}
+
+/// Send a barrier request to the switch, recording its transaction.
+bool
+Protocol::on_barrier(Reactor& r, const Request& req) {
+  put_request(r, v1_0::Barrier_request{}, req.txn);
+  return true;
+}
+
+/// Release a pending flow, resubmitting any packets held for it.
+bool
+Protocol::on_release(Reactor& r, const Request& req) {
+  switch_->pending().release(req.data.release.key, held_);
+  release(held_);
+  return true;
+}
+
+// Resubmit each held packet to the switch's flow table, where the rule
+// for its flow should now be installed, and clear the list.
+void
+Protocol::release(Held_packets& held) {
+  for (const Held_packet& h : held) {
+    Buffer& b = put_template(resubmit_);
+    patch(b, v1_0::packet_out_buffer_id, h.buffer_id);
+    patch(b, v1_0::packet_out_in_port, h.in_port);
+  }
+  held.clear();
+}
+
 } // namespace ofp
 } // namespace freeflow
\ No newline at end of file
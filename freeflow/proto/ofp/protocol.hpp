@@ -25,6 +25,9 @@
 #include <freeflow/sdn/request.hpp>
 
 #include <freeflow/proto/ofp/ofp.hpp>
+#include <freeflow/proto/ofp/template.hpp>
+#include <freeflow/proto/ofp/transaction.hpp>
+#include <freeflow/proto/ofp/keepalive.hpp>
 
 namespace freeflow {
 
@@ -41,23 +44,33 @@ namespace ofp {
 /// and put message operations are used by the commications protocol
 /// to move data in the reverse direction.
 ///
+/// Bytes read from a connection are framed by put_bytes. Only complete
+/// messages are queued; a partial message at the end of a read is held
+/// by the queue until the rest of it arrives.
+///
 /// \todo The message queue could be made protocol dependent, with the
 /// message interface being the only facility in this namespace.
 ///
 /// \todo Implement error handling.
 struct Message_queue : std::queue<Buffer> {
 
+  bool put_bytes(const Byte*, std::size_t);
   void put_buffer(Buffer&&);
   void get_buffer(Buffer&);
 
   template<typename H, typename P>
     Error put_message(const H&, const P&);
 
+  Buffer& put_template(const Message_template&);
+
   template<typename H>
     Error peek_header(H&);
 
   template<typename H, typename P>
     Error get_payload(const H&, P&);
+
+private:
+  Buffer partial_; // The incomplete message at the end of the stream
 };
 
 
@@ -75,11 +88,19 @@ struct Config {
   /// if the connection is still live.
   Seconds message_timeout = 10_s;
 
+  /// The time between sweeps of the keepalive table. Idle connections
+  /// are detected within this duration of their timeouts.
+  Seconds keepalive_interval = 1_s;
+
   /// The amount of time to wait before determining that a switch
   /// is no longer connected. This duration governs timeout policies
   /// for both handshake messages and echo requests.
   Seconds connection_timeout = 60_s;
 
+  /// The amount of time to wait for the reply to a request (e.g., stats
+  /// or barrier requests) before the request is expired.
+  Seconds request_timeout = 10_s;
+
   /// The default idle timeout for flows.
   Seconds idle_timeout = 5_s;
 
@@ -88,17 +109,28 @@ struct Config {
 };
 
 
-// The Protocol_handler class represents the base class of
-// state machines for specific versions of the protocol.
-//
-// Technically, this is a decoarator.
-//
-// \todo I'm not sure I actually like this design.
-struct Protocol_handler {
-  virtual void to_feature() = 0;
-  virtual void wait_feature() = 0;
+class Protocol;
+
+/// A Dispatch_fn decodes the message at the front of the read queue,
+/// whose header has already been read, and acts on it. The function
+/// must remove the message from the queue. It returns false only when
+/// the connection should be closed.
+using Dispatch_fn = bool (*)(Protocol&, Reactor&, const Header&);
+
+/// A Dispatch_table gives the handler for each message type of a
+/// protocol version. Each version provides a single table, selected
+/// when the version is negotiated, so dispatching a message is an
+/// indexed call. Message types beyond the table are ignored.
+struct Dispatch_table {
+  static constexpr std::size_t size = 32;
+
+  Dispatch_fn handlers[size];
 };
 
+// Dispatch
+Dispatch_fn dispatch(const Dispatch_table&, Uint8);
+bool ignore_message(Protocol&, Reactor&, const Header&);
+
 
 /// The Protocol represents phases of a more general protocol.
 /// OpenFlow defines a number of distinct protocols, each exchanging
@@ -119,7 +151,7 @@ class Protocol {
   };
 
 public:
-  Protocol(Controller*, Event_handler*);
+  Protocol(Controller*, Event_handler*, Keepalive*);
 
   // Network events
   bool on_open(Reactor&);
@@ -136,39 +168,65 @@ public:
   template<typename P>
     Error put_message(const P& p);
 
+  template<typename P>
+    Error put_reply(const Header&, const P& p);
+
+  template<typename P>
+    Error make_template(Message_template&, const P&);
+
+  Buffer& put_template(const Message_template&);
+
   template<typename H>
     Error peek_header(H& h);
 
   template<typename H, typename P>
     Error get_payload(const H&, P& p);
 
+  // Message handling
+  //
+  // These are called by the dispatch tables of each version after a
+  // message has been decoded.
+  bool on_reply(Reactor&, const Header&, bool);
+  bool on_error(Reactor&, const Header&);
+  bool on_packet_in(Reactor&, const Packet&);
+
   // Message queue
   Message_queue read;
   Message_queue write;
 
 private:
   Uint32 xid();
-  Protocol_handler* negotiate(Uint8);
-  bool ping(Reactor&);
+  const Dispatch_table* negotiate(Uint8);
+  bool keepalive(Reactor&);
+  void probe(Reactor&);
+  void expire(Reactor&);
+  bool sweep(Reactor&);
+  void pump(Reactor&);
+  void wake();
+  bool woken(Reactor&);
+  bool poll(Reactor&);
+  void collect(Reactor&);
+
+  template<typename P>
+    Error put_request(Reactor&, const P&, std::shared_ptr<Transaction>);
 
   // Open state and transitions
   bool open_to_hello(Reactor&);
   
   // Initial state and transitions
-  bool hello_recv(Reactor&);
+  bool hello_recv(Reactor&, const Header&);
   bool hello_time(Reactor&);
   bool hello_to_feature(Reactor&);
   bool hello_to_close(Reactor&);
   
   // Discover state and transitions
-  bool feature_recv(Reactor&);
+  bool feature_recv(Reactor&, const Header&);
   bool feature_time(Reactor&);
   bool feature_to_established(Reactor&);
   bool feature_to_close(Reactor&);
 
   // Established state and transitions
-  bool established_recv(Reactor&);
-  bool established_recv_echo(Reactor&);
+  bool established_recv(Reactor&, const Header&);
   bool established_time(Reactor&, int);
   bool established_to_close(Reactor&);
 
@@ -177,17 +235,37 @@ private:
   bool service(Reactor&, const Request&);
   bool on_disconnect(Reactor&, const Request&);
   bool on_terminate(Reactor&, const Request&);
+  bool on_stats(Reactor&, const Request&);
+  bool on_barrier(Reactor&, const Request&);
+  bool on_release(Reactor&, const Request&);
+  void release(Held_packets&);
 
 
   // Internal processing facilities
-  Event_handler*    handler_;
-  Protocol_handler* proto_;
-  Config            config_;
-  State             state_;
+  Event_handler*        handler_;
+  const Dispatch_table* dispatch_; // Handlers for the negotiated version
+  Config                config_;
+  State                 state_;
+
+  Message_template  echo_;    // The echo request sent by probes
+  Message_template  resubmit_; // Resubmits a held packet to the flow table
+  Held_packets      held_;     // Packets released from pending flows
+  Transaction_table txns_; // Outstanding requests
+
+  // The requests of the current stats poll round.
+  using Poll = std::pair<Stats_kind, std::shared_ptr<Transaction>>;
+  std::vector<Poll> polls_;
+
+  Keepalive*    alive_;    // Liveness of all established sessions
+  Keepalive::Id alive_id_; // This session's entry in the keepalive table
 
   Uint32   xid_;       // The curent transaction id
   int      ctime_ = 0; // The connection timeout timer
-  int      mtime_ = 1; // The message timeout timer
+  int      ktime_ = 1; // The keepalive sweep timer, on the host session
+  int      ttime_ = 2; // The transaction expiry timer
+  int      ptime_ = 3; // The stats poll timer
+  int      wtime_ = 4; // Services the switch after a wake
+  bool     awake_ = false; // True if the wake timer is scheduled
 
   // NBI features
   Controller* ctrl_;    // The controller hosting the state machine
@@ -54,12 +54,22 @@ template<typename H, typename P>
     return {};
   }
 
+/// Put a copy of the templated message in the back of the queue, and
+/// return the copy so that its fields can be patched.
+inline Buffer&
+Message_queue::put_template(const Message_template& t) {
+  push(t.buffer());
+  return back();
+}
+
 /// Read a header from the front of the queue, but do not
 /// remove the buffer.
 template<typename H>
   inline Error 
   Message_queue::peek_header(H& h) {
     Buffer& buf = front();
+    if (buf.size() < bytes(h))
+      return make_error_code(std::errc::message_size);
     Byte* p1 = buf.data();
     Byte* p2 = buf.data() + bytes(h);
 
@@ -72,7 +82,7 @@ template<typename H, typename P>
   Message_queue::get_payload(const H& h, P& p) {
     Buffer& buf = front();
     Byte* p1 = buf.data() + bytes(h);
-    Byte* p2 = buf.data() + buf.size() - bytes(h);
+    Byte* p2 = buf.data() + buf.size();
 
     View v(buf, p1, p2);
     Error err = from_view(v, p);
@@ -80,13 +90,29 @@ template<typename H, typename P>
     return err;
   }
 
+// -------------------------------------------------------------------------- //
+// Dispatch
+
+/// Returns the handler for the message type t.
+inline Dispatch_fn
+dispatch(const Dispatch_table& tab, Uint8 t) {
+  return t < Dispatch_table::size ? tab.handlers[t] : ignore_message;
+}
+
+/// Discard the message at the front of the read queue.
+inline bool
+ignore_message(Protocol& p, Reactor&, const Header&) {
+  p.read.pop();
+  return true;
+}
+
 // -------------------------------------------------------------------------- //
 // Protocol
 
 inline
-Protocol::Protocol(Controller* c, Event_handler* h)
-  : handler_(h), proto_(nullptr), config_(), state_(CLOSED)
-  , ctrl_(c), switch_(nullptr)
+Protocol::Protocol(Controller* c, Event_handler* h, Keepalive* k)
+  : handler_(h), dispatch_(nullptr), config_(), state_(CLOSED)
+  , alive_(k), alive_id_(0), xid_(0), ctrl_(c), switch_(nullptr)
 { }
 
 /// Create a message and put it into the message queue.
@@ -99,6 +125,58 @@ template<typename P>
     return write.put_message(h, p); 
   }
 
+/// Create a request, put it into the message queue, and record its
+/// transaction. The transaction expires if no reply is received within
+/// the request timeout. The expiry timer runs only while transactions
+/// are outstanding.
+template<typename P>
+  inline Error
+  Protocol::put_request(Reactor& r, const P& p, std::shared_ptr<Transaction> t) {
+    Uint32 x = xid();
+    Header h {
+      switch_->protocol_version(), P::Kind, Uint16(bytes(h) + bytes(p)), x
+    };
+    if (Trap err = write.put_message(h, p))
+      return err.code();
+
+    if (txns_.empty())
+      r.schedule_timer(handler_, ttime_, config_.request_timeout);
+    txns_.insert(x, now() + config_.request_timeout, std::move(t));
+    return {};
+  }
+
+/// Create a reply to the request whose header is given and put it into
+/// the message queue. The reply has the same xid as the request.
+template<typename P>
+  inline Error 
+  Protocol::put_reply(const Header& req, const P& p) {
+    Header h {
+      switch_->protocol_version(), P::Kind, Uint16(bytes(h) + bytes(p)), req.xid
+    };
+    return write.put_message(h, p); 
+  }
+
+/// Encode the message into a template. The xid of the templated message
+/// is assigned each time it is put into the queue.
+template<typename P>
+  inline Error 
+  Protocol::make_template(Message_template& t, const P& p) {
+    Header h {
+      switch_->protocol_version(), P::Kind, Uint16(bytes(h) + bytes(p)), 0
+    };
+    return t.encode(h, p);
+  }
+
+/// Put a message from the template into the message queue, assigning
+/// it the next xid. The returned buffer can be patched further before
+/// the message is sent.
+inline Buffer&
+Protocol::put_template(const Message_template& t) {
+  Buffer& buf = write.put_template(t);
+  patch(buf, header_xid, xid());
+  return buf;
+}
+
 /// Read the header of the message at the top of the queue.
 template<typename H>
   inline Error 
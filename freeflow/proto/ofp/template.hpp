@@ -0,0 +1,86 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_OFP_TEMPLATE_HPP
+#define FREEFLOW_OFP_TEMPLATE_HPP
+
+#include <cassert>
+
+#include <freeflow/sys/error.hpp>
+#include <freeflow/sys/buffer.hpp>
+#include <freeflow/proto/ofp/ofp.hpp>
+#include <freeflow/proto/ofp/layout.hpp>
+
+/// \file template.hpp
+/// Pre-encoded messages with patchable fields.
+///
+/// Many messages sent by the controller differ only in a few fields:
+/// the xid of an echo or barrier request, or the port and addresses of
+/// a per-host flow mod. A Message_template holds a fully encoded message.
+/// Sending a message from a template copies its bytes and overwrites the
+/// fields that differ, bypassing the usual bytes() and to_view() steps.
+///
+/// Fields are identified by patch points, which are typed offsets into
+/// the encoded message. Version-specific patch points are defined
+/// alongside the messages of each protocol version.
+
+namespace freeflow {
+namespace ofp {
+
+/// A Patch identifies a field of type T at a fixed offset within an
+/// encoded message. The field is written using Wire<T>.
+template<typename T>
+  struct Patch {
+    std::size_t offset;
+  };
+
+/// The transaction id of every OpenFlow message.
+constexpr Patch<Uint32> header_xid { 4 };
+
+/// The length of every OpenFlow message.
+constexpr Patch<Uint16> header_length { 2 };
+
+/// A message template is an encoded message whose fields can be patched
+/// before it is sent.
+class Message_template {
+public:
+  Message_template() = default;
+
+  // Encoding
+  template<typename H, typename P>
+    Error encode(const H&, const P&);
+
+  // Patching
+  template<typename T>
+    void set(Patch<T>, const T&);
+
+  // Observers
+  bool empty() const;
+  std::size_t size() const;
+  const Buffer& buffer() const;
+
+private:
+  Buffer buf_;
+};
+
+// Patching
+template<typename T>
+  void patch(Buffer&, Patch<T>, const T&);
+
+} // namespace ofp
+} // namespace freeflow
+
+#include <freeflow/proto/ofp/template.ipp>
+
+#endif
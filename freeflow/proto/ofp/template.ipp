@@ -0,0 +1,66 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+namespace ofp {
+
+/// Encode the message comprised of the header h and payload p into the
+/// template. Any previous contents of the template are discarded. If
+/// the message cannot be encoded, the template is left empty.
+template<typename H, typename P>
+  Error
+  Message_template::encode(const H& h, const P& p) {
+    buf_.assign(bytes(h) + bytes(p), 0);
+
+    View v(buf_);
+    if (Trap err = to_view(v, h)) {
+      buf_.clear();
+      return err.code();
+    }
+    if (Trap err = to_view(v, p)) {
+      buf_.clear();
+      return err.code();
+    }
+    return {};
+  }
+
+/// Overwrite the field at the patch point in the template. This affects
+/// all messages subsequently sent from the template.
+template<typename T>
+  inline void
+  Message_template::set(Patch<T> f, const T& x) { patch(buf_, f, x); }
+
+/// Returns true if the template holds no message.
+inline bool
+Message_template::empty() const { return buf_.empty(); }
+
+/// Returns the number of bytes in the encoded message.
+inline std::size_t
+Message_template::size() const { return buf_.size(); }
+
+/// Returns the encoded message.
+inline const Buffer&
+Message_template::buffer() const { return buf_; }
+
+/// Overwrite the field at the patch point in the encoded message b.
+/// Behavior is undefined if the field does not lie within b.
+template<typename T>
+  inline void
+  patch(Buffer& b, Patch<T> f, const T& x) {
+    assert(f.offset + Wire<T>::size <= b.size());
+    Wire<T>::store(b.data() + f.offset, x);
+  }
+
+} // namespace ofp
+} // namespace freeflow
@@ -0,0 +1,179 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+#include <cassert>
+
+#include "transaction.hpp"
+
+namespace freeflow {
+namespace ofp {
+
+namespace {
+
+// Returns the base 2 logarithm of the smallest power of 2 not less than
+// n, with a minimum of 8 slots.
+inline unsigned
+log2_ceil(std::size_t n) {
+  unsigned k = 3;
+  while ((std::size_t(1) << k) < n)
+    ++k;
+  return k;
+}
+
+} // namespace
+
+/// Initialize the table with room for at least n slots.
+Transaction_table::Transaction_table(std::size_t n)
+  : slots_(std::size_t(1) << log2_ceil(n))
+  , size_(0)
+  , shift_(32 - log2_ceil(n))
+  , next_(Time_point::max())
+{ }
+
+/// Record the transaction txn with xid x and the given deadline. Returns
+/// false if a transaction with the same xid is already outstanding.
+bool
+Transaction_table::insert(Uint32 x, Time_point d, Pointer txn) {
+  assert(txn);
+  if (lookup(x) != std::size_t(-1))
+    return false;
+
+  // Keep the load factor at or below 1/2.
+  if (2 * (size_ + 1) > slots_.size())
+    rehash(2 * slots_.size());
+
+  place(Entry{x, d, std::move(txn)});
+  ++size_;
+  next_ = std::min(next_, d);
+  return true;
+}
+
+/// Remove the transaction with xid x from the table, returning it. If
+/// there is no such transaction, the result is null.
+Transaction_table::Pointer
+Transaction_table::take(Uint32 x) {
+  std::size_t i = lookup(x);
+  if (i == std::size_t(-1))
+    return nullptr;
+  Pointer p = std::move(slots_[i].txn);
+  erase(i);
+  return p;
+}
+
+/// Expire all transactions whose deadlines are not after t, and remove
+/// them from the table. Returns the number of expired transactions.
+///
+/// The sweep is a single pass over the slots when any transaction is
+/// due, and constant time otherwise. Transactions are notified after
+/// the table has been rebuilt.
+std::size_t
+Transaction_table::expire(Time_point t) {
+  if (t < next_)
+    return 0;
+
+  std::vector<Pointer> expired;
+  std::vector<Entry> slots(slots_.size());
+  slots.swap(slots_);
+  size_ = 0;
+  next_ = Time_point::max();
+  for (Entry& e : slots) {
+    if (not e.txn)
+      continue;
+    if (e.deadline <= t) {
+      expired.push_back(std::move(e.txn));
+    } else {
+      next_ = std::min(next_, e.deadline);
+      place(std::move(e));
+      ++size_;
+    }
+  }
+
+  for (Pointer& p : expired)
+    p->expire();
+  return expired.size();
+}
+
+/// Remove all transactions from the table without expiring them.
+void
+Transaction_table::clear() {
+  for (Entry& e : slots_)
+    e.txn = nullptr;
+  size_ = 0;
+  next_ = Time_point::max();
+}
+
+// Returns the slot holding the xid, or -1 if it is not in the table.
+std::size_t
+Transaction_table::lookup(Uint32 x) const {
+  const std::size_t mask = slots_.size() - 1;
+  for (std::size_t i = home(x); slots_[i].txn; i = (i + 1) & mask)
+    if (slots_[i].xid == x)
+      return i;
+  return -1;
+}
+
+// Move the entry into the first free slot of its probe sequence.
+void
+Transaction_table::place(Entry&& e) {
+  const std::size_t mask = slots_.size() - 1;
+  std::size_t i = home(e.xid);
+  while (slots_[i].txn)
+    i = (i + 1) & mask;
+  slots_[i] = std::move(e);
+}
+
+// Empty the slot i and shift back any following entries that would
+// otherwise become unreachable.
+void
+Transaction_table::erase(std::size_t i) {
+  const std::size_t mask = slots_.size() - 1;
+  slots_[i].txn = nullptr;
+  --size_;
+
+  std::size_t j = i;
+  while (true) {
+    j = (j + 1) & mask;
+    if (not slots_[j].txn)
+      break;
+
+    // The entry at j may move to i only if i lies cyclically within
+    // [home, j), i.e., moving it does not place it before its home.
+    std::size_t h = home(slots_[j].xid);
+    if (((j - h) & mask) >= ((j - i) & mask)) {
+      slots_[i] = std::move(slots_[j]);
+      slots_[j].txn = nullptr;
+      i = j;
+    }
+  }
+
+  // The earliest deadline is conservative; it is recomputed by the
+  // next sweep.
+  if (size_ == 0)
+    next_ = Time_point::max();
+}
+
+// Move all entries into a table of n slots.
+void
+Transaction_table::rehash(std::size_t n) {
+  std::vector<Entry> slots(n);
+  slots.swap(slots_);
+  shift_ = 32 - log2_ceil(n);
+  for (Entry& e : slots)
+    if (e.txn)
+      place(std::move(e));
+}
+
+} // namespace ofp
+} // namespace freeflow
@@ -0,0 +1,89 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_OFP_TRANSACTION_HPP
+#define FREEFLOW_OFP_TRANSACTION_HPP
+
+#include <memory>
+#include <vector>
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/time.hpp>
+#include <freeflow/sdn/transaction.hpp>
+
+/// \file transaction.hpp
+/// Tracking of outstanding requests.
+///
+/// Every request that expects a reply (stats, barrier, echo and queue
+/// configuration requests) is recorded in a Transaction_table under its
+/// xid. When a reply arrives, its xid is used to find and complete the
+/// transaction. Each transaction has a deadline, and expired transactions
+/// are reclaimed in bulk by a periodic sweep.
+///
+/// The table uses open addressing with linear probing. Entries are
+/// stored inline in a single array, and deletion shifts later entries
+/// of a probe sequence backwards, so no tombstones accumulate.
+
+namespace freeflow {
+namespace ofp {
+
+/// A Transaction_table maps the xids of outstanding requests to their
+/// transactions and deadlines.
+class Transaction_table {
+public:
+  using Pointer = std::shared_ptr<Transaction>;
+
+  /// An entry in the table. The entry is empty when txn is null.
+  struct Entry {
+    Uint32     xid;
+    Time_point deadline;
+    Pointer    txn;
+  };
+
+  explicit Transaction_table(std::size_t n = 16);
+
+  // Observers
+  bool empty() const;
+  std::size_t size() const;
+  std::size_t capacity() const;
+  Time_point next_deadline() const;
+
+  // Lookup
+  Transaction* find(Uint32) const;
+
+  // Mutators
+  bool insert(Uint32, Time_point, Pointer);
+  Pointer take(Uint32);
+  std::size_t expire(Time_point);
+  void clear();
+
+private:
+  std::size_t home(Uint32) const;
+  std::size_t lookup(Uint32) const;
+  void place(Entry&&);
+  void erase(std::size_t);
+  void rehash(std::size_t);
+
+  std::vector<Entry> slots_;
+  std::size_t        size_;
+  unsigned           shift_; // 32 - log2(capacity)
+  Time_point         next_;  // The earliest deadline
+};
+
+} // namespace ofp
+} // namespace freeflow
+
+#include <freeflow/proto/ofp/transaction.ipp>
+
+#endif
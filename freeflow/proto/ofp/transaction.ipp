@@ -0,0 +1,51 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+namespace ofp {
+
+/// Returns true when no transactions are outstanding.
+inline bool
+Transaction_table::empty() const { return size_ == 0; }
+
+/// Returns the number of outstanding transactions.
+inline std::size_t
+Transaction_table::size() const { return size_; }
+
+/// Returns the number of slots in the table.
+inline std::size_t
+Transaction_table::capacity() const { return slots_.size(); }
+
+/// Returns the earliest deadline of any outstanding transaction, or the
+/// maximum time point if there are none.
+inline Time_point
+Transaction_table::next_deadline() const { return next_; }
+
+/// Returns the transaction with the given xid, or nullptr if there is
+/// no such transaction.
+inline Transaction*
+Transaction_table::find(Uint32 x) const {
+  std::size_t i = lookup(x);
+  return i == std::size_t(-1) ? nullptr : slots_[i].txn.get();
+}
+
+// Returns the preferred slot for the xid. Xids are usually sequential,
+// so they are scattered by Fibonacci hashing.
+inline std::size_t
+Transaction_table::home(Uint32 x) const {
+  return Uint32(x * 0x9e3779b9u) >> shift_;
+}
+
+} // namespace ofp
+} // namespace freeflow
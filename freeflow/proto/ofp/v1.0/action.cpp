@@ -53,63 +53,64 @@ to_view(View& v, const Action_empty& m) { return {}; }
 
 Error
 to_view(View& v, const Action_output& m) {
-  to_view(v, m.port);
-  to_view(v, m.max_len);
+  if (not store(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 to_view(View& v, const Action_enqueue& m) {
-  to_view(v, m.port);
-  pad(v, 6);
-  to_view(v, m.queue);
+  if (not store(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 to_view(View& v, const Action_vlan_vid& m) {
-  to_view(v, m.value);
-  pad(v, 2);
+  if (not store(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 to_view(View& v, const Action_vlan_pcp& m) {
-  to_view(v, m.value);
-  pad(v, 3);
+  if (not store(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 to_view(View& v, const Action_dl_addr& m) {
-  to_view(v, m.addr);
-  pad(v, 6);
+  if (not store(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 to_view(View& v, const Action_nw_addr& m) {
-  to_view(v, m.addr);
+  if (not store(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 to_view(View& v, const Action_nw_tos& m) {
-  to_view(v, m.value);
-  pad(v, 3);
+  if (not store(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 to_view(View& v, const Action_tp_port& m) {
-  to_view(v, m.port);
-  pad(v, 2);
+  if (not store(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 to_view(View& v, const Action_vendor& m) {
-  to_view(v, m.vendor);
+  if (not store(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
@@ -119,8 +120,8 @@ to_view(View& v, const Action_header& m) {
     return make_error_code(errc::bad_action_type);
   if (m.length < bytes(m)) // Required semantic check
     return make_error_code(errc::bad_action_length);
-  to_view(v, m.type);
-  to_view(v, m.length);
+  if (not store(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
@@ -171,70 +172,71 @@ from_view(View& v, Action_empty& m) { return {}; }
 
 Error
 from_view(View& v, Action_output& m) {
-  from_view(v, m.port);
-  from_view(v, m.max_len);
+  if (not load(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 from_view(View& v, Action_enqueue& m) {
-  from_view(v, m.port);
-  pad(v, 6);
-  from_view(v, m.queue);
+  if (not load(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 from_view(View& v, Action_vlan_vid& m) {
-  from_view(v, m.value);
-  pad(v, 2);
+  if (not load(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 from_view(View& v, Action_vlan_pcp& m) {
-  from_view(v, m.value);
-  pad(v, 3);
+  if (not load(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 from_view(View& v, Action_dl_addr& m) {
-  from_view(v, m.addr);
-  pad(v, 6);
+  if (not load(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 from_view(View& v, Action_nw_addr& m) {
-  from_view(v, m.addr);
+  if (not load(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 from_view(View& v, Action_nw_tos& m) {
-  from_view(v, m.value);
-  pad(v, 3);
+  if (not load(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 from_view(View& v, Action_tp_port& m) {
-  from_view(v, m.port);
-  pad(v, 2);
+  if (not load(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 from_view(View& v, Action_vendor& m) {
-  from_view(v, m.vendor);
+  if (not load(v, m))
+    return make_error_code(errc::action_overflow);
   return {};
 }
 
 Error
 from_view(View& v, Action_header& m) {
-  from_view(v, m.type);
-  from_view(v, m.length);
+  if (not load(v, m))
+    return make_error_code(errc::action_overflow);
   if (not is_valid(m.type)) // Required semantic check
     return make_error_code(errc::bad_action_type);
   if (m.length < bytes(m)) // Required semantic check
@@ -265,9 +267,6 @@ from_view(View& v, Action_payload& m, Action_type t) {
 
 Error
 from_view(View& v, Action& m) {
-  if (remaining(v) < bytes(m))
-    return make_error_code(errc::action_overflow);
-
   if (Trap err = from_view(v, m.header))
     return err.code();
 
@@ -18,6 +18,7 @@
 #include <freeflow/sys/error.hpp>
 #include <freeflow/sys/buffer.hpp>
 #include <freeflow/proto/ofp/ofp.hpp>
+#include <freeflow/proto/ofp/layout.hpp>
 #include <freeflow/proto/ofp/v1.0/error.hpp>
 #include <freeflow/proto/ofp/v1.0/port.hpp>
 
@@ -134,11 +135,92 @@ struct Action {
 /// A sequence of actions
 using Action_list = Sequence<Action>;
 
+// -------------------------------------------------------------------------- //
+// Wire layouts
+
+using Action_empty_layout = Layout<>;
+
+using Action_output_layout = Layout<
+  Field<Action_output, Port::Id, &Action_output::port>,
+  Field<Action_output, Uint16, &Action_output::max_len>
+>;
+
+using Action_enqueue_layout = Layout<
+  Field<Action_enqueue, Uint16, &Action_enqueue::port>,
+  Pad<6>,
+  Field<Action_enqueue, Uint32, &Action_enqueue::queue>
+>;
+
+using Action_vlan_vid_layout = Layout<
+  Field<Action_vlan_vid, Uint16, &Action_vlan_vid::value>,
+  Pad<2>
+>;
+
+using Action_vlan_pcp_layout = Layout<
+  Field<Action_vlan_pcp, Uint8, &Action_vlan_pcp::value>,
+  Pad<3>
+>;
+
+using Action_dl_addr_layout = Layout<
+  Field<Action_dl_addr, Mac_addr, &Action_dl_addr::addr>,
+  Pad<6>
+>;
+
+using Action_nw_addr_layout = Layout<
+  Field<Action_nw_addr, Ipv4_addr, &Action_nw_addr::addr>
+>;
+
+using Action_nw_tos_layout = Layout<
+  Field<Action_nw_tos, Uint8, &Action_nw_tos::value>,
+  Pad<3>
+>;
+
+using Action_tp_port_layout = Layout<
+  Field<Action_tp_port, Uint16, &Action_tp_port::port>,
+  Pad<2>
+>;
+
+using Action_vendor_layout = Layout<
+  Field<Action_vendor, Uint32, &Action_vendor::vendor>
+>;
+
+using Action_header_layout = Layout<
+  Field<Action_header, Action_type, &Action_header::type>,
+  Field<Action_header, Uint16, &Action_header::length>
+>;
+
+// Each action, including its header, occupies a multiple of 8 bytes.
+static_assert((4 + Action_output_layout::size) % 8 == 0, "bad action layout");
+static_assert((4 + Action_enqueue_layout::size) % 8 == 0, "bad action layout");
+static_assert((4 + Action_vlan_vid_layout::size) % 8 == 0, "bad action layout");
+static_assert((4 + Action_vlan_pcp_layout::size) % 8 == 0, "bad action layout");
+static_assert((4 + Action_dl_addr_layout::size) % 8 == 0, "bad action layout");
+static_assert((4 + Action_nw_addr_layout::size) % 8 == 0, "bad action layout");
+static_assert((4 + Action_nw_tos_layout::size) % 8 == 0, "bad action layout");
+static_assert((4 + Action_tp_port_layout::size) % 8 == 0, "bad action layout");
+static_assert((4 + Action_vendor_layout::size) % 8 == 0, "bad action layout");
+static_assert(Action_header_layout::size == 4, "bad action layout");
+
+Action_empty_layout wire_layout(const Action_empty&);
+Action_output_layout wire_layout(const Action_output&);
+Action_enqueue_layout wire_layout(const Action_enqueue&);
+Action_vlan_vid_layout wire_layout(const Action_vlan_vid&);
+Action_vlan_pcp_layout wire_layout(const Action_vlan_pcp&);
+Action_dl_addr_layout wire_layout(const Action_dl_addr&);
+Action_nw_addr_layout wire_layout(const Action_nw_addr&);
+Action_nw_tos_layout wire_layout(const Action_nw_tos&);
+Action_tp_port_layout wire_layout(const Action_tp_port&);
+Action_vendor_layout wire_layout(const Action_vendor&);
+Action_header_layout wire_layout(const Action_header&);
+
 
 // Operations
 std::size_t payload_bytes(const Action_header&);
 std::size_t payload_bytes(const Action&);
 
+// Construction
+Action output_action(Uint16 = Port::NONE, Uint16 = 0);
+
 // Protocol
 constexpr std::size_t bytes(const Action_empty&);
 constexpr std::size_t bytes(const Action_output&);
@@ -153,6 +235,7 @@ constexpr std::size_t bytes(const Action_vendor&);
 constexpr std::size_t bytes(const Action_header&);
 std::size_t bytes(const Action_payload&, Action_type);
 std::size_t bytes(const Action&);
+constexpr std::size_t min_bytes(const Action_list&);
 
 Error to_view(View&, const Action_empty&);
 Error to_view(View&, const Action_output&);
@@ -29,41 +29,58 @@ payload_bytes(const Action_header& m) { return m.length - bytes(m); }
 inline std::size_t
 payload_bytes(const Action& m) { return payload_bytes(m.header); }
 
+/// Returns an action that outputs to the port, sending at most max_len
+/// bytes to the controller. Templates use the default port, NONE, as a
+/// placeholder that is patched later.
+inline Action
+output_action(Uint16 port, Uint16 max_len) {
+  Action a;
+  a.header.type = ACTION_OUTPUT;
+  a.header.length = 8;
+  a.payload.output.port = port;
+  a.payload.output.max_len = max_len;
+  return a;
+}
+
 // -------------------------------------------------------------------------- //
 // Bytes
 
 constexpr std::size_t 
-bytes(const Action_empty&) { return 0; }
+bytes(const Action_empty&) { return Wire<Action_empty>::size; }
 
 constexpr std::size_t 
-bytes(const Action_output&) { return 4; }
+bytes(const Action_output&) { return Wire<Action_output>::size; }
 
 constexpr std::size_t 
-bytes(const Action_enqueue&) { return 8; }
+bytes(const Action_enqueue&) { return Wire<Action_enqueue>::size; }
 
 constexpr std::size_t 
-bytes(const Action_vlan_vid&) { return 4; }
+bytes(const Action_vlan_vid&) { return Wire<Action_vlan_vid>::size; }
 
 constexpr std::size_t 
-bytes(const Action_vlan_pcp&) { return 4; }
+bytes(const Action_vlan_pcp&) { return Wire<Action_vlan_pcp>::size; }
 
 constexpr std::size_t 
-bytes(const Action_dl_addr&) { return 8; }
+bytes(const Action_dl_addr&) { return Wire<Action_dl_addr>::size; }
 
 constexpr std::size_t 
-bytes(const Action_nw_addr&) { return 4; }
+bytes(const Action_nw_addr&) { return Wire<Action_nw_addr>::size; }
 
 constexpr std::size_t 
-bytes(const Action_nw_tos&) { return 4; }
+bytes(const Action_nw_tos&) { return Wire<Action_nw_tos>::size; }
 
 constexpr std::size_t 
-bytes(const Action_tp_port&) { return 4; }
+bytes(const Action_tp_port&) { return Wire<Action_tp_port>::size; }
 
 constexpr std::size_t 
-bytes(const Action_vendor&) { return 4; }
+bytes(const Action_vendor&) { return Wire<Action_vendor>::size; }
 
 constexpr std::size_t 
-bytes(const Action_header&) { return 4; }
+bytes(const Action_header&) { return Wire<Action_header>::size; }
+
+/// Every action is at least 8 bytes: a header and a padded payload.
+constexpr std::size_t
+min_bytes(const Action_list&) { return 8; }
 
 inline std::size_t
 bytes(const Action& m) { 
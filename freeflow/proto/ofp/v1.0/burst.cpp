@@ -0,0 +1,108 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include "burst.hpp"
+
+namespace freeflow {
+namespace ofp {
+namespace v1_0 {
+
+/// Returns the number of messages whose headers start in the view
+/// and whose bodies are complete. A message whose header gives a length
+/// shorter than the header is counted so that its decoding fails.
+std::size_t
+count_messages(const View& v) {
+  std::size_t n = 0;
+  const Byte* p = v.first;
+  while (v.last - p >= std::ptrdiff_t(Header_layout::size)) {
+    Uint16 len;
+    Wire<Uint16>::load(p + 2, len);
+    if (len < Header_layout::size)
+      return n + 1;
+    if (v.last - p < len)
+      break;
+    p += len;
+    ++n;
+  }
+  return n;
+}
+
+namespace {
+
+// Decode the payload of m, constrained to the length given in its
+// header. Decoding a payload constructs it, so a payload that fails
+// to decode is destroyed.
+Error
+decode_payload(View& v, Message& m) {
+  if (Constrained_view c = constrain(v, m.header.length - bytes(m.header))) {
+    if (Trap err = from_view(c, m.payload, m.header.type)) {
+      destroy(m.payload, m.header.type);
+      return err.code();
+    }
+  } else {
+    return make_error_code(errc::message_overflow);
+  }
+  return {};
+}
+
+} // namespace
+
+/// Decode every complete message in the view into the burst, replacing
+/// its previous contents. The view is advanced past the decoded
+/// messages. If a message cannot be decoded, the messages preceding it
+/// remain in the burst, the view is left at the start of the failed
+/// message, and the error is returned.
+Error
+Burst::decode(View& v) {
+  release();
+
+  std::size_t n = count_messages(v);
+  if (n == 0)
+    return {};
+
+  void* p = arena_.allocate(n * sizeof(Message), alignof(Message));
+  first_ = static_cast<Message*>(p);
+
+  // Sequences constructed while decoding allocate from the arena.
+  Resource_scope scope(arena_);
+  for (std::size_t i = 0; i < n; ++i) {
+    Byte* start = v.first;
+    Message* m = new (first_ + i) Message();
+    if (Trap err = from_view(v, m->header)) {
+      v.first = start;
+      return err.code();
+    }
+    if (Trap err = decode_payload(v, *m)) {
+      v.first = start;
+      return err.code();
+    }
+    ++size_;
+  }
+  return {};
+}
+
+/// Destroy the messages of the burst and release all memory allocated
+/// for them.
+void
+Burst::release() {
+  for (std::size_t i = 0; i < size_; ++i)
+    destroy(first_[i].payload, first_[i].header.type);
+  first_ = nullptr;
+  size_ = 0;
+  arena_.release();
+}
+
+} // namespace v1_0
+} // namespace ofp
+} // namespace freeflow
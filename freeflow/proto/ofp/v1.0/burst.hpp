@@ -0,0 +1,93 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_OFPV1_0_BURST_HPP
+#define FREEFLOW_OFPV1_0_BURST_HPP
+
+#include <freeflow/sys/arena.hpp>
+#include <freeflow/proto/ofp/v1.0/message.hpp>
+
+/// \file burst.hpp
+/// Decoding of receive bursts.
+///
+/// A single read from a switch connection often returns many messages
+/// (e.g., a flood of packet-ins or a multipart stats reply). The Burst
+/// decodes every complete message in a receive buffer into an array of
+/// messages allocated from an arena. The sequences owned by those
+/// messages (actions, ports, stats entries) are allocated from the same
+/// arena, so decoding requires only a handful of large allocations, and
+/// all of the memory is freed at once when the burst is released.
+///
+///   Burst burst;
+///   if (Trap err = burst.decode(v))
+///     return err.code();
+///   for (Message& m : burst)
+///     dispatch(m);
+///   burst.release();
+///
+/// Any incomplete message at the end of the view is left in the view.
+
+namespace freeflow {
+namespace ofp {
+namespace v1_0 {
+
+/// A Burst is the decoded contents of a receive buffer. The messages of
+/// a burst are valid until the burst is released or destroyed.
+class Burst {
+public:
+  using iterator = Message*;
+  using const_iterator = const Message*;
+
+  explicit Burst(std::size_t n = Arena::default_size);
+  ~Burst();
+
+  // Not copyable
+  Burst(const Burst&) = delete;
+  Burst& operator=(const Burst&) = delete;
+
+  // Decoding
+  Error decode(View&);
+  void release();
+
+  // Observers
+  bool empty() const;
+  std::size_t size() const;
+  const Arena& arena() const;
+
+  // Element access
+  Message& operator[](std::size_t);
+  const Message& operator[](std::size_t) const;
+
+  // Iterators
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
+private:
+  Arena       arena_;
+  Message*    first_; // The decoded messages
+  std::size_t size_;  // The number of decoded messages
+};
+
+// Operations
+std::size_t count_messages(const View&);
+
+} // namespace v1_0
+} // namespace ofp
+} // namespace freeflow
+
+#include <freeflow/proto/ofp/v1.0/burst.ipp>
+
+#endif
@@ -0,0 +1,65 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+namespace ofp {
+namespace v1_0 {
+
+inline
+Burst::Burst(std::size_t n)
+  : arena_(n), first_(nullptr), size_(0)
+{ }
+
+inline
+Burst::~Burst() { release(); }
+
+/// Returns true when the burst contains no messages.
+inline bool
+Burst::empty() const { return size_ == 0; }
+
+/// Returns the number of messages in the burst.
+inline std::size_t
+Burst::size() const { return size_; }
+
+/// Returns the arena from which the burst is allocated.
+inline const Arena&
+Burst::arena() const { return arena_; }
+
+inline Message&
+Burst::operator[](std::size_t n) {
+  assert(n < size_);
+  return first_[n];
+}
+
+inline const Message&
+Burst::operator[](std::size_t n) const {
+  assert(n < size_);
+  return first_[n];
+}
+
+inline Burst::iterator
+Burst::begin() { return first_; }
+
+inline Burst::iterator
+Burst::end() { return first_ + size_; }
+
+inline Burst::const_iterator
+Burst::begin() const { return first_; }
+
+inline Burst::const_iterator
+Burst::end() const { return first_ + size_; }
+
+} // namespace v1_0
+} // namespace ofp
+} // namespace freeflow
@@ -0,0 +1,114 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include "classifier.hpp"
+
+namespace freeflow {
+namespace ofp {
+namespace v1_0 {
+
+constexpr std::size_t Flow_key::size;
+
+namespace {
+
+// The positions of the prefix lengths of network addresses within
+// the wildcards.
+constexpr unsigned nw_src_shift = 8;
+constexpr unsigned nw_dst_shift = 14;
+
+inline Uint64
+pack(const Mac_addr& a) {
+  Uint64 n = 0;
+  for (Uint8 b : a.addr)
+    n = (n << 8) | b;
+  return n;
+}
+
+inline Uint64
+pack(const Ipv4_addr& a) {
+  Uint64 n = 0;
+  for (Uint8 b : a.addr)
+    n = (n << 8) | b;
+  return n;
+}
+
+// Returns the mask of a network address with the n low-order bits
+// wildcarded.
+inline Uint64
+prefix_mask(Uint32 n) { return n >= 32 ? 0 : Uint32(~Uint32(0) << n); }
+
+// Returns the mask m if the field given by the wildcard bit f is matched.
+inline Uint64
+field_mask(Match::Wildcards w, Uint32 f, Uint64 m) { return w & f ? 0 : m; }
+
+} // namespace
+
+/// Returns the key of the fields of the match m. The wildcards of m
+/// are ignored.
+Flow_key
+flow_key(const Match& m) {
+  return {{
+    Uint64(m.in_port) << 48 | pack(m.dl_src),
+    Uint64(m.dl_vlan) << 48 | pack(m.dl_dst),
+    Uint64(m.dl_type) << 48 | Uint64(m.dl_pcp) << 40,
+    pack(m.nw_src) << 32 | pack(m.nw_dst),
+    Uint64(m.nw_proto) << 40 | Uint64(m.nw_tos) << 32
+      | Uint64(m.tp_src) << 16 | Uint64(m.tp_dst)
+  }};
+}
+
+/// Returns the mask of the fields matched by the normalized wildcards w.
+Flow_key
+flow_mask(Match::Wildcards w) {
+  using M = Match;
+  return {{
+    field_mask(w, M::IN_PORT, 0xffffull << 48)
+      | field_mask(w, M::DL_SRC, 0xffffffffffffull),
+    field_mask(w, M::DL_VLAN, 0xffffull << 48)
+      | field_mask(w, M::DL_DST, 0xffffffffffffull),
+    field_mask(w, M::DL_TYPE, 0xffffull << 48)
+      | field_mask(w, M::DL_VLAN_PCP, 0xffull << 40),
+    prefix_mask((w & M::NW_SRC) >> nw_src_shift) << 32
+      | prefix_mask((w & M::NW_DST) >> nw_dst_shift),
+    field_mask(w, M::NW_PROTO, 0xffull << 40)
+      | field_mask(w, M::NW_TOS, 0xffull << 32)
+      | field_mask(w, M::TP_SRC, 0xffffull << 16)
+      | field_mask(w, M::TP_DST, 0xffffull)
+  }};
+}
+
+/// Returns the wildcards w without undefined bits, and with network
+/// address prefixes of 32 or more wildcarded bits written as 32. Matches
+/// with equal normalized wildcards match the same fields.
+Match::Wildcards
+normalize(Match::Wildcards w) {
+  Uint32 n = w & Match::ALL;
+  Uint32 src = std::min<Uint32>((n & Match::NW_SRC) >> nw_src_shift, 32);
+  Uint32 dst = std::min<Uint32>((n & Match::NW_DST) >> nw_dst_shift, 32);
+  n &= ~Uint32(Match::NW_SRC | Match::NW_DST);
+  n |= src << nw_src_shift | dst << nw_dst_shift;
+  return Match::Wildcards(n);
+}
+
+/// Returns true if some packet could match both a and b.
+bool
+overlaps(const Match& a, const Match& b) {
+  Flow_key m = flow_mask(normalize(a.wildcards))
+             & flow_mask(normalize(b.wildcards));
+  return (flow_key(a) & m) == (flow_key(b) & m);
+}
+
+} // namespace v1_0
+} // namespace ofp
+} // namespace freeflow
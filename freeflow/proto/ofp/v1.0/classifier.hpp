@@ -0,0 +1,148 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_OFPV1_0_CLASSIFIER_HPP
+#define FREEFLOW_OFPV1_0_CLASSIFIER_HPP
+
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <freeflow/proto/ofp/v1.0/match.hpp>
+
+/// \file classifier.hpp
+/// Wildcard packet classification over OpenFlow 1.0 matches.
+///
+/// The classifier determines which of a set of prioritized rules
+/// matches a packet, as a switch does when searching its flow table.
+/// Rules are grouped into subtables by the set of fields they match
+/// (their mask). Within a subtable, every rule's fields are masked in
+/// the same way, so matching rules are found with a single hash lookup
+/// of the masked packet. This is tuple space search.
+///
+/// Subtables are searched in order of the highest priority of the rules
+/// they contain, and the search stops once no remaining subtable can
+/// contain a better match. Each subtable also performs a staged lookup:
+/// the masked packet is hashed one protocol layer at a time, and the
+/// lookup ends as soon as the fields of a layer match no rule.
+///
+/// As in OpenFlow 1.0, a rule with no wildcards takes precedence over
+/// all wildcarded rules. Field prerequisites (e.g., that nw_src is only
+/// matched for IP packets) are not applied. Callers should clear the
+/// fields of packets that do not carry them.
+
+namespace freeflow {
+namespace ofp {
+namespace v1_0 {
+
+// -------------------------------------------------------------------------- //
+// Flow keys
+
+/// A Flow_key is the set of fields of a match or packet, packed into
+/// words for masking and hashing. The words are ordered by protocol
+/// layer, and each lookup stage covers a contiguous range of words.
+struct Flow_key {
+  static constexpr std::size_t size = 5;
+
+  struct Hash {
+    std::size_t operator()(const Flow_key&) const;
+  };
+
+  Uint64 words[size];
+};
+
+/// The lookup stages. The ith stage covers the words of a key in the
+/// range [stage_end[i-1], stage_end[i]).
+constexpr std::size_t stages = 3;
+constexpr std::size_t stage_end[stages] = {
+  3, // Switch port and link layer
+  4, // Network layer
+  5, // Transport layer
+};
+
+// Equality comparison
+bool operator==(const Flow_key&, const Flow_key&);
+bool operator!=(const Flow_key&, const Flow_key&);
+
+// Masking
+Flow_key operator&(const Flow_key&, const Flow_key&);
+
+// Hashing
+Uint64 hash_words(const Flow_key&, std::size_t, std::size_t, Uint64);
+
+// Construction
+Flow_key flow_key(const Match&);
+Flow_key flow_mask(Match::Wildcards);
+
+// Wildcards
+Match::Wildcards normalize(Match::Wildcards);
+bool is_exact(Match::Wildcards);
+
+// Overlap
+bool overlaps(const Match&, const Match&);
+
+// -------------------------------------------------------------------------- //
+// Classifier
+
+/// A Classifier associates a value of type T with each of a set of
+/// rules, each comprising a match and a priority. A rule is uniquely
+/// identified by its (normalized) match and priority.
+template<typename T>
+  class Classifier {
+  public:
+    /// A rule in the classifier. The match is normalized.
+    struct Rule {
+      Match  match;
+      Uint16 priority;
+      T      value;
+    };
+
+    Classifier();
+
+    // Observers
+    bool empty() const;
+    std::size_t size() const;
+    std::size_t subtables() const;
+
+    // Classification
+    const Rule* lookup(const Match&) const;
+
+    // Rule management
+    const Rule* find(const Match&, Uint16) const;
+    bool overlaps(const Match&, Uint16) const;
+    bool insert(const Match&, Uint16, const T&);
+    bool remove(const Match&, Uint16);
+    void clear();
+
+  private:
+    struct Subtable;
+
+    Subtable* subtable(Match::Wildcards) const;
+    Subtable& make_subtable(Match::Wildcards);
+    void erase_subtable(Subtable&);
+    void reorder(Subtable&);
+
+    // Subtables in order of decreasing rank.
+    std::vector<std::unique_ptr<Subtable>> tables_;
+    std::size_t                            size_;
+  };
+
+} // namespace v1_0
+} // namespace ofp
+} // namespace freeflow
+
+#include "classifier.ipp"
+
+#endif
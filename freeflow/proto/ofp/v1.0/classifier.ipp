@@ -0,0 +1,380 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+
+namespace freeflow {
+namespace ofp {
+namespace v1_0 {
+
+// -------------------------------------------------------------------------- //
+// Flow keys
+
+inline bool
+operator==(const Flow_key& a, const Flow_key& b) {
+  return std::equal(a.words, a.words + Flow_key::size, b.words);
+}
+
+inline bool
+operator!=(const Flow_key& a, const Flow_key& b) { return not (a == b); }
+
+/// Returns the key a with only the bits of the mask b.
+inline Flow_key
+operator&(const Flow_key& a, const Flow_key& b) {
+  Flow_key k;
+  for (std::size_t i = 0; i < Flow_key::size; ++i)
+    k.words[i] = a.words[i] & b.words[i];
+  return k;
+}
+
+/// Hash the words of k in the range [first, last), continuing from the
+/// hash value h. Hashing a key one stage at a time gives the same value
+/// as hashing the whole key.
+inline Uint64
+hash_words(const Flow_key& k, std::size_t first, std::size_t last, Uint64 h) {
+  for (std::size_t i = first; i < last; ++i) {
+    h = (h ^ k.words[i]) * 0x9e3779b97f4a7c15ull;
+    h ^= h >> 29;
+  }
+  return h;
+}
+
+inline std::size_t
+Flow_key::Hash::operator()(const Flow_key& k) const {
+  return hash_words(k, 0, Flow_key::size, 0);
+}
+
+/// Returns true if the wildcards match every field exactly.
+inline bool
+is_exact(Match::Wildcards w) { return normalize(w) == 0; }
+
+// -------------------------------------------------------------------------- //
+// Subtable
+
+/// A subtable holds the rules with the same wildcards. Rules are stored
+/// under their masked keys. Rules with the same masked key but different
+/// priorities share a bucket, ordered by decreasing priority.
+///
+/// Each stage but the last has a filter, which counts the rules whose
+/// keys hash to a given value over the words up to the end of that
+/// stage. A lookup that misses in a filter cannot match any rule.
+template<typename T>
+  struct Classifier<T>::Subtable {
+    using Bucket = std::vector<Rule>;
+    using Filter = std::unordered_map<Uint64, std::size_t>;
+
+    explicit Subtable(Match::Wildcards);
+
+    Uint32 rank() const;
+    Uint32 rank(Uint16) const;
+
+    bool filter(const Flow_key&) const;
+    void add_filter(const Flow_key&);
+    void remove_filter(const Flow_key&);
+
+    Match::Wildcards              wildcards;
+    Flow_key                      mask;
+    bool                          exact;
+    std::map<Uint16, std::size_t> priorities; // Number of rules by priority
+    Filter                        filters[stages - 1];
+    std::unordered_map<Flow_key, Bucket, Flow_key::Hash> rules;
+  };
+
+template<typename T>
+  inline
+  Classifier<T>::Subtable::Subtable(Match::Wildcards w)
+    : wildcards(w), mask(flow_mask(w)), exact(is_exact(w))
+  { }
+
+/// Returns the rank of the highest priority rule in the subtable.
+template<typename T>
+  inline Uint32
+  Classifier<T>::Subtable::rank() const {
+    return rank(priorities.rbegin()->first);
+  }
+
+/// Returns the rank of a rule with priority p in the subtable. Exact
+/// matches rank above all wildcarded rules.
+template<typename T>
+  inline Uint32
+  Classifier<T>::Subtable::rank(Uint16 p) const {
+    return exact ? 0x10000u | p : p;
+  }
+
+/// Returns true if the masked key k passes the filter of each stage.
+template<typename T>
+  inline bool
+  Classifier<T>::Subtable::filter(const Flow_key& k) const {
+    Uint64 h = 0;
+    std::size_t first = 0;
+    for (std::size_t i = 0; i < stages - 1; ++i) {
+      h = hash_words(k, first, stage_end[i], h);
+      first = stage_end[i];
+      if (not filters[i].count(h))
+        return false;
+    }
+    return true;
+  }
+
+template<typename T>
+  void
+  Classifier<T>::Subtable::add_filter(const Flow_key& k) {
+    Uint64 h = 0;
+    std::size_t first = 0;
+    for (std::size_t i = 0; i < stages - 1; ++i) {
+      h = hash_words(k, first, stage_end[i], h);
+      first = stage_end[i];
+      ++filters[i][h];
+    }
+  }
+
+template<typename T>
+  void
+  Classifier<T>::Subtable::remove_filter(const Flow_key& k) {
+    Uint64 h = 0;
+    std::size_t first = 0;
+    for (std::size_t i = 0; i < stages - 1; ++i) {
+      h = hash_words(k, first, stage_end[i], h);
+      first = stage_end[i];
+      auto iter = filters[i].find(h);
+      if (--iter->second == 0)
+        filters[i].erase(iter);
+    }
+  }
+
+// -------------------------------------------------------------------------- //
+// Classifier
+
+template<typename T>
+  inline
+  Classifier<T>::Classifier() : size_(0) { }
+
+/// Returns true if the classifier has no rules.
+template<typename T>
+  inline bool
+  Classifier<T>::empty() const { return size_ == 0; }
+
+/// Returns the number of rules in the classifier.
+template<typename T>
+  inline std::size_t
+  Classifier<T>::size() const { return size_; }
+
+/// Returns the number of subtables, which is the number of distinct
+/// wildcards among the rules.
+template<typename T>
+  inline std::size_t
+  Classifier<T>::subtables() const { return tables_.size(); }
+
+/// Returns the highest ranked rule matching the packet, whose header
+/// fields are given by the match p. The wildcards of p are ignored.
+/// Returns nullptr if no rule matches.
+template<typename T>
+  const typename Classifier<T>::Rule*
+  Classifier<T>::lookup(const Match& p) const {
+    Flow_key k = flow_key(p);
+    const Rule* best = nullptr;
+    Uint32 rank = 0;
+    for (const auto& t : tables_) {
+      if (best and t->rank() <= rank)
+        break;
+      Flow_key m = k & t->mask;
+      if (not t->filter(m))
+        continue;
+      auto iter = t->rules.find(m);
+      if (iter == t->rules.end())
+        continue;
+      const Rule& r = iter->second.front();
+      if (not best or t->rank(r.priority) > rank) {
+        best = &r;
+        rank = t->rank(r.priority);
+      }
+    }
+    return best;
+  }
+
+/// Returns the rule with exactly the match m and priority p, or nullptr
+/// if there is no such rule.
+template<typename T>
+  const typename Classifier<T>::Rule*
+  Classifier<T>::find(const Match& m, Uint16 p) const {
+    Subtable* t = subtable(normalize(m.wildcards));
+    if (not t)
+      return nullptr;
+    auto iter = t->rules.find(flow_key(m) & t->mask);
+    if (iter == t->rules.end())
+      return nullptr;
+    for (const Rule& r : iter->second)
+      if (r.priority == p)
+        return &r;
+    return nullptr;
+  }
+
+/// Returns true if some packet could match both m and a rule with the
+/// priority p. This is the check required by a flow mod with the
+/// CHECK_OVERLAP flag. Only subtables with rules of priority p are
+/// searched.
+template<typename T>
+  bool
+  Classifier<T>::overlaps(const Match& m, Uint16 p) const {
+    Flow_key mask = flow_mask(normalize(m.wildcards));
+    Flow_key k = flow_key(m) & mask;
+    for (const auto& t : tables_) {
+      if (not t->priorities.count(p))
+        continue;
+      Flow_key common = mask & t->mask;
+      Flow_key kc = k & common;
+      for (const auto& e : t->rules) {
+        if ((e.first & common) != kc)
+          continue;
+        for (const Rule& r : e.second)
+          if (r.priority == p)
+            return true;
+      }
+    }
+    return false;
+  }
+
+/// Insert a rule with the match m and priority p, associating it with
+/// the value x. If the rule already exists, its value is replaced.
+/// Returns true if a new rule was inserted.
+template<typename T>
+  bool
+  Classifier<T>::insert(const Match& m, Uint16 p, const T& x) {
+    Match::Wildcards w = normalize(m.wildcards);
+    Subtable& t = make_subtable(w);
+    Flow_key k = flow_key(m) & t.mask;
+
+    typename Subtable::Bucket& b = t.rules[k];
+    auto iter = std::find_if(b.begin(), b.end(), [p](const Rule& r) {
+      return r.priority <= p;
+    });
+    if (iter != b.end() and iter->priority == p) {
+      iter->value = x;
+      return false;
+    }
+
+    // A new subtable has the lowest rank, which is its position at the
+    // end of the list.
+    Uint32 old = t.priorities.empty() ? 0 : t.rank();
+    Rule r {m, p, x};
+    r.match.wildcards = w;
+    b.insert(iter, std::move(r));
+    t.add_filter(k);
+    ++t.priorities[p];
+    ++size_;
+    if (t.rank() != old)
+      reorder(t);
+    return true;
+  }
+
+/// Remove the rule with exactly the match m and priority p. Returns
+/// false if there is no such rule.
+template<typename T>
+  bool
+  Classifier<T>::remove(const Match& m, Uint16 p) {
+    Subtable* t = subtable(normalize(m.wildcards));
+    if (not t)
+      return false;
+    Flow_key k = flow_key(m) & t->mask;
+    auto i = t->rules.find(k);
+    if (i == t->rules.end())
+      return false;
+
+    typename Subtable::Bucket& b = i->second;
+    auto j = std::find_if(b.begin(), b.end(), [p](const Rule& r) {
+      return r.priority == p;
+    });
+    if (j == b.end())
+      return false;
+
+    b.erase(j);
+    if (b.empty())
+      t->rules.erase(i);
+    t->remove_filter(k);
+    Uint32 old = t->rank();
+    if (--t->priorities[p] == 0)
+      t->priorities.erase(p);
+    --size_;
+
+    if (t->rules.empty())
+      erase_subtable(*t);
+    else if (t->rank() != old)
+      reorder(*t);
+    return true;
+  }
+
+/// Remove all rules.
+template<typename T>
+  inline void
+  Classifier<T>::clear() {
+    tables_.clear();
+    size_ = 0;
+  }
+
+// Returns the subtable for the normalized wildcards w, or nullptr if
+// there are no rules with those wildcards.
+template<typename T>
+  typename Classifier<T>::Subtable*
+  Classifier<T>::subtable(Match::Wildcards w) const {
+    for (const auto& t : tables_)
+      if (t->wildcards == w)
+        return t.get();
+    return nullptr;
+  }
+
+// Returns the subtable for the normalized wildcards w, creating it if
+// needed. A new subtable is placed last, and is moved when its first
+// rule is inserted.
+template<typename T>
+  typename Classifier<T>::Subtable&
+  Classifier<T>::make_subtable(Match::Wildcards w) {
+    if (Subtable* t = subtable(w))
+      return *t;
+    tables_.emplace_back(new Subtable(w));
+    return *tables_.back();
+  }
+
+template<typename T>
+  void
+  Classifier<T>::erase_subtable(Subtable& t) {
+    auto iter = std::find_if(tables_.begin(), tables_.end(),
+      [&t](const std::unique_ptr<Subtable>& p) { return p.get() == &t; });
+    tables_.erase(iter);
+  }
+
+// Subtables are kept in order of decreasing rank so that lookup can
+// stop once no remaining subtable can contain a better match. When the
+// rank of t changes, the other subtables remain ordered, so t is moved
+// to its new position, after any subtables of equal rank.
+template<typename T>
+  void
+  Classifier<T>::reorder(Subtable& t) {
+    auto iter = std::find_if(tables_.begin(), tables_.end(),
+      [&t](const std::unique_ptr<Subtable>& p) { return p.get() == &t; });
+    Uint32 r = t.rank();
+    auto above = [](Uint32 r, const std::unique_ptr<Subtable>& p) {
+      return r > p->rank();
+    };
+    if (iter != tables_.begin() and above(r, *(iter - 1))) {
+      auto pos = std::upper_bound(tables_.begin(), iter, r, above);
+      std::rotate(pos, iter, iter + 1);
+    } else {
+      auto pos = std::upper_bound(iter + 1, tables_.end(), r, above);
+      std::rotate(iter, iter + 1, pos);
+    }
+  }
+
+} // namespace v1_0
+} // namespace ofp
+} // namespace freeflow
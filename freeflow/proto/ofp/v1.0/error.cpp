@@ -55,10 +55,17 @@ Errors::message(int ec) const {
   case errc::queue_config_reply_overflow: return "queue-config-reply overflow";
   case errc::message_overflow: return "message overflow";
 
+  case errc::match_overflow: return "match overflow";
+  case errc::port_overflow: return "port overflow";
+
   case errc::action_overflow: return "action overflow";
   case errc::bad_action_length: return "bad action length";
 
+  case errc::description_stats_overflow: return "description stats overflow";
   case errc::flow_stats_overflow: return "flow stats overflow";
+  case errc::aggregate_stats_overflow: return "aggregate stats overflow";
+  case errc::table_stats_overflow: return "table stats overflow";
+  case errc::port_stats_overflow: return "port stats overflow";
   case errc::queue_stats_overflow: return "queue stats overflow";
   case errc::vendor_stats_overflow: return "vendor stats overflow";
   case errc::bad_flow_stats_length: return "bad flow stats length";
@@ -46,12 +46,19 @@ enum class errc {
   queue_config_request_overflow,
   queue_config_reply_overflow,
 
+  match_overflow,
+  port_overflow,
+
   bad_action_type,
   bad_action_length,
   action_overflow,
 
   bad_stats_type,
+  description_stats_overflow,
   flow_stats_overflow,
+  aggregate_stats_overflow,
+  table_stats_overflow,
+  port_stats_overflow,
   queue_stats_overflow,
   vendor_stats_overflow,
   bad_flow_stats_length,
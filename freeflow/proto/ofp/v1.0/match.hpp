@@ -18,6 +18,7 @@
 #include <freeflow/sys/error.hpp>
 #include <freeflow/sys/buffer.hpp>
 #include <freeflow/proto/ofp/ofp.hpp>
+#include <freeflow/proto/ofp/layout.hpp>
 #include <freeflow/proto/ofp/v1.0/error.hpp>
 
 namespace freeflow {
@@ -39,7 +40,7 @@ struct Match {
     TP_SRC      = 0x00000040, ///< Any IP source port
     TP_DST      = 0x00000080, ///< Any IP target port
     NW_SRC      = 0x00003f00,
-    NW_DST      = 0x000fb000,
+    NW_DST      = 0x000fc000,
     DL_VLAN_PCP = 0x00100000, ///< Any VLAN priority 
     NW_TOS      = 0x00200000, ///< Any IP ToS
     ALL         = 0x003fffff  ///< Anything
@@ -60,6 +61,30 @@ struct Match {
   Uint16    tp_dst;
 };
 
+/// The wire layout of a match. Note that the structure contains
+/// padding after the VLAN priority and the network protocol.
+using Match_layout = Layout<
+  Field<Match, Match::Wildcards, &Match::wildcards>,
+  Field<Match, Uint16, &Match::in_port>,
+  Field<Match, Mac_addr, &Match::dl_src>,
+  Field<Match, Mac_addr, &Match::dl_dst>,
+  Field<Match, Uint16, &Match::dl_vlan>,
+  Field<Match, Uint8, &Match::dl_pcp>,
+  Pad<1>,
+  Field<Match, Uint16, &Match::dl_type>,
+  Field<Match, Uint8, &Match::nw_tos>,
+  Field<Match, Uint8, &Match::nw_proto>,
+  Pad<2>,
+  Field<Match, Ipv4_addr, &Match::nw_src>,
+  Field<Match, Ipv4_addr, &Match::nw_dst>,
+  Field<Match, Uint16, &Match::tp_src>,
+  Field<Match, Uint16, &Match::tp_dst>
+>;
+
+static_assert(Match_layout::size == 40, "bad match layout");
+
+Match_layout wire_layout(const Match&);
+
 // Protocol
 constexpr std::size_t bytes(const Match&);
 Error to_view(View&, const Match&);
@@ -17,7 +17,21 @@ namespace ofp {
 namespace v1_0 {
 
 constexpr std::size_t
-bytes(const Match&) { return 40; }
+bytes(const Match&) { return Wire<Match>::size; }
+
+inline Error
+to_view(View& v, const Match& m) {
+  if (not store(v, m))
+    return make_error_code(errc::match_overflow);
+  return {};
+}
+
+inline Error
+from_view(View& v, Match& m) {
+  if (not load(v, m))
+    return make_error_code(errc::match_overflow);
+  return {};
+}
 
 } // namespace v1_0
 } // namespace ofp
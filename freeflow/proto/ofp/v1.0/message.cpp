@@ -238,18 +238,22 @@ to_view(View& v, const Packet_out& m) {
   if (remaining(v) < bytes(m))
     return make_error_code(errc::packet_out_overflow);
 
-  to_view(v, m.buffer_id);
-  to_view(v, m.port);
-  to_view(v, m.actions_len);
+  if (not store_layout<Packet_out_layout>(v, m))
+    return make_error_code(errc::packet_out_overflow);
   
   if (Constrained_view c = constrain(v, m.actions_len)) {
-    if (Trap err = to_view(v, m.actions))
+    if (Trap err = to_view(c, m.actions))
       return err.code();
   } else {
     return make_error_code(errc::packet_out_overflow);
   }
 
-  to_view(v, m.data);
+  // An actions length that overstates the actions leaves too little
+  // room for the packet data.
+  if (remaining(v) < bytes(m.data))
+    return make_error_code(errc::packet_out_overflow);
+  if (Trap err = to_view(v, m.data))
+    return err.code();
   return {};
 }
 
@@ -257,15 +261,8 @@ Error
 to_view(View& v, const Flow_mod& m) {
   if (remaining(v) < bytes(m))
     return make_error_code(errc::flow_mod_overflow);
-  to_view(v, m.match);
-  to_view(v, m.cookie);
-  to_view(v, m.command);
-  to_view(v, m.idle_timeout);
-  to_view(v, m.hard_timeout);
-  to_view(v, m.priority);
-  to_view(v, m.buffer_id);
-  to_view(v, m.out_port);
-  to_view(v, m.flags);
+  if (not store_layout<Flow_mod_layout>(v, m))
+    return make_error_code(errc::flow_mod_overflow);
   return to_view(v, m.actions);
 }
 
@@ -322,10 +319,8 @@ to_view(View& v, const Header& m) {
     return make_error_code(errc::bad_message_type);
   if (m.length < bytes(m)) // Required semantic check
     return make_error_code(ofp::errc::bad_header_length);
-  to_view(v, m.version);
-  to_view(v, m.type);
-  to_view(v, m.length);
-  to_view(v, m.xid);
+  if (not store(v, m))
+    return make_error_code(errc::message_overflow);
   return {};
 }
 
@@ -474,15 +469,11 @@ from_view(View& v, Port_status& m) {
 
 Error
 from_view(View& v, Packet_out& m) {
-  if (remaining(v) < bytes(m))
+  if (not load_layout<Packet_out_layout>(v, m))
     return make_error_code(errc::packet_out_overflow);
 
-  from_view(v, m.buffer_id);
-  from_view(v, m.port);
-  from_view(v, m.actions_len);
-
   if (Constrained_view c = constrain(v, m.actions_len)) {
-    if (Trap err = from_view(v, m.actions))
+    if (Trap err = from_view(c, m.actions))
       return err.code();
   } else {
     return make_error_code(errc::packet_out_overflow);
@@ -494,17 +485,8 @@ from_view(View& v, Packet_out& m) {
 
 Error
 from_view(View& v, Flow_mod& m) {
-  if (remaining(v) < bytes(m))
+  if (not load_layout<Flow_mod_layout>(v, m))
     return make_error_code(errc::flow_mod_overflow);
-  from_view(v, m.match);
-  from_view(v, m.cookie);
-  from_view(v, m.command);
-  from_view(v, m.idle_timeout);
-  from_view(v, m.hard_timeout);
-  from_view(v, m.priority);
-  from_view(v, m.buffer_id);
-  from_view(v, m.out_port);
-  from_view(v, m.flags);
   return from_view(v, m.actions);
 }
 
@@ -522,7 +504,7 @@ from_view(View& v, Port_mod& m) {
 
 Error
 from_view(View& v, Stats_request& m) {
-  if (remaining(v) < bytes(m))
+  if (remaining(v) < bytes(m.header))
     return make_error_code(errc::stats_request_overflow);
   from_view(v, m.header);
   return from_view(v, m.payload, m.header.type);
@@ -530,7 +512,7 @@ from_view(View& v, Stats_request& m) {
 
 Error
 from_view(View& v, Stats_reply& m) {
-  if (remaining(v) < bytes(m))
+  if (remaining(v) < bytes(m.header))
     return make_error_code(errc::stats_reply_overflow);
   from_view(v, m.header);
   return from_view(v, m.payload, m.header.type);
@@ -555,12 +537,8 @@ from_view(View& v, Queue_config_reply& m) {
 
 Error
 from_view(View& v, Header& m) {
-  if (remaining(v) < bytes(m))
+  if (not load(v, m))
     return make_error_code(errc::message_overflow); // FIXME: not the right code?
-  from_view(v, m.version);
-  from_view(v, m.type);
-  from_view(v, m.length);
-  from_view(v, m.xid);
   if (not is_valid(m.version)) // Optional semantic check
     return make_error_code(errc::bad_version);
   if (not is_valid(m.type)) // Required semantic check
@@ -602,13 +580,15 @@ from_view(View& v, Payload& m, Message_type t) {
 
 Error
 from_view(View& v, Message& m) {
-  if (remaining(v) < bytes(m))
+  if (Trap err = from_view(v, m.header))
+    return err.code();
+
+  // The payload is constrained to the length given in the header so
+  // that trailing sequences do not read into the next message.
+  if (Constrained_view c = constrain(v, m.header.length - bytes(m.header)))
+    return from_view(c, m.payload, m.header.type);
+  else
     return make_error_code(errc::message_overflow);
-
-  from_view(v, m.header);
-
-  // TODO: Constrain the view?
-  return from_view(v, m.payload, m.header.type);
 }
 
 } // namespace v1_0
@@ -18,6 +18,8 @@
 #include <freeflow/sys/error.hpp>
 #include <freeflow/sys/buffer.hpp>
 #include <freeflow/proto/ofp/ofp.hpp>
+#include <freeflow/proto/ofp/layout.hpp>
+#include <freeflow/proto/ofp/template.hpp>
 #include <freeflow/proto/ofp/v1.0/error.hpp>
 #include <freeflow/proto/ofp/v1.0/port.hpp>
 #include <freeflow/proto/ofp/v1.0/queue.hpp>
@@ -327,9 +329,9 @@ struct Flow_mod {
   Match       match;
   Uint64      cookie;
   Command     command;
-  Uint8       idle_timeout;
-  Uint8       hard_timeout;
-  Uint8       priority;
+  Uint16      idle_timeout;
+  Uint16      hard_timeout;
+  Uint16      priority;
   Uint32      buffer_id;
   Port::Id    out_port;
   Flags       flags;
@@ -446,6 +448,134 @@ struct Message {
   Payload payload;
 };
 
+// -------------------------------------------------------------------------- //
+// Wire layouts
+
+using Header_layout = Layout<
+  Field<Header, Version_type, &Header::version>,
+  Field<Header, Message_type, &Header::type>,
+  Field<Header, Uint16, &Header::length>,
+  Field<Header, Uint32, &Header::xid>
+>;
+
+/// The layout of the fixed-size part of a flow mod. The actions follow.
+using Flow_mod_layout = Layout<
+  Field<Flow_mod, Match, &Flow_mod::match>,
+  Field<Flow_mod, Uint64, &Flow_mod::cookie>,
+  Field<Flow_mod, Flow_mod::Command, &Flow_mod::command>,
+  Field<Flow_mod, Uint16, &Flow_mod::idle_timeout>,
+  Field<Flow_mod, Uint16, &Flow_mod::hard_timeout>,
+  Field<Flow_mod, Uint16, &Flow_mod::priority>,
+  Field<Flow_mod, Uint32, &Flow_mod::buffer_id>,
+  Field<Flow_mod, Port::Id, &Flow_mod::out_port>,
+  Field<Flow_mod, Flow_mod::Flags, &Flow_mod::flags>
+>;
+
+/// The layout of the fixed-size part of a packet out. The actions and
+/// packet data follow.
+using Packet_out_layout = Layout<
+  Field<Packet_out, Uint32, &Packet_out::buffer_id>,
+  Field<Packet_out, Port::Id, &Packet_out::port>,
+  Field<Packet_out, Uint16, &Packet_out::actions_len>
+>;
+
+static_assert(Header_layout::size == 8, "bad header layout");
+static_assert(Flow_mod_layout::size == 64, "bad flow mod layout");
+static_assert(Packet_out_layout::size == 8, "bad packet out layout");
+
+Header_layout wire_layout(const Header&);
+
+// -------------------------------------------------------------------------- //
+// Patch points
+//
+// The offsets of frequently varied fields in encoded messages, for use
+// with message templates. Offsets are relative to the start of the
+// message header.
+
+/// Returns the offset of the Ith element of the layout L within an
+/// encoded message.
+template<typename L, std::size_t I>
+  constexpr std::size_t
+  message_offset() { return Header_layout::size + Layout_offset<L, I>::value; }
+
+/// Returns the offset of the Ith element of a match within an encoded
+/// flow mod.
+template<std::size_t I>
+  constexpr std::size_t
+  flow_mod_match_offset() {
+    return message_offset<Flow_mod_layout, 0>() 
+         + Layout_offset<Match_layout, I>::value;
+  }
+
+constexpr Patch<Match::Wildcards> flow_mod_wildcards {
+  flow_mod_match_offset<0>()
+};
+constexpr Patch<Uint16> flow_mod_in_port { flow_mod_match_offset<1>() };
+constexpr Patch<Mac_addr> flow_mod_dl_src { flow_mod_match_offset<2>() };
+constexpr Patch<Mac_addr> flow_mod_dl_dst { flow_mod_match_offset<3>() };
+constexpr Patch<Uint16> flow_mod_dl_vlan { flow_mod_match_offset<4>() };
+constexpr Patch<Uint16> flow_mod_dl_type { flow_mod_match_offset<7>() };
+constexpr Patch<Ipv4_addr> flow_mod_nw_src { flow_mod_match_offset<11>() };
+constexpr Patch<Ipv4_addr> flow_mod_nw_dst { flow_mod_match_offset<12>() };
+constexpr Patch<Uint16> flow_mod_tp_src { flow_mod_match_offset<13>() };
+constexpr Patch<Uint16> flow_mod_tp_dst { flow_mod_match_offset<14>() };
+
+constexpr Patch<Uint64> flow_mod_cookie {
+  message_offset<Flow_mod_layout, 1>()
+};
+constexpr Patch<Uint16> flow_mod_idle_timeout {
+  message_offset<Flow_mod_layout, 3>()
+};
+constexpr Patch<Uint16> flow_mod_hard_timeout {
+  message_offset<Flow_mod_layout, 4>()
+};
+constexpr Patch<Uint16> flow_mod_priority {
+  message_offset<Flow_mod_layout, 5>()
+};
+constexpr Patch<Uint32> flow_mod_buffer_id {
+  message_offset<Flow_mod_layout, 6>()
+};
+constexpr Patch<Port::Id> flow_mod_out_port {
+  message_offset<Flow_mod_layout, 7>()
+};
+
+/// The match of an encoded flow mod.
+constexpr Patch<Match> flow_mod_match { flow_mod_match_offset<0>() };
+
+/// The port of an output action that is the first action of an encoded
+/// flow mod. The actions follow the fixed-size part of the message, and
+/// the port follows the action's type and length.
+constexpr Patch<Port::Id> flow_mod_output_port {
+  Header_layout::size + Flow_mod_layout::size + 4
+};
+
+constexpr Patch<Uint32> packet_out_buffer_id {
+  message_offset<Packet_out_layout, 0>()
+};
+constexpr Patch<Port::Id> packet_out_in_port {
+  message_offset<Packet_out_layout, 1>()
+};
+
+/// The port of an output action that is the first action of an encoded
+/// packet out.
+constexpr Patch<Port::Id> packet_out_output_port {
+  Header_layout::size + Packet_out_layout::size + 4
+};
+
+// -------------------------------------------------------------------------- //
+// Stats reply scanning
+//
+// The entries of port and flow stats replies are read directly from the
+// encoded reply messages. Each entry is loaded into a single object that
+// is reused for the next, so no sequences are allocated. A multipart
+// reply is given as its messages, stored consecutively.
+
+template<typename F>
+  bool scan_port_stats(const Byte*, std::size_t, F);
+
+template<typename F>
+  bool scan_flow_stats(const Byte*, std::size_t, F);
+
 // Operations
 void construct(Payload&, Message_type);
 void destroy(Payload&, Message_type);
@@ -26,7 +26,8 @@ Stats_reply::Stats_reply()
 
 inline
 Stats_reply::~Stats_reply() {
-  destroy(payload, header.type);
+  if (is_valid(header.type))
+    destroy(payload, header.type);
 }
 
 inline
@@ -55,7 +56,7 @@ inline std::size_t
 bytes(const Feature_request& m) { return 0; }
 
 inline std::size_t 
-bytes(const Feature_reply& m) { return 24 + m.ports.size(); }
+bytes(const Feature_reply& m) { return 24 + bytes(m.ports); }
 
 constexpr std::size_t 
 bytes(const Get_config_request&) { return 0; }
@@ -76,10 +77,12 @@ constexpr std::size_t
 bytes(const Port_status& m) { return 8 + bytes(m.port); }
 
 inline std::size_t
-bytes(const Packet_out& m) { return 8 + bytes(m.actions) + bytes(m.data); }
+bytes(const Packet_out& m) { 
+  return Packet_out_layout::size + bytes(m.actions) + bytes(m.data); 
+}
 
 inline std::size_t
-bytes(const Flow_mod& m) { return 24 + bytes(m.match) + bytes(m.actions); }
+bytes(const Flow_mod& m) { return Flow_mod_layout::size + bytes(m.actions); }
 
 constexpr std::size_t
 bytes(const Port_mod& m) { return 24; }
@@ -107,7 +110,7 @@ constexpr std::size_t
 bytes(const Barrier_reply& m) { return 0; }
 
 constexpr std::size_t
-bytes(const Header& m) { return 8; }
+bytes(const Header& m) { return Wire<Header>::size; }
 
 inline std::size_t
 bytes(const Message& m) { 
@@ -148,6 +151,76 @@ from_view(View&, Barrier_request&) { return {}; }
 inline Error
 from_view(View&, Barrier_reply&) { return {}; }
 
+// Stats reply scanning
+
+namespace impl {
+
+// Call f(p, n) with the entries of each stats reply of type t in the n
+// bytes at p. Returns false if the messages are malformed.
+template<typename F>
+  bool
+  scan_stats(const Byte* p, std::size_t n, Stats_type t, F f) {
+    constexpr std::size_t body = Header_layout::size + 4;
+    while (n != 0) {
+      Header h;
+      Uint16 type;
+      if (n < body)
+        return false;
+      Header_layout::load(p, h);
+      Wire<Uint16>::load(p + Header_layout::size, type);
+      if (h.length < body or h.length > n)
+        return false;
+      if (h.type == STATS_REPLY and type == t)
+        if (not f(p + body, h.length - body))
+          return false;
+      p += h.length;
+      n -= h.length;
+    }
+    return true;
+  }
+
+} // namespace impl
+
+/// Call f(e) with each entry of the port stats replies in the n bytes at
+/// p. Messages of other types are skipped. Returns false if the replies
+/// are malformed.
+template<typename F>
+  bool
+  scan_port_stats(const Byte* p, std::size_t n, F f) {
+    using L = Port_stats_entry_layout;
+    return impl::scan_stats(p, n, STATS_PORT, 
+      [&f](const Byte* q, std::size_t m) {
+        Port_stats_entry e;
+        for (; m >= L::size; q += L::size, m -= L::size) {
+          L::load(q, e);
+          f(e);
+        }
+        return m == 0;
+      });
+  }
+
+/// Call f(e) with each entry of the flow stats replies in the n bytes at
+/// p. The actions of the entries are not decoded. Returns false if the
+/// replies are malformed.
+template<typename F>
+  bool
+  scan_flow_stats(const Byte* p, std::size_t n, F f) {
+    using L = Flow_stats_entry_layout;
+    return impl::scan_stats(p, n, STATS_FLOW, 
+      [&f](const Byte* q, std::size_t m) {
+        Flow_stats_entry e;
+        while (m >= L::size) {
+          L::load(q, e);
+          if (e.length < L::size or e.length > m)
+            return false;
+          f(e);
+          q += e.length;
+          m -= e.length;
+        }
+        return m == 0;
+      });
+  }
+
 // Validation
 
 constexpr bool
@@ -18,6 +18,7 @@
 #include <freeflow/sys/error.hpp>
 #include <freeflow/sys/buffer.hpp>
 #include <freeflow/proto/ofp/ofp.hpp>
+#include <freeflow/proto/ofp/layout.hpp>
 #include <freeflow/proto/ofp/v1.0/error.hpp>
 
 namespace freeflow {
@@ -91,6 +92,23 @@ struct Port {
   Features   peer;
 };
 
+/// The wire layout of a port.
+using Port_layout = Layout<
+  Field<Port, Port::Id, &Port::port_id>,
+  Field<Port, Mac_addr, &Port::hw_addr>,
+  Field<Port, String<16>, &Port::name>,
+  Field<Port, Port::Config, &Port::config>,
+  Field<Port, Port::State, &Port::state>,
+  Field<Port, Port::Features, &Port::current>,
+  Field<Port, Port::Features, &Port::advertised>,
+  Field<Port, Port::Features, &Port::supported>,
+  Field<Port, Port::Features, &Port::peer>
+>;
+
+static_assert(Port_layout::size == 48, "bad port layout");
+
+Port_layout wire_layout(const Port&);
+
 /// A sequence of ports
 using Port_list = Sequence<Port>;
 
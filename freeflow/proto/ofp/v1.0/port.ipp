@@ -17,7 +17,21 @@ namespace ofp {
 namespace v1_0 {
 
 constexpr std::size_t
-bytes(const Port&) { return 48; }
+bytes(const Port&) { return Wire<Port>::size; }
+
+inline Error
+to_view(View& v, const Port& p) {
+  if (not store(v, p))
+    return make_error_code(errc::port_overflow);
+  return {};
+}
+
+inline Error
+from_view(View& v, Port& p) {
+  if (not load(v, p))
+    return make_error_code(errc::port_overflow);
+  return {};
+}
 
 } // namespace v1_0
 } // namespace ofp
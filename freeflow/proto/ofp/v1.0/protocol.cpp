@@ -12,37 +12,221 @@
 // or implied. See the License for the specific language governing
 // permissions and limitations under the License.
 
+#include <freeflow/sdn/packet.hpp>
 #include <freeflow/proto/ofp/v1.0/protocol.hpp>
 
 namespace freeflow {
 namespace ofp {
 namespace v1_0 {
 
-void 
-Handler::to_feature() {
-  // Empty p;
-  // Header h(FEATURE_REQUEST, bytes(p), 0);
-  // put_message(h, p);
+namespace {
+
+// Respond to an echo request with the same data.
+bool
+on_echo_request(Protocol& p, Reactor&, const ofp::Header& h) {
+  Echo_request req;
+  if (not p.get_payload(h, req))
+    return false;
+  Echo_reply rep;
+  rep.data = std::move(req.data);
+  p.put_reply(h, rep);
+  return true;
+}
+
+// Errors that fail a transaction.
+bool
+on_error(Protocol& p, Reactor& r, const ofp::Header& h) {
+  return p.on_error(r, h);
+}
+
+// Replies that complete a transaction.
+bool
+on_reply(Protocol& p, Reactor& r, const ofp::Header& h) {
+  return p.on_reply(r, h, false);
+}
+
+// A stats reply with the REPLY_MORE flag is continued in the next
+// stats reply with the same xid.
+bool
+on_stats_reply(Protocol& p, Reactor& r, const ofp::Header& h) {
+  const Buffer& b = p.read.front();
+  bool more = b.size() >= 12 and (b[11] & 0x01);
+  return p.on_reply(r, h, more);
+}
+
+// The frame of a packet-in is parsed in place. It follows the header,
+// buffer id, total length, input port, reason and a byte of padding.
+bool
+on_packet_in(Protocol& p, Reactor& r, const ofp::Header& h) {
+  const Buffer& b = p.read.front();
+  if (b.size() < 18)
+    return ignore_message(p, r, h);
+  const Byte* m = b.data() + Header_layout::size;
+  Uint32 buf;
+  Uint16 port;
+  Wire<Uint32>::load(m, buf);
+  Wire<Uint16>::load(m + 6, port);
+  return p.on_packet_in(r, Packet(m + 10, b.size() - 18, port, buf));
 }
 
-void 
-Handler::wait_feature() {
-  // Header h;
-  // peek_header(h);
+constexpr Dispatch_fn ignore = ignore_message;
+
+// The table is indexed by message type.
+constexpr Dispatch_table table_ {{
+  ignore,          // HELLO
+  on_error,        // ERROR
+  on_echo_request, // ECHO_REQUEST
+  on_reply,        // ECHO_REPLY
+  ignore,          // VENDOR
+  ignore,          // FEATURE_REQUEST
+  ignore,          // FEATURE_REPLY
+  ignore,          // GET_CONFIG_REQUEST
+  ignore,          // GET_CONFIG_REPLY
+  ignore,          // SET_CONFIG
+  on_packet_in,    // PACKET_IN
+  ignore,          // FLOW_REMOVED
+  ignore,          // PORT_STATUS
+  ignore,          // PACKET_OUT
+  ignore,          // FLOW_MOD
+  ignore,          // PORT_MOD
+  ignore,          // STATS_REQUEST
+  on_stats_reply,  // STATS_REPLY
+  ignore,          // BARRIER_REQUEST
+  on_reply,        // BARRIER_REPLY
+  ignore,          // QUEUE_GET_CONFIG_REQUEST
+  on_reply,        // QUEUE_GET_CONFIG_REPLY
+  ignore, ignore, ignore, ignore, ignore, ignore, ignore, ignore, ignore, ignore
+}};
+
+// Copy the hardware address of a port.
+inline void 
+set_mac_addr(freeflow::Mac_addr& a, const ofp::Mac_addr& b) {
+  for (int i=0; i < 6; ++i) 
+    a.addr[i] = b.addr[i];
+}
+
+inline bool
+get_bit(int number, int n) { return (number & (1 << n)) >> n; }
+
+void
+features_config(freeflow::Port::Features& to, const Port::Features& from) {
+  using P = freeflow::Port;
+
+  // 10 MB half duplex
+  if (get_bit(from, 0)) {
+    to.speed = 10000;
+    to.mode  = P::HALF_DUPLEX;
+  }
+
+  // 10 MB full duplex
+  else if (get_bit(from, 1)) {
+    to.speed = 10000;
+    to.mode  = P::FULL_DUPLEX;
+  }
+
+  // 100 MB half dulex
+  else if (get_bit(from, 2)) {
+    to.speed = 100000; 
+    to.mode  = P::HALF_DUPLEX;
+  }
 
-  // // FIXME: Error handling.
-  // if (h.type != FEATURE_REPLY) {
-  //   return;
-  // }
+  // 100 MB full dulex
+  else if (get_bit(from, 3)) {
+    to.speed = 100000;
+    to.mode  = P::FULL_DUPLEX;
+  }
   
-  // // Get the feature... and do what?
-  // Feature m;
-  // get_payload(h, m);
+  // 1 GB half dulex
+  else if (get_bit(from, 4)) {
+    to.speed = 1000000;
+    to.mode  = P::HALF_DUPLEX;
+  }
+  
+  // 1 GB full dulex
+  else if (get_bit(from, 5)) {
+    to.speed = 1000000;
+    to.mode  = P::FULL_DUPLEX;
+  }
+
+  // 10 GB full duplex
+  else if (get_bit(from, 6)) {
+    to.speed = 10000000;
+    to.mode  = P::FULL_DUPLEX;
+  }
+
+  // else error? v1.3 uses max_speed or curr_speed but v1.0 doesn't have them
+
+  // Copper medium
+  if (get_bit(from, 7)) 
+    to.medium = P::COPPER;
+
+  // Fiber medium
+  else if (get_bit(from, 8))
+    to.medium = P::FIBER;
+
+  // else error? is this data necessary enough to warrant an error?
+
+  to.auto_neg   = get_bit(from, 9);
+  to.pause      = get_bit(from, 10);
+  to.pause_asym = get_bit(from, 11);
+}
 
-  // proto_.to_established();
+freeflow::Match
+match_config(const Capabilities& caps) {
+  using F = Match_field;
+  freeflow::Match m {
+    F::IN_PORT, F::ETH_SRC, F::ETH_DST, F::VLAN_ID, F::VLAN_PCP, F::ETH_TYPE,
+    F::IPV4_TOS, F::IPV4_PROTOCOL, F::IPV4_SRC, F::IPV4_SRC_MASK, 
+    F::IPV4_DST, F::IPV4_DST_MASK, F::TCP_SRC, F::TCP_DST, F::UDP_SRC, 
+    F::UDP_DST, F::ICMPV4_TYPE, F::ICMPV4_CODE
+  };
+  if (caps.test(Capability::ARP_MATCH_IP)) {
+    m.set(F::ARP_OPCODE);
+    m.set(F::ARP_SPA);
+    m.set(F::ARP_TPA);
+  }
+  return m;
+}
+
+} // namespace
+
+const Dispatch_table&
+dispatch_table() { return table_; }
+
+/// Configure the datapath from the switch's feature reply.
+void
+datapath_config(Datapath& dp, const Feature_reply& r) {
+  // Configure datapath members
+  dp.datapath_id  = r.datapath_id;
+  dp.capabilities = Capabilities(r.capabilities);
+  dp.actions      = freeflow::Action(r.actions);
+  dp.match        = match_config(dp.capabilities);
+
+  // Configure Ports
+  // TODO: many fields still need to be set... this is NOT done yet.. at all
+  // TODO: set up Port_stats table (map). Should a Stats_req be sent to do this?
+  // if (has_capability(dp, Capability::PORT_STATS)) // set up Port_stats
+  for (const Port& port : r.ports) {
+    freeflow::Port p;
+    p.port_number = port.port_id;
+    set_mac_addr(p.hw_addr, port.hw_addr);
+    p.name = Symbol(port.name.str());
+    features_config(p.current, port.current);
+    features_config(p.advertised, port.advertised);
+    features_config(p.supported, port.supported);
+    features_config(p.peer, port.peer);
+    // TODO: set up Queues before inserting the port
+    dp.ports.insert(p);
+
+    freeflow::Port_status& st = *dp.ports.status(p.port_number);
+    st.config = port.config;
+    st.state = port.state;
+  }
+
+  // Configure Flow_tables
+  // TODO: actually configure the tables...
 }
 
 } // namespace v1_0
 } // namespace ofp
 } // namespace freeflow
-
@@ -15,40 +15,21 @@
 #ifndef FREEFLOW_OFPV1_0_PROTOCOL_HPP
 #define FREEFLOW_OFPV1_0_PROTOCOL_HPP
 
+#include <freeflow/proto/ofp/protocol.hpp>
 #include <freeflow/proto/ofp/v1.0/message.hpp>
 
 namespace freeflow {
 namespace ofp {
 namespace v1_0 {
 
-/// The Handler class is responsible for the transacting the version
-/// specific aspects of the OpenFlow protocol.
-struct Handler : ofp::Protocol_handler {
-  Handler(Protocol& p) 
-    : proto_(p) 
-  { }
+/// Returns the table of message handlers for OpenFlow 1.0 sessions.
+const Dispatch_table& dispatch_table();
 
-  // Read/write helper functions
-  template<typename H, typename P>
-    void put_message(const H& h, const P& p) { proto_.put_message(h, p); }
-
-  template<typename H>
-    void peek_header(H& h) { proto_.peek_header(h); }
-
-  template<typename H, typename P>
-    void get_payload(const H& h, P& p) { proto_.get_payload(h, p); }
-
-  // Events and messages
-  void to_feature();
-  void wait_feature();
-
-
-  Protocol& proto_;
-};
+// Feature discovery
+void datapath_config(Datapath&, const Feature_reply&);
 
 } // namespace v1_0
 } // namespace ofp
 } // namespace freeflow
 
 #endif
-
@@ -74,6 +74,8 @@ constexpr std::size_t bytes(const Rate_property&);
 std::size_t bytes(const Property_value&, Property_type);
 std::size_t bytes(const Property&);
 std::size_t bytes(const Queue&);
+constexpr std::size_t min_bytes(const Property_list&);
+constexpr std::size_t min_bytes(const Queue_list&);
 
 // To view
 Error to_view(View&, const Rate_property&);
@@ -32,6 +32,13 @@ bytes(const Property& m) { return 8 + bytes(m.value, m.property); }
 inline std::size_t 
 bytes(const Queue& m) { return 8 + bytes(m.properties); }
 
+/// Properties and queues are at least as large as their headers.
+constexpr std::size_t
+min_bytes(const Property_list&) { return 8; }
+
+constexpr std::size_t
+min_bytes(const Queue_list&) { return 8; }
+
 // Validation
 
 constexpr bool
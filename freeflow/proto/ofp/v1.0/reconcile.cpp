@@ -0,0 +1,136 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "reconcile.hpp"
+
+namespace freeflow {
+namespace ofp {
+namespace v1_0 {
+
+namespace {
+
+// Returns a flow mod with the given command for the rule r.
+Flow_mod
+make_flow_mod(const Flow_rule& r, Flow_mod::Command c) {
+  Flow_mod m;
+  m.match = r.match;
+  m.cookie = r.cookie;
+  m.command = c;
+  m.idle_timeout = r.idle_timeout;
+  m.hard_timeout = r.hard_timeout;
+  m.priority = r.priority;
+  m.buffer_id = 0xffffffff;
+  m.out_port = Port::NONE;
+  m.flags = r.flags;
+  m.actions = r.actions;
+  return m;
+}
+
+// Returns a flow mod that deletes exactly the flow e.
+Flow_mod
+make_delete(const Flow_stats_entry& e) {
+  Flow_mod m;
+  m.match = e.match;
+  m.cookie = e.cookie;
+  m.command = Flow_mod::DELETE_STRICT;
+  m.idle_timeout = 0;
+  m.hard_timeout = 0;
+  m.priority = e.priority;
+  m.buffer_id = 0xffffffff;
+  m.out_port = Port::NONE;
+  m.flags = Flow_mod::Flags(0);
+  return m;
+}
+
+} // namespace
+
+/// Returns true if the action lists have the same encoding.
+bool
+equal_actions(const Action_list& a, const Action_list& b) {
+  std::size_t n = bytes(a);
+  if (n != bytes(b))
+    return false;
+  Buffer ba(n);
+  Buffer bb(n);
+  View va(ba);
+  View vb(bb);
+  if (not to_view(va, a) or not to_view(vb, b))
+    return false;
+  return std::equal(ba.begin(), ba.end(), bb.begin());
+}
+
+/// Compute the flow mods that transform the installed flows into the
+/// desired rules, appending them to out.
+///
+/// Flows are identified by their match, priority and cookie. A desired
+/// rule that is installed with different actions is modified in place,
+/// preserving its counters. One installed with different timeouts is
+/// re-added, since modification does not change timeouts. Missing rules
+/// are added, and installed flows that are not desired are deleted.
+///
+/// Deletions are emitted first, freeing table space for additions. An
+/// installed flow whose match and priority are desired with a different
+/// cookie is not deleted, since adding the desired rule replaces it.
+void
+reconcile(const Flow_rules& want, const Flow_stats& have, std::vector<Flow_mod>& out) {
+  using Key = Flow_rule_key;
+  using Hash = Flow_rule_key::Hash;
+
+  // Index the installed flows.
+  std::unordered_map<Key, const Flow_stats_entry*, Hash> installed;
+  installed.reserve(have.size());
+  for (const Flow_stats_entry& e : have)
+    installed.emplace(flow_rule_key(e), &e);
+
+  // Index the desired rules, both with and without their cookies.
+  std::unordered_set<Key, Hash> desired;
+  std::unordered_set<Key, Hash> replaced;
+  desired.reserve(want.size());
+  replaced.reserve(want.size());
+  for (const Flow_rule& r : want) {
+    desired.insert(flow_rule_key(r));
+    replaced.insert(flow_rule_key(r.match, r.priority, 0));
+  }
+
+  // Delete flows that are not desired.
+  for (const Flow_stats_entry& e : have) {
+    if (desired.count(flow_rule_key(e)))
+      continue;
+    if (replaced.count(flow_rule_key(e.match, e.priority, 0)))
+      continue;
+    out.push_back(make_delete(e));
+  }
+
+  // Add missing rules and update those that differ.
+  for (const Flow_rule& r : want) {
+    auto iter = installed.find(flow_rule_key(r));
+    if (iter == installed.end()) {
+      out.push_back(make_flow_mod(r, Flow_mod::ADD));
+      continue;
+    }
+    const Flow_stats_entry& e = *iter->second;
+    if (e.idle_timeout != r.idle_timeout or e.hard_timeout != r.hard_timeout)
+      out.push_back(make_flow_mod(r, Flow_mod::ADD));
+    else if (not equal_actions(e.actions, r.actions))
+      out.push_back(make_flow_mod(r, Flow_mod::MODIFY_STRICT));
+  }
+}
+
+} // namespace v1_0
+} // namespace ofp
+} // namespace freeflow
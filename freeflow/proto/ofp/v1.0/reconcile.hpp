@@ -0,0 +1,86 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_OFPV1_0_RECONCILE_HPP
+#define FREEFLOW_OFPV1_0_RECONCILE_HPP
+
+#include <vector>
+
+#include <freeflow/proto/ofp/v1.0/message.hpp>
+#include <freeflow/proto/ofp/v1.0/stats.hpp>
+#include <freeflow/proto/ofp/v1.0/classifier.hpp>
+
+/// \file reconcile.hpp
+/// Reconciliation of a switch's flow table with the controller's.
+///
+/// When a switch reconnects, its flow table may differ from the rules
+/// the controller wants installed. Rather than deleting every flow and
+/// reinstalling the desired rules, the controller requests the switch's
+/// flow stats and computes the smallest set of flow mods that transforms
+/// the installed table into the desired one.
+
+namespace freeflow {
+namespace ofp {
+namespace v1_0 {
+
+/// A Flow_rule is a flow that the controller wants installed.
+struct Flow_rule {
+  Match           match;
+  Uint16          priority;
+  Uint64          cookie;
+  Uint16          idle_timeout;
+  Uint16          hard_timeout;
+  Flow_mod::Flags flags;
+  Action_list     actions;
+};
+
+using Flow_rules = std::vector<Flow_rule>;
+
+/// A Flow_rule_key identifies a flow by its match, priority and cookie.
+/// Matches are compared on the fields they do not wildcard, so a flow
+/// reported by a switch with arbitrary values in wildcarded fields has
+/// the same key as the rule that installed it.
+struct Flow_rule_key {
+  struct Hash {
+    std::size_t operator()(const Flow_rule_key&) const;
+  };
+
+  Flow_key         fields;
+  Match::Wildcards wildcards;
+  Uint16           priority;
+  Uint64           cookie;
+};
+
+// Equality comparison
+bool operator==(const Flow_rule_key&, const Flow_rule_key&);
+bool operator!=(const Flow_rule_key&, const Flow_rule_key&);
+
+// Construction
+Flow_rule_key flow_rule_key(const Match&, Uint16, Uint64);
+Flow_rule_key flow_rule_key(const Flow_rule&);
+Flow_rule_key flow_rule_key(const Flow_stats_entry&);
+
+// Comparison of actions
+bool equal_actions(const Action_list&, const Action_list&);
+
+// Reconciliation
+void reconcile(const Flow_rules&, const Flow_stats&, std::vector<Flow_mod>&);
+
+} // namespace v1_0
+} // namespace ofp
+} // namespace freeflow
+
+#include "reconcile.ipp"
+
+#endif
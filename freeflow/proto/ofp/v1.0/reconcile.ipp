@@ -0,0 +1,58 @@
+// Copyright (c) 2013-2014 Flowgrammable.org
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+namespace ofp {
+namespace v1_0 {
+
+inline bool
+operator==(const Flow_rule_key& a, const Flow_rule_key& b) {
+  return a.wildcards == b.wildcards
+     and a.priority == b.priority
+     and a.cookie == b.cookie
+     and a.fields == b.fields;
+}
+
+inline bool
+operator!=(const Flow_rule_key& a, const Flow_rule_key& b) {
+  return not (a == b);
+}
+
+inline std::size_t
+Flow_rule_key::Hash::operator()(const Flow_rule_key& k) const {
+  Uint64 h = hash_words(k.fields, 0, Flow_key::size, k.cookie);
+  return (h ^ (Uint64(k.wildcards) << 16 | k.priority)) * 0x9e3779b97f4a7c15ull;
+}
+
+/// Returns the key of the flow given by the match m, priority p and
+/// cookie c.
+inline Flow_rule_key
+flow_rule_key(const Match& m, Uint16 p, Uint64 c) {
+  Match::Wildcards w = normalize(m.wildcards);
+  return {flow_key(m) & flow_mask(w), w, p, c};
+}
+
+inline Flow_rule_key
+flow_rule_key(const Flow_rule& r) {
+  return flow_rule_key(r.match, r.priority, r.cookie);
+}
+
+inline Flow_rule_key
+flow_rule_key(const Flow_stats_entry& e) {
+  return flow_rule_key(e.match, e.priority, e.cookie);
+}
+
+} // namespace v1_0
+} // namespace ofp
+} // namespace freeflow
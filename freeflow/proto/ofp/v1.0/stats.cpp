@@ -12,6 +12,9 @@
 // or implied. See the License for the specific language governing
 // permissions and limitations under the License.
 
+#include <cstddef>
+#include <type_traits>
+
 #include "stats.hpp"
 
 namespace freeflow {
@@ -29,9 +32,8 @@ construct(Stats_reply_payload& m, Stats_type t) {
   case STATS_PORT: new (&m.port) Port_stats(); break;
   case STATS_QUEUE: new (&m.queue) Queue_stats(); break;
   case STATS_VENDOR: new (&m.vendor) Vendor_stats(); break;
-  default: break;
+  default: throw make_error_code(errc::bad_stats_type);
   }
-  throw make_error_code(errc::bad_stats_type);
 }
 
 void 
@@ -44,9 +46,8 @@ destroy(Stats_reply_payload& m, Stats_type t) {
   case STATS_PORT: m.port.~Port_stats(); break;
   case STATS_QUEUE: m.queue.~Queue_stats(); break;
   case STATS_VENDOR: m.vendor.~Vendor_stats(); break;
-  default: break;
+  default: throw make_error_code(errc::bad_stats_type);
   }
-  throw make_error_code(errc::bad_stats_type);
 }
 
 
@@ -88,41 +89,36 @@ bytes(const Stats_reply_payload& m, Stats_type t) {
 
 Error 
 to_view(View& v, const Flow_stats_request& m) {
-  to_view(v, m.match);
-  to_view(v, m.table_id);
-  pad(v, 1);
-  to_view(v, m.out_port);
+  if (not store(v, m))
+    return make_error_code(errc::stats_request_overflow);
   return {};
 }
 
 Error 
 to_view(View& v, const Port_stats_request& m) {
-  to_view(v, m.port_number);
-  pad(v, 6);
+  if (not store(v, m))
+    return make_error_code(errc::stats_request_overflow);
   return {};
 }
 
 Error 
 to_view(View& v, const Queue_stats_request& m) {
-  to_view(v, m.port_number);
-  pad(v, 2);
-  to_view(v, m.queue_id);
+  if (not store(v, m))
+    return make_error_code(errc::stats_request_overflow);
   return {};
 }
 
 Error 
 to_view(View& v, const Vendor_stats_request& m) {
-  to_view(v, m.vendor_id);
+  if (not store(v, m))
+    return make_error_code(errc::stats_request_overflow);
   return {};
 }
 
 Error 
 to_view(View& v, const Description_stats& m) {
-  to_view(v, m.mfr_desc);
-  to_view(v, m.hw_desc);
-  to_view(v, m.sw_desc);
-  to_view(v, m.serial_number);
-  to_view(v, m.dp_desc);
+  if (not store(v, m))
+    return make_error_code(errc::description_stats_overflow);
   return {};
 }
 
@@ -131,21 +127,11 @@ to_view(View& v, const Flow_stats_entry& m) {
   if (m.length < bytes(m)) // Required semantic check
     return make_error_code(errc::bad_flow_stats_length);
 
-  to_view(v, m.length);
-  to_view(v, m.table_id);
-  pad(v, 1);
-  to_view(v, m.match);
-  to_view(v, m.duration_sec);
-  to_view(v, m.duration_nsec);
-  to_view(v, m.priority);
-  to_view(v, m.idle_timeout);
-  to_view(v, m.hard_timeout);
-  pad(v, 6);
-  to_view(v, m.cookie);
-  to_view(v, m.packet_count);
-  to_view(v, m.byte_count);
-
-  if (Constrained_view c = constrain(v, m.length - bytes(m)))
+  if (not store_layout<Flow_stats_entry_layout>(v, m))
+    return make_error_code(errc::flow_stats_overflow);
+
+  std::size_t n = m.length - Flow_stats_entry_layout::size;
+  if (Constrained_view c = constrain(v, n))
     return to_view(c, m.actions);
   return
     make_error_code(errc::flow_stats_overflow);
@@ -153,54 +139,29 @@ to_view(View& v, const Flow_stats_entry& m) {
 
 Error 
 to_view(View& v, const Aggregate_stats& m) {
-  to_view(v, m.packet_count);
-  to_view(v, m.byte_count);
-  to_view(v, m.flow_count);
-  pad(v, 4);
+  if (not store(v, m))
+    return make_error_code(errc::aggregate_stats_overflow);
   return {};
 }
 
 Error 
 to_view(View& v, const Table_stats_entry& m) {
-  to_view(v, m.table_id);
-  pad(v, 3);
-  to_view(v, m.name);
-  to_view(v, m.wildcards);
-  to_view(v, m.max_entries);
-  to_view(v, m.active_count);
-  to_view(v, m.lookup_count);
-  to_view(v, m.matched_count);
+  if (not store(v, m))
+    return make_error_code(errc::table_stats_overflow);
   return {};
 }
 
 Error 
 to_view(View& v, const Port_stats_entry& m) {
-  to_view(v, m.port_number);
-  pad(v, 6);
-  to_view(v, m.rx_packets);
-  to_view(v, m.tx_packets);
-  to_view(v, m.rx_bytes);
-  to_view(v, m.tx_bytes);
-  to_view(v, m.rx_dropped);
-  to_view(v, m.tx_dropped);
-  to_view(v, m.rx_errors);
-  to_view(v, m.tx_errors);
-  to_view(v, m.rx_frame_err);
-  to_view(v, m.rx_over_err);
-  to_view(v, m.rx_crc_err);
-  to_view(v, m.collisions);
+  if (not store(v, m))
+    return make_error_code(errc::port_stats_overflow);
   return {};
 }
 
 Error 
 to_view(View& v, const Queue_stats_entry& m) {
-  if (m.length != 32) // Required semantic check
-    return make_error_code(errc::bad_queue_stats_length);
-  to_view(v, m.length);
-  pad(v, 2);
-  to_view(v, m.tx_bytes);
-  to_view(v, m.tx_packets);
-  to_view(v, m.tx_errors);
+  if (not store(v, m))
+    return make_error_code(errc::queue_stats_overflow);
   return {};
 }
 
@@ -257,64 +218,49 @@ to_view(View& v, const Stats_reply_payload& m, Stats_type t) {
 
 Error 
 from_view(View& v, Flow_stats_request& m) {
-  from_view(v, m.match);
-  from_view(v, m.table_id);
-  pad(v, 1);
-  from_view(v, m.out_port);
+  if (not load(v, m))
+    return make_error_code(errc::stats_request_overflow);
   return {};
 }
 
 Error 
 from_view(View& v, Port_stats_request& m) {
-  from_view(v, m.port_number);
-  pad(v, 6);
+  if (not load(v, m))
+    return make_error_code(errc::stats_request_overflow);
   return {};
 }
 
 Error 
 from_view(View& v, Queue_stats_request& m) {
-  from_view(v, m.port_number);
-  pad(v, 2);
-  from_view(v, m.queue_id);
+  if (not load(v, m))
+    return make_error_code(errc::stats_request_overflow);
   return {};
 }
 
 Error 
 from_view(View& v, Vendor_stats_request& m) {
-  from_view(v, m.vendor_id);
+  if (not load(v, m))
+    return make_error_code(errc::stats_request_overflow);
   return {};
 }
 
 Error 
 from_view(View& v, Description_stats& m) {
-  from_view(v, m.mfr_desc);
-  from_view(v, m.hw_desc);
-  from_view(v, m.sw_desc);
-  from_view(v, m.serial_number);
-  from_view(v, m.dp_desc);
+  if (not load(v, m))
+    return make_error_code(errc::description_stats_overflow);
   return {};
 }
 
 Error 
 from_view(View& v, Flow_stats_entry& m) {
-  from_view(v, m.length);
-  from_view(v, m.table_id);
-  pad(v, 1);
-  from_view(v, m.match);
-  from_view(v, m.duration_sec);
-  from_view(v, m.duration_nsec);
-  from_view(v, m.priority);
-  from_view(v, m.idle_timeout);
-  from_view(v, m.hard_timeout);
-  pad(v, 6);
-  from_view(v, m.cookie);
-  from_view(v, m.packet_count);
-  from_view(v, m.byte_count);
+  if (not load_layout<Flow_stats_entry_layout>(v, m))
+    return make_error_code(errc::flow_stats_overflow);
 
-  if (m.length < bytes(m)) // Required semantic check
+  if (m.length < Flow_stats_entry_layout::size) // Required semantic check
     return make_error_code(errc::bad_flow_stats_length);
 
-  if (Constrained_view c = constrain(v, m.length - bytes(m)))
+  std::size_t n = m.length - Flow_stats_entry_layout::size;
+  if (Constrained_view c = constrain(v, n))
     return from_view(c, m.actions);
   return
     make_error_code(errc::flow_stats_overflow);
@@ -322,55 +268,29 @@ from_view(View& v, Flow_stats_entry& m) {
 
 Error 
 from_view(View& v, Aggregate_stats& m) {
-  from_view(v, m.packet_count);
-  from_view(v, m.byte_count);
-  from_view(v, m.flow_count);
-  pad(v, 4);
+  if (not load(v, m))
+    return make_error_code(errc::aggregate_stats_overflow);
   return {};
 }
 
 Error 
 from_view(View& v, Table_stats_entry& m) {
-  from_view(v, m.table_id);
-  pad(v, 3);
-  from_view(v, m.name);
-  from_view(v, m.wildcards);
-  from_view(v, m.max_entries);
-  from_view(v, m.active_count);
-  from_view(v, m.lookup_count);
-  from_view(v, m.matched_count);
+  if (not load(v, m))
+    return make_error_code(errc::table_stats_overflow);
   return {};
 }
 
 Error 
 from_view(View& v, Port_stats_entry& m) {
-  from_view(v, m.port_number);
-  pad(v, 6);
-  from_view(v, m.rx_packets);
-  from_view(v, m.tx_packets);
-  from_view(v, m.rx_bytes);
-  from_view(v, m.tx_bytes);
-  from_view(v, m.rx_dropped);
-  from_view(v, m.tx_dropped);
-  from_view(v, m.rx_errors);
-  from_view(v, m.tx_errors);
-  from_view(v, m.rx_frame_err);
-  from_view(v, m.rx_over_err);
-  from_view(v, m.rx_crc_err);
-  from_view(v, m.collisions);
+  if (not load(v, m))
+    return make_error_code(errc::port_stats_overflow);
   return {};
 }
 
 Error 
 from_view(View& v, Queue_stats_entry& m) {
-  from_view(v, m.length);
-  pad(v, 2);
-  from_view(v, m.tx_bytes);
-  from_view(v, m.tx_packets);
-  from_view(v, m.tx_errors);
-
-  if (m.length != 32) // Required semantic check
-    return make_error_code(errc::bad_queue_stats_length);
+  if (not load(v, m))
+    return make_error_code(errc::queue_stats_overflow);
   return {};
 }
 
@@ -392,6 +312,81 @@ from_view(View& v, Stats_header& m) {
   return {};
 }
 
+// -------------------------------------------------------------------------- //
+// Bulk decoding
+//
+// Stats replies can carry thousands of entries, each of which is mostly
+// a run of 64-bit counters. The in-memory representations of port and
+// queue stats entries match their wire formats, so a sequence of entries
+// is decoded by converting the entire reply as an array of 64-bit values
+// and then re-reading the narrower fields at the front of each entry.
+//
+// The length of the view is validated before the sequence grows, so a
+// reply that cannot be decoded leaves the sequence unchanged.
+
+static_assert(std::is_standard_layout<Port_stats_entry>::value and
+              sizeof(Port_stats_entry) == Port_stats_entry_layout::size and
+              offsetof(Port_stats_entry, rx_packets) == 8 and
+              offsetof(Port_stats_entry, collisions) == 96,
+              "port stats entry does not match its wire format");
+
+static_assert(std::is_standard_layout<Queue_stats_entry>::value and
+              sizeof(Queue_stats_entry) == Queue_stats_entry_layout::size and
+              offsetof(Queue_stats_entry, queue_id) == 4 and
+              offsetof(Queue_stats_entry, tx_bytes) == 8 and
+              offsetof(Queue_stats_entry, tx_errors) == 24,
+              "queue stats entry does not match its wire format");
+
+/// Reads a sequence of table stats. Table names are not aligned with
+/// their wire format, so each entry is read using its layout.
+Error
+from_view(View& v, Table_stats& s) {
+  constexpr std::size_t n = Table_stats_entry_layout::size;
+  if (v.remaining() % n != 0)
+    return make_error_code(errc::table_stats_overflow);
+
+  std::size_t k = v.remaining() / n;
+  std::size_t i = s.size();
+  s.resize(i + k);
+  for (; i != s.size(); ++i, v.advance(n))
+    Table_stats_entry_layout::load(v.first, s[i]);
+  return {};
+}
+
+/// Reads a sequence of port stats.
+Error
+from_view(View& v, Port_stats& s) {
+  constexpr std::size_t n = Port_stats_entry_layout::size;
+  if (v.remaining() % n != 0)
+    return make_error_code(errc::port_stats_overflow);
+
+  std::size_t k = v.remaining() / n;
+  std::size_t i = s.size();
+  s.resize(i + k);
+  msbf_copy_64(s.data() + i, v.first, k * n / 8);
+  for (; i != s.size(); ++i, v.advance(n))
+    Wire<Port::Id>::load(v.first, s[i].port_number);
+  return {};
+}
+
+/// Reads a sequence of queue stats.
+Error
+from_view(View& v, Queue_stats& s) {
+  constexpr std::size_t n = Queue_stats_entry_layout::size;
+  if (v.remaining() % n != 0)
+    return make_error_code(errc::queue_stats_overflow);
+
+  std::size_t k = v.remaining() / n;
+  std::size_t i = s.size();
+  s.resize(i + k);
+  msbf_copy_64(s.data() + i, v.first, k * n / 8);
+  for (; i != s.size(); ++i, v.advance(n)) {
+    Wire<Port::Id>::load(v.first, s[i].port_no);
+    Wire<Uint32>::load(v.first + 4, s[i].queue_id);
+  }
+  return {};
+}
+
 Error
 from_view(View& v, Stats_request_payload& m, Stats_type t) {
   switch(t) {
@@ -18,6 +18,7 @@
 #include <freeflow/sys/error.hpp>
 #include <freeflow/sys/buffer.hpp>
 #include <freeflow/proto/ofp/ofp.hpp>
+#include <freeflow/proto/ofp/layout.hpp>
 #include <freeflow/proto/ofp/v1.0/error.hpp>
 #include <freeflow/proto/ofp/v1.0/port.hpp>
 #include <freeflow/proto/ofp/v1.0/match.hpp>
@@ -63,7 +64,7 @@ struct Port_stats_request {
 /// Represents a request for queue information.
 struct Queue_stats_request {
   Port::Id port_number;
-  Uint16   queue_id;
+  Uint32   queue_id;
 };
 
 /// Represents a reuest for vendor information.
@@ -104,7 +105,7 @@ struct Aggregate_stats {
 
 struct Table_stats_entry {
   Uint8 table_id;
-  String<128> name;
+  String<32> name;
   Uint32 wildcards;
   Uint32 max_entries;
   Uint32 active_count;
@@ -133,7 +134,7 @@ struct Port_stats_entry {
 using Port_stats = Sequence<Port_stats_entry>;
 
 struct Queue_stats_entry {
-  Uint16 length;
+  Port::Id port_no;
   Uint32 queue_id;
   Uint64 tx_bytes;
   Uint64 tx_packets;
@@ -147,6 +148,120 @@ struct Vendor_stats {
   Buffer data;
 };
 
+// -------------------------------------------------------------------------- //
+// Wire layouts
+
+using Flow_stats_request_layout = Layout<
+  Field<Flow_stats_request, Match, &Flow_stats_request::match>,
+  Field<Flow_stats_request, Uint8, &Flow_stats_request::table_id>,
+  Pad<1>,
+  Field<Flow_stats_request, Port::Id, &Flow_stats_request::out_port>
+>;
+
+using Port_stats_request_layout = Layout<
+  Field<Port_stats_request, Port::Id, &Port_stats_request::port_number>,
+  Pad<6>
+>;
+
+using Queue_stats_request_layout = Layout<
+  Field<Queue_stats_request, Port::Id, &Queue_stats_request::port_number>,
+  Pad<2>,
+  Field<Queue_stats_request, Uint32, &Queue_stats_request::queue_id>
+>;
+
+using Vendor_stats_request_layout = Layout<
+  Field<Vendor_stats_request, Uint32, &Vendor_stats_request::vendor_id>
+>;
+
+using Description_stats_layout = Layout<
+  Field<Description_stats, String<256>, &Description_stats::mfr_desc>,
+  Field<Description_stats, String<256>, &Description_stats::hw_desc>,
+  Field<Description_stats, String<256>, &Description_stats::sw_desc>,
+  Field<Description_stats, String<32>, &Description_stats::serial_number>,
+  Field<Description_stats, String<256>, &Description_stats::dp_desc>
+>;
+
+/// The layout of the fixed-size part of a flow stats entry. The entry's
+/// actions follow.
+using Flow_stats_entry_layout = Layout<
+  Field<Flow_stats_entry, Uint16, &Flow_stats_entry::length>,
+  Field<Flow_stats_entry, Uint8, &Flow_stats_entry::table_id>,
+  Pad<1>,
+  Field<Flow_stats_entry, Match, &Flow_stats_entry::match>,
+  Field<Flow_stats_entry, Uint32, &Flow_stats_entry::duration_sec>,
+  Field<Flow_stats_entry, Uint32, &Flow_stats_entry::duration_nsec>,
+  Field<Flow_stats_entry, Uint16, &Flow_stats_entry::priority>,
+  Field<Flow_stats_entry, Uint16, &Flow_stats_entry::idle_timeout>,
+  Field<Flow_stats_entry, Uint16, &Flow_stats_entry::hard_timeout>,
+  Pad<6>,
+  Field<Flow_stats_entry, Uint64, &Flow_stats_entry::cookie>,
+  Field<Flow_stats_entry, Uint64, &Flow_stats_entry::packet_count>,
+  Field<Flow_stats_entry, Uint64, &Flow_stats_entry::byte_count>
+>;
+
+using Aggregate_stats_layout = Layout<
+  Field<Aggregate_stats, Uint64, &Aggregate_stats::packet_count>,
+  Field<Aggregate_stats, Uint64, &Aggregate_stats::byte_count>,
+  Field<Aggregate_stats, Uint32, &Aggregate_stats::flow_count>,
+  Pad<4>
+>;
+
+using Table_stats_entry_layout = Layout<
+  Field<Table_stats_entry, Uint8, &Table_stats_entry::table_id>,
+  Pad<3>,
+  Field<Table_stats_entry, String<32>, &Table_stats_entry::name>,
+  Field<Table_stats_entry, Uint32, &Table_stats_entry::wildcards>,
+  Field<Table_stats_entry, Uint32, &Table_stats_entry::max_entries>,
+  Field<Table_stats_entry, Uint32, &Table_stats_entry::active_count>,
+  Field<Table_stats_entry, Uint64, &Table_stats_entry::lookup_count>,
+  Field<Table_stats_entry, Uint64, &Table_stats_entry::matched_count>
+>;
+
+using Port_stats_entry_layout = Layout<
+  Field<Port_stats_entry, Port::Id, &Port_stats_entry::port_number>,
+  Pad<6>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::rx_packets>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::tx_packets>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::rx_bytes>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::tx_bytes>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::rx_dropped>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::tx_dropped>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::rx_errors>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::tx_errors>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::rx_frame_err>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::rx_over_err>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::rx_crc_err>,
+  Field<Port_stats_entry, Uint64, &Port_stats_entry::collisions>
+>;
+
+using Queue_stats_entry_layout = Layout<
+  Field<Queue_stats_entry, Port::Id, &Queue_stats_entry::port_no>,
+  Pad<2>,
+  Field<Queue_stats_entry, Uint32, &Queue_stats_entry::queue_id>,
+  Field<Queue_stats_entry, Uint64, &Queue_stats_entry::tx_bytes>,
+  Field<Queue_stats_entry, Uint64, &Queue_stats_entry::tx_packets>,
+  Field<Queue_stats_entry, Uint64, &Queue_stats_entry::tx_errors>
+>;
+
+static_assert(Flow_stats_request_layout::size == 44, "bad stats layout");
+static_assert(Queue_stats_request_layout::size == 8, "bad stats layout");
+static_assert(Description_stats_layout::size == 1056, "bad stats layout");
+static_assert(Flow_stats_entry_layout::size == 88, "bad stats layout");
+static_assert(Aggregate_stats_layout::size == 24, "bad stats layout");
+static_assert(Table_stats_entry_layout::size == 64, "bad stats layout");
+static_assert(Port_stats_entry_layout::size == 104, "bad stats layout");
+static_assert(Queue_stats_entry_layout::size == 32, "bad stats layout");
+
+Flow_stats_request_layout wire_layout(const Flow_stats_request&);
+Port_stats_request_layout wire_layout(const Port_stats_request&);
+Queue_stats_request_layout wire_layout(const Queue_stats_request&);
+Vendor_stats_request_layout wire_layout(const Vendor_stats_request&);
+Description_stats_layout wire_layout(const Description_stats&);
+Aggregate_stats_layout wire_layout(const Aggregate_stats&);
+Table_stats_entry_layout wire_layout(const Table_stats_entry&);
+Port_stats_entry_layout wire_layout(const Port_stats_entry&);
+Queue_stats_entry_layout wire_layout(const Queue_stats_entry&);
+
 /// The payload of a stats request.
 union Stats_request_payload {
   Empty_stats_request  empty;
@@ -200,6 +315,7 @@ constexpr std::size_t bytes(const Queue_stats_request&);
 constexpr std::size_t bytes(const Vendor_stats_request&);
 constexpr std::size_t bytes(const Description_stats&);
 std::size_t bytes(const Flow_stats_entry&);
+constexpr std::size_t min_bytes(const Flow_stats&);
 constexpr std::size_t bytes(const Aggregate_stats&);
 constexpr std::size_t bytes(const Table_stats_entry&);
 constexpr std::size_t bytes(const Port_stats_entry&);
@@ -240,6 +356,9 @@ Error from_view(View&, Port_stats_entry&);
 Error from_view(View&, Queue_stats_entry&);
 Error from_view(View&, Vendor_stats&);
 Error from_view(View&, Stats_header&);
+Error from_view(View&, Table_stats&);
+Error from_view(View&, Port_stats&);
+Error from_view(View&, Queue_stats&);
 Error from_view(View&, Stats_request_payload&, Stats_type);
 Error from_view(View&, Stats_reply_payload&, Stats_type);
 
@@ -28,34 +28,40 @@ constexpr std::size_t
 bytes(const Empty_stats_request&) { return 0; }
 
 constexpr std::size_t 
-bytes(const Flow_stats_request& m) { return bytes(m.match) + 4; }
+bytes(const Flow_stats_request&) { return Wire<Flow_stats_request>::size; }
 
 constexpr std::size_t 
-bytes(const Port_stats_request&) { return 8; }
+bytes(const Port_stats_request&) { return Wire<Port_stats_request>::size; }
 
 constexpr std::size_t 
-bytes(const Queue_stats_request&) { return 8; }
+bytes(const Queue_stats_request&) { return Wire<Queue_stats_request>::size; }
 
 constexpr std::size_t 
-bytes(const Vendor_stats_request&) { return 4; }
+bytes(const Vendor_stats_request&) { return Wire<Vendor_stats_request>::size; }
 
 constexpr std::size_t 
-bytes(const Description_stats&) { return 1056; }
+bytes(const Description_stats&) { return Wire<Description_stats>::size; }
 
 inline std::size_t 
-bytes(const Flow_stats_entry& m) { return 44 + bytes(m.match) + bytes(m.actions); }
+bytes(const Flow_stats_entry& m) {
+  return Flow_stats_entry_layout::size + bytes(m.actions);
+}
+
+/// A flow stats entry with no actions is the smallest entry.
+constexpr std::size_t
+min_bytes(const Flow_stats&) { return Flow_stats_entry_layout::size; }
 
 constexpr std::size_t 
-bytes(const Aggregate_stats&) { return 24; }
+bytes(const Aggregate_stats&) { return Wire<Aggregate_stats>::size; }
 
 constexpr std::size_t 
-bytes(const Table_stats_entry&) { return 64; }
+bytes(const Table_stats_entry&) { return Wire<Table_stats_entry>::size; }
 
 constexpr std::size_t 
-bytes(const Port_stats_entry&) { return 104; }
+bytes(const Port_stats_entry&) { return Wire<Port_stats_entry>::size; }
 
 constexpr std::size_t 
-bytes(const Queue_stats_entry&) { return 32; }
+bytes(const Queue_stats_entry&) { return Wire<Queue_stats_entry>::size; }
 
 inline std::size_t 
 bytes(const Vendor_stats& m) { return 4 + bytes(m.data); }
@@ -15,25 +15,38 @@
 #ifndef FREEFLOW_ACTION_HPP
 #define FREEFLOW_ACTION_HPP
 
+#include <freeflow/sys/bitset.hpp>
+
 namespace freeflow {
 
-struct Action {
-  bool output;       // From FeatureRes.actions
-  bool set_vlan_vid; // From FeatureRes.actions
-  bool set_vlan_pcp; // From FeatureRes.actions
-  bool strip_vlan;   // From FeatureRes.actions
-  bool set_dl_src;   // From FeatureRes.actions
-  bool set_dl_dst;   // From FeatureRes.actions
-  bool set_nw_src;   // From FeatureRes.actions
-  bool set_nw_dst;   // From FeatureRes.actions
-  bool set_nw_tos;   // From FeatureRes.actions
-  bool set_tp_src;   // From FeatureRes.actions
-  bool set_tp_dst;   // From FeatureRes.actions
-  bool enqueue;      // From FeatureRes.actions
+/// The Action_kind enumeration identifies the kinds of actions that a
+/// switch can perform. The enumerators are ordered as the action
+/// types of OpenFlow 1.0, so the supported actions of a feature reply
+/// are a bitmask of Action_kinds.
+enum class Action_kind {
+  OUTPUT,       // From FeatureRes.actions
+  SET_VLAN_VID, // From FeatureRes.actions
+  SET_VLAN_PCP, // From FeatureRes.actions
+  STRIP_VLAN,   // From FeatureRes.actions
+  SET_DL_SRC,   // From FeatureRes.actions
+  SET_DL_DST,   // From FeatureRes.actions
+  SET_NW_SRC,   // From FeatureRes.actions
+  SET_NW_DST,   // From FeatureRes.actions
+  SET_NW_TOS,   // From FeatureRes.actions
+  SET_TP_SRC,   // From FeatureRes.actions
+  SET_TP_DST,   // From FeatureRes.actions
+  ENQUEUE,      // From FeatureRes.actions
 };
 
+/// The number of action kinds.
+constexpr std::size_t action_kinds = 12;
+
+/// An Action is a set of action kinds. It describes either the actions
+/// supported by a switch or the actions required by a flow.
+using Action = Bitset<Action_kind, action_kinds>;
+
 } // namespace freeflow
 
 #include <freeflow/sdn/action.ipp>
 
-#endif
\ No newline at end of file
+#endif
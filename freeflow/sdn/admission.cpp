@@ -0,0 +1,88 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+
+#include "admission.hpp"
+
+namespace freeflow {
+
+// Returns the number of tokens in the bucket at time t. Time before the
+// last update (e.g., from an unsynchronized clock) adds no tokens.
+double
+Token_bucket::refill(Time_point t) const {
+  if (t <= last_)
+    return tokens_;
+  double secs = std::chrono::duration<double>(t - last_).count();
+  return std::min(burst_, tokens_ + secs * rate_);
+}
+
+/// Take n tokens from the bucket at time t. Returns false, taking
+/// nothing, if fewer than n tokens are available.
+bool
+Token_bucket::take(Time_point t, double n) {
+  if (unlimited())
+    return true;
+  double avail = refill(t);
+  last_ = std::max(last_, t);
+  tokens_ = avail;
+  if (avail < n)
+    return false;
+  tokens_ -= n;
+  return true;
+}
+
+/// Change the limits. The global bucket is refilled, and switches
+/// connected after this call are given the new per-switch limits.
+void
+Admission::configure(const Admission_limits& l) {
+  limits_ = l;
+  global_ = Token_bucket(l.global_rate, l.global_burst);
+}
+
+/// Returns the initial admission state for a newly connected switch.
+Switch_admission
+Admission::make_switch() const {
+  Switch_admission s;
+  s.bucket = Token_bucket(limits_.switch_rate, limits_.switch_burst);
+  return s;
+}
+
+/// Decide whether to admit an event from the switch at time t. The event
+/// must fit within both the switch's own limit and the global limit, and
+/// is only charged against them when it does. A flooding switch cannot
+/// exhaust the global bucket at the expense of others, and an event
+/// refused by the global limit does not use up its switch's budget.
+bool
+Admission::admit(Switch_admission& s, Time_point t) {
+  if (s.bucket.available(t) and global_.available(t)) {
+    s.bucket.take(t);
+    global_.take(t);
+    ++s.counters.admitted;
+    ++counters_.admitted;
+    return true;
+  }
+
+  Uint32 n = limits_.sample_period;
+  if (n != 0 and ++s.excess % n == 0) {
+    ++s.counters.sampled;
+    ++counters_.sampled;
+    return true;
+  }
+  ++s.counters.dropped;
+  ++counters_.dropped;
+  return false;
+}
+
+} // namespace freeflow
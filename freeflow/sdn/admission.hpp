@@ -0,0 +1,120 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_ADMISSION_HPP
+#define FREEFLOW_ADMISSION_HPP
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/time.hpp>
+
+/// \file admission.hpp
+/// Rate limiting of asynchronous switch events.
+///
+/// A switch caught in a forwarding loop or a table-miss storm can send
+/// packet-ins faster than the controller can process them. Admission
+/// control bounds the rate at which each switch, and all switches
+/// together, can consume the controller's time. Each switch has a token
+/// bucket, and the controller has a global bucket. An event is admitted
+/// only if it can take a token from both. Events that are not admitted
+/// are discarded as soon as their header has been read, before they are
+/// decoded.
+///
+/// Optionally, one in every N excess events is admitted anyway, so that
+/// applications still observe a sample of the traffic of a flooding
+/// switch.
+
+namespace freeflow {
+
+/// A Token_bucket admits events at a sustained rate, with bursts of up
+/// to a fixed size. Tokens accrue continuously at the given rate until
+/// the bucket is full. A bucket with a non-positive rate is unlimited.
+class Token_bucket {
+public:
+  Token_bucket();
+  Token_bucket(double, double);
+
+  // Configuration
+  double rate() const;
+  double burst() const;
+  bool unlimited() const;
+
+  // Admission
+  bool available(Time_point, double = 1) const;
+  bool take(Time_point, double = 1);
+  double tokens(Time_point) const;
+
+private:
+  double refill(Time_point) const;
+
+  double     rate_;   // Tokens per second
+  double     burst_;  // The capacity of the bucket
+  double     tokens_; // Tokens available at last_
+  Time_point last_;
+};
+
+/// Configures admission control. Rates are given in events per second
+/// and bursts in events.
+struct Admission_limits {
+  double switch_rate   = 2000;
+  double switch_burst  = 200;
+  double global_rate   = 20000;
+  double global_burst  = 2000;
+
+  /// If non-zero, one in every sample_period events that exceed the
+  /// limits is admitted anyway.
+  Uint32 sample_period = 0;
+};
+
+/// Counts the outcomes of admission decisions.
+struct Admission_counters {
+  Uint64 admitted = 0; // Events admitted within the limits
+  Uint64 sampled  = 0; // Excess events admitted as samples
+  Uint64 dropped  = 0; // Excess events discarded
+};
+
+/// The admission state of a single switch.
+struct Switch_admission {
+  Token_bucket       bucket;
+  Admission_counters counters;
+  Uint64             excess = 0; // Excess events, for sampling
+};
+
+/// The Admission class holds the controller-wide limits and bucket, and
+/// decides whether each switch event is admitted.
+class Admission {
+public:
+  explicit Admission(const Admission_limits& = Admission_limits());
+
+  // Configuration
+  const Admission_limits& limits() const;
+  void configure(const Admission_limits&);
+  Switch_admission make_switch() const;
+
+  // Admission
+  bool admit(Switch_admission&, Time_point);
+
+  // Statistics
+  const Admission_counters& counters() const;
+
+private:
+  Admission_limits   limits_;
+  Token_bucket       global_;
+  Admission_counters counters_; // Totals over all switches
+};
+
+} // namespace freeflow
+
+#include <freeflow/sdn/admission.ipp>
+
+#endif
@@ -0,0 +1,62 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+/// Construct an unlimited bucket.
+inline
+Token_bucket::Token_bucket()
+  : Token_bucket(0, 0) { }
+
+/// Construct a full bucket that admits rate events per second, with
+/// bursts of up to burst events.
+inline
+Token_bucket::Token_bucket(double rate, double burst)
+  : rate_(rate), burst_(burst), tokens_(burst), last_() { }
+
+/// Returns the number of tokens added per second.
+inline double
+Token_bucket::rate() const { return rate_; }
+
+/// Returns the capacity of the bucket.
+inline double
+Token_bucket::burst() const { return burst_; }
+
+/// Returns true if the bucket admits every event.
+inline bool
+Token_bucket::unlimited() const { return rate_ <= 0; }
+
+/// Returns true if n tokens could be taken from the bucket at time t.
+inline bool
+Token_bucket::available(Time_point t, double n) const {
+  return unlimited() or refill(t) >= n;
+}
+
+/// Returns the number of tokens available at time t.
+inline double
+Token_bucket::tokens(Time_point t) const { return refill(t); }
+
+inline
+Admission::Admission(const Admission_limits& l)
+  : limits_(l), global_(l.global_rate, l.global_burst) { }
+
+/// Returns the limits used for new switches.
+inline const Admission_limits&
+Admission::limits() const { return limits_; }
+
+/// Returns the admission counters summed over all switches.
+inline const Admission_counters&
+Admission::counters() const { return counters_; }
+
+} // namespace freeflow
@@ -0,0 +1,102 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/sdn/admission.hpp>
+
+// Test that token buckets admit bursts and sustained rates, and that a
+// flooding switch is limited by its own bucket without starving other
+// switches of the global budget.
+
+using namespace freeflow;
+
+void test_bucket() {
+  Time_point t0 = now();
+
+  // Unlimited buckets admit everything.
+  Token_bucket u;
+  assert(u.unlimited());
+  for (int i = 0; i < 1000; ++i)
+    assert(u.take(t0));
+
+  // A full bucket admits a burst, then one event per refill interval.
+  Token_bucket b(100, 10);
+  for (int i = 0; i < 10; ++i)
+    assert(b.take(t0));
+  assert(not b.take(t0));
+  assert(not b.take(t0 + 5_ms));
+  assert(b.take(t0 + 10_ms));
+  assert(not b.take(t0 + 10_ms));
+
+  // Tokens do not accumulate beyond the burst.
+  assert(b.tokens(t0 + 10_s) == 10);
+
+  // Time running backwards adds nothing.
+  assert(not b.take(t0));
+}
+
+void test_admission() {
+  Admission_limits l;
+  l.switch_rate = 100;
+  l.switch_burst = 10;
+  l.global_rate = 100;
+  l.global_burst = 15;
+  Admission a(l);
+
+  Switch_admission s1 = a.make_switch();
+  Switch_admission s2 = a.make_switch();
+  Time_point t0 = now();
+
+  // The flooding switch is cut off by its own bucket.
+  int n = 0;
+  for (int i = 0; i < 100; ++i)
+    n += a.admit(s1, t0);
+  assert(n == 10);
+  assert(s1.counters.admitted == 10 and s1.counters.dropped == 90);
+
+  // The other switch still gets the rest of the global budget.
+  n = 0;
+  for (int i = 0; i < 10; ++i)
+    n += a.admit(s2, t0);
+  assert(n == 5);
+  assert(a.counters().admitted == 15 and a.counters().dropped == 95);
+
+  // Events refused by the global limit are not charged to the switch.
+  assert(s2.bucket.tokens(t0) == 5);
+  assert(a.admit(s2, t0 + 50_ms));
+  assert(s2.bucket.tokens(t0 + 50_ms) == 9);
+}
+
+void test_sampling() {
+  Admission_limits l;
+  l.switch_rate = 10;
+  l.switch_burst = 1;
+  l.sample_period = 4;
+  Admission a(l);
+  Switch_admission s = a.make_switch();
+
+  Time_point t0 = now();
+  int n = 0;
+  for (int i = 0; i < 17; ++i)
+    n += a.admit(s, t0);
+  assert(n == 5);
+  assert(s.counters.sampled == 4 and s.counters.dropped == 12);
+}
+
+int main() {
+  test_bucket();
+  test_admission();
+  test_sampling();
+}
@@ -15,6 +15,10 @@
 #ifndef FREEFLOW_APPLICATION_HPP
 #define FREEFLOW_APPLICATION_HPP
 
+#include <vector>
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/bitset.hpp>
 #include <freeflow/sys/library.hpp>
 
 namespace freeflow {
@@ -62,14 +66,54 @@ private:
 };
 
 
+/// The Event enumeration identifies the events sent to applications.
+enum class Event {
+  BIND,
+  UNBIND,
+  VERSION_KNOWN,
+  FEATURES_KNOWN,
+  PACKET_IN,
+  FLOW_REMOVED,
+  PORT_STATUS,
+  TABLE_STATUS,
+  ROLE_STATUS,
+};
+
+/// The number of events.
+constexpr std::size_t events = 9;
+
+/// A set of events.
+using Event_set = Bitset<Event, events>;
+
+/// A Subscription describes the events that an application receives
+/// from the switches it is bound to. An application may further limit
+/// the packet-in events it receives to packets of certain Ethernet types.
+/// By default, an application receives every event.
+struct Subscription {
+  Subscription();
+
+  bool accepts(Event) const;
+  bool accepts_packet(Uint16) const;
+
+  Event_set           events;    // Subscribed events
+  std::vector<Uint16> eth_types; // Packet-in Ethernet types, or all if empty
+};
+
+
 /// The base class of all native Freeflow applications. This defines the
 /// abstract events sent to derived classes.
+///
+/// An application declares the events it handles by subscribing to
+/// them. A switch only sends an event to applications subscribed to it.
+/// The subscription is read when the application is bound to a switch,
+/// so it should be established in the application's constructor.
 class Application {
 public:
   Application(Controller&);
   virtual ~Application();
 
   Controller& controller();
+  const Subscription& subscription() const;
 
   // Transport events
   virtual void bind(Switch&);
@@ -83,6 +127,9 @@ public:
   virtual void start();
   virtual void stop();
 
+  // Periodic events
+  virtual void tick();
+
   // Datapath events
   virtual void packet_in(Switch&, const Packet&);
   virtual void flow_removed(Switch&, const Flow&);
@@ -90,8 +137,12 @@ public:
   virtual void table_status(Switch&, const Flow_table&);
   virtual void role_status(Switch&, const Role&);
 
+protected:
+  void subscribe(const Subscription&);
+
 private:
-  Controller& ctrl_;
+  Controller&  ctrl_;
+  Subscription sub_;
 };
 
 
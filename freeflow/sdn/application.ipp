@@ -12,6 +12,7 @@
 // or implied. See the License for the specific language governing
 // permissions and limitations under the License.
 
+#include <algorithm>
 #include <typeinfo>
 
 namespace freeflow {
@@ -48,6 +49,31 @@ Application_library::destroy(Application* app) const {
   return factory_->destroy(app); 
 }
 
+// -------------------------------------------------------------------------- //
+// Subscription
+
+/// Initialize a subscription to all events.
+inline
+Subscription::Subscription() {
+  for (std::size_t i = 0; i < freeflow::events; ++i)
+    events.set(Event(i));
+}
+
+/// Returns true if the subscription includes the event e.
+inline bool
+Subscription::accepts(Event e) const { return events.test(e); }
+
+/// Returns true if the subscription includes packet-in events for
+/// packets of the Ethernet type t.
+inline bool
+Subscription::accepts_packet(Uint16 t) const {
+  if (not accepts(Event::PACKET_IN))
+    return false;
+  if (eth_types.empty())
+    return true;
+  return std::find(eth_types.begin(), eth_types.end(), t) != eth_types.end();
+}
+
 // -------------------------------------------------------------------------- //
 // Application
 
@@ -62,6 +88,14 @@ Application::~Application() { }
 inline Controller&
 Application::controller() { return ctrl_; }
 
+/// Returns the events to which the application is subscribed.
+inline const Subscription&
+Application::subscription() const { return sub_; }
+
+/// Set the events to which the application is subscribed.
+inline void
+Application::subscribe(const Subscription& s) { sub_ = s; }
+
 
 /// The bind event is sent whenever the application is bound to a switch.
 /// This happens immediately after the switch connects to the controller.
@@ -94,6 +128,12 @@ Application::start() { }
 inline void
 Application::stop() { }
 
+/// The tick event is sent periodically, about once a second, while any
+/// switch is connected. It allows applications to perform periodic
+/// work, such as probing or aging, without timers of their own.
+inline void
+Application::tick() { }
+
 /// The packet-in event is sent whenever a packet is transferred to
 /// the controller due to a table miss or a flow configuration.
 inline void
@@ -12,31 +12,112 @@
 // or implied. See the License for the specific language governing
 // permissions and limitations under the License.
 
+#include <algorithm>
+
 #include "controller.hpp"
 #include "switch.hpp"
 
 namespace freeflow {
 
-/// Register the switch and invoke its bind event.
+/// Register the switch and bind every running application to it. The
+/// switch is given the current per-switch admission limits.
+///
+/// \todo Find the set applications to bind to the connected switch.
+/// We need to consult some configuration table to determine this.
+/// For now, all applications bind to every switch.
 Switch&
 Controller::connect(Socket& sock) {
-  auto i = switches_.emplace(new Switch(*this, sock));
-  // Switch& s = **i.first;
-
-  // TODO: Find the set applications to bind to the connected switch.
-  // We need to consult some configuration table to determine this.
-  // For now, I'm assuming that all applications bind to every switch.
-  // s.bind(app_);
+  Switch* s = new Switch(*this, sock);
+  s->admission() = admit_.make_switch();
+  switches_.insert(&sock, s);
+  for (Process& p : procs_)
+    s->bind(p.app);
+  return *s;
+}
 
-  return **i.first;
+/// Record the datapath id of the switch, which is learned during feature
+/// discovery. If the datapath has connected before, its retained state
+/// is restored to the switch.
+void
+Controller::identify(Switch& s, Uint64 dpid) {
+  switches_.attach(s, dpid);
 }
 
-/// Remove the switch from the set.
+/// Unbind the applications from the switch and remove it from the
+/// registry. The state of its datapath is retained in case it
+/// reconnects.
 void
 Controller::disconnect(Switch& s) {
-  // s.unbind();
-  switches_.erase(&s);
+  s.unbind();
+  switches_.detach(s);
+  switches_.erase(&s.socket());
   delete &s;
 }
 
+/// Map the snapshot saved by a previous run of the controller. Returns
+/// false if there is no valid snapshot at the path.
+bool
+Controller::load_snapshot(const std::string& path) {
+  return snap_.open(path);
+}
+
+/// Save the state of every known datapath to a snapshot at the path.
+/// Returns false if the snapshot cannot be written.
+bool
+Controller::save_snapshot(const std::string& path) const {
+  std::vector<const Datapath*> dps;
+  switches_.datapaths(dps);
+  Snapshot_writer w;
+  for (const Datapath* dp : dps)
+    w.add(*dp);
+  return w.write(path);
+}
+
+/// Restore the state of the identified switch, whose feature reply has
+/// the given fingerprint. The state is taken from the previous
+/// connection of the datapath if it is retained, or from the snapshot.
+/// Returns true if the state was restored, in which case the datapath
+/// is unchanged and need not be reconfigured. Otherwise, the state
+/// derived from the switch is discarded, so that ports the switch no
+/// longer has do not linger, and the switch is marked with the
+/// fingerprint and must be configured as usual. Application state is
+/// kept.
+bool
+Controller::restore(Switch& s, Uint64 fp) {
+  Datapath& dp = s.datapath();
+  if (dp.fingerprint == fp)
+    return true;
+  if (snap_.restore(dp.datapath_id, fp, dp))
+    return true;
+
+  Datapath x = Datapath();
+  x.datapath_id = dp.datapath_id;
+  x.fingerprint = fp;
+  x.buffers = std::move(dp.buffers);
+  x.state = std::move(dp.state);
+  dp = std::move(x);
+  return false;
+}
+
+// Bind a newly started application to every connected switch.
+void
+Controller::bind(Application* app) {
+  std::vector<Switch*> ss;
+  switches_.connected(ss);
+  for (Switch* s : ss)
+    s->bind(app);
+}
+
+// Unbind a stopping application from every switch it is bound to.
+void
+Controller::unbind(Application* app) {
+  std::vector<Switch*> ss;
+  switches_.connected(ss);
+  for (Switch* s : ss) {
+    const std::vector<Application*>& apps = s->applications();
+    if (std::find(apps.begin(), apps.end(), app) != apps.end())
+      s->unbind(app);
+  }
+}
+
 } // namespace freeflow
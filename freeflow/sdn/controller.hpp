@@ -17,13 +17,19 @@
 
 #include <list>
 #include <unordered_map>
-#include <unordered_set>
 
 #include <freeflow/sys/acceptor.hpp>
 #include <freeflow/sys/connector.hpp>
 #include <freeflow/sys/reactor.hpp>
 
 #include <freeflow/sdn/application.hpp>
+#include <freeflow/sdn/registry.hpp>
+#include <freeflow/sdn/admission.hpp>
+#include <freeflow/sdn/poller.hpp>
+#include <freeflow/sdn/topology.hpp>
+#include <freeflow/sdn/snapshot.hpp>
+
+#include <freeflow/proto/ofp/keepalive.hpp>
 
 namespace freeflow {
 
@@ -75,7 +81,6 @@ struct Process {
 class Controller : public Reactor {
   using Library_map = std::unordered_map<std::string, Application_library*>;
   using Process_list = std::list<Process>;
-  using Switch_set = std::unordered_set<Switch*>;
 public:
   template<typename Handler>
     struct Handler_factory;
@@ -101,16 +106,56 @@ public:
 
   // Process managment
   Process* start(const std::string&);
+  Process* start(Application*, Application_library* = nullptr);
   void stop(Process*);
+  void tick();
 
   // Switch management
   Switch& connect(Socket&);
+  void identify(Switch&, Uint64);
   void disconnect(Switch&);
 
+  // Switch lookup
+  Switch* find_switch(Uint64) const;
+  Switch* find_switch(Switch_handle) const;
+  const Switch_registry& switches() const;
+
+  // Warm restart
+  bool load_snapshot(const std::string&);
+  bool save_snapshot(const std::string&) const;
+  bool restore(Switch&, Uint64);
+
+  // Event admission
+  Admission& admission();
+  const Admission& admission() const;
+
+  // Stats polling
+  Stats_poller& poller();
+  const Stats_poller& poller() const;
+
+  // Network topology
+  Topology& topology();
+  const Topology& topology() const;
+
+  // Session liveness
+  ofp::Keepalive& keepalive();
+
 private:
-  Library_map  libs_;     // The set of libraries
-  Process_list procs_;    // The hosted applications
-  Switch_set   switches_; // Connected switches
+  // Application binding
+  void bind(Application*);
+  void unbind(Application*);
+
+  Library_map     libs_;     // The set of libraries
+  Process_list    procs_;    // The hosted applications
+  Switch_registry switches_; // Connected switches and known datapaths
+  Admission       admit_;    // Limits on switch events
+  Stats_poller    poll_;     // Schedules stats requests to switches
+  Topology        topo_;     // Discovered switches and links
+  Snapshot        snap_;     // Datapath state saved by a previous run
+
+  // Liveness of established OpenFlow sessions. Sessions idle for 10s
+  // are probed, and those silent for 60s are closed.
+  ofp::Keepalive  alive_ {10_s, 60_s, 1_s};
 };
 
 /// The Handler_factory is responsible for the allocation of event
@@ -50,6 +50,45 @@ template<typename T>
     h->connect(a, t);
   }
 
+/// Returns the connected switch with the given datapath id, or nullptr.
+inline Switch*
+Controller::find_switch(Uint64 dpid) const { return switches_.find(dpid); }
+
+/// Returns the connected switch referred to by the handle, or nullptr.
+inline Switch*
+Controller::find_switch(Switch_handle h) const { return switches_.find(h); }
+
+/// Returns the admission control for events from all switches.
+inline Admission&
+Controller::admission() { return admit_; }
+
+inline const Admission&
+Controller::admission() const { return admit_; }
+
+/// Returns the poller that schedules stats requests to all switches.
+inline Stats_poller&
+Controller::poller() { return poll_; }
+
+inline const Stats_poller&
+Controller::poller() const { return poll_; }
+
+/// Returns the graph of switches and links. The graph is maintained by
+/// a discovery application and queried by routing applications.
+inline Topology&
+Controller::topology() { return topo_; }
+
+inline const Topology&
+Controller::topology() const { return topo_; }
+
+/// Returns the table that tracks the liveness of every established
+/// OpenFlow session hosted by the controller.
+inline ofp::Keepalive&
+Controller::keepalive() { return alive_; }
+
+/// Returns the registry of switches.
+inline const Switch_registry&
+Controller::switches() const { return switches_; }
+
 /// Returns true if the library is already loaded.
 inline bool
 Controller::is_loaded(const std::string& name) {
@@ -95,14 +134,7 @@ Controller::start(const std::string& name) {
     Application* app = lib->create(*this);
     if (not app) 
       return nullptr;
-
-    // Create the process record
-    auto iter = procs_.emplace(procs_.end(), app, lib);
-    iter->pos = iter;
-
-    // Perform startup
-    app->start();
-    return &*iter;
+    return start(app, lib);
   } catch(...) {
     std::cerr << "error: could not load library\n";
     throw;
@@ -110,21 +142,46 @@ Controller::start(const std::string& name) {
   }
 }
 
+/// Start a process for an application created from the library. If
+/// the library is null, the application is owned by the caller. The
+/// application is bound to every connected switch.
+inline Process*
+Controller::start(Application* app, Application_library* lib) {
+  // Create the process record
+  auto iter = procs_.emplace(procs_.end(), app, lib);
+  iter->pos = iter;
+
+  // Perform startup
+  app->start();
+  bind(app);
+  return &*iter;
+}
+
 /// Terminate the process, removing it from the process list and
-/// reclaiming any resources allocated to the application.
+/// reclaiming any resources allocated to the application. The
+/// application is first unbound from every connected switch.
 inline void
 Controller::stop(Process* proc) {
   Application* app = proc->app;
   Application_library* lib = proc->lib;
-  
+  unbind(app);
+
   // Release resources.
   app->stop();
-  lib->destroy(app);
+  if (lib)
+    lib->destroy(app);
 
   // Remove the process.
   procs_.erase(proc->pos);
 }
 
+/// Send the tick event to every running application.
+inline void
+Controller::tick() {
+  for (Process& p : procs_)
+    p.app->tick();
+}
+
 
 // -------------------------------------------------------------------------- //
 // Controller components
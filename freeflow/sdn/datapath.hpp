@@ -15,15 +15,48 @@
 #ifndef FREEFLOW_DATAPATH_HPP
 #define FREEFLOW_DATAPATH_HPP
 
+#include <map>
+#include <string>
+
 #include <freeflow/sdn/port.hpp>
 #include <freeflow/sdn/table.hpp>
 #include <freeflow/sys/buffer.hpp>
 
 namespace freeflow {
 
+/// The Capability enumeration identifies the optional features of a
+/// switch. The enumerators are ordered as the capabilities of OpenFlow
+/// 1.0, so the capabilities of a feature reply are a bitmask of
+/// Capability values.
+enum class Capability {
+  FLOW_STATS,   // Flow statistics
+  TABLE_STATS,  // Table statistics
+  PORT_STATS,   // Port statistics
+  STP,          // 802.1d spanning tree
+  RESERVED,     // Reserved
+  IP_REASM,     // Can reassemble IP fragments
+  QUEUE_STATS,  // Queue statistics
+  ARP_MATCH_IP, // Match IP addresses in ARP packets
+};
+
+/// The number of capabilities.
+constexpr std::size_t capabilities = 8;
+
+/// A set of capabilities.
+using Capabilities = Bitset<Capability, capabilities>;
+
+/// The state of a datapath. Applications may keep their own state for
+/// a datapath, by name, in its app state. That state is retained while
+/// the datapath is disconnected and saved in snapshots.
 struct Datapath {
-  Uint64      datapath_id;   // From FeatureRes
-  bool        ip_reassembly; // From FeatureRes.capabilities
+  /// Opaque application state, by application name.
+  using App_state = std::map<std::string, Buffer>;
+
+  Uint64       datapath_id;  // From FeatureRes
+  Uint64       fingerprint = 0; // Of the FeatureRes, or 0 if unknown
+  Capabilities capabilities; // From FeatureRes.capabilities
+  Match        match;        // Supported match fields
+  Action       actions;      // From FeatureRes.actions
   
   std::string mfr_desc;      // From StatsReq.Desc.mfr_desc
   std::string hw_desc;       // From StatsReq.Desc.hw_desc
@@ -35,8 +68,14 @@ struct Datapath {
   Flow_tables flow_tables;
   // TODO: change this to Packet_buffer class. Does this belong here?
   std::vector<Buffer> buffers;
+
+  App_state   state;
 };
 
+// Capability checking
+bool has_capability(const Datapath&, Capability);
+bool supports(const Datapath&, const Match&, const Action&);
+
 } // namespace freeflow
 
 #include <freeflow/sdn/datapath.ipp>
@@ -14,4 +14,17 @@
 
 namespace freeflow {
 
+/// Returns true if the datapath has the capability c.
+inline bool
+has_capability(const Datapath& dp, Capability c) {
+  return dp.capabilities.test(c);
+}
+
+/// Returns true if the datapath supports a flow that requires the match
+/// fields m and the actions a.
+inline bool
+supports(const Datapath& dp, const Match& m, const Action& a) {
+  return dp.match.contains(m) and dp.actions.contains(a);
+}
+
 } // namespace freeflow
\ No newline at end of file
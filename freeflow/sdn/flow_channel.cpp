@@ -0,0 +1,64 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+
+#include "flow_channel.hpp"
+
+namespace freeflow {
+
+constexpr std::size_t Flow_channel::default_batch;
+constexpr std::size_t Flow_channel::default_window;
+
+Flow_channel::Flow_channel(std::size_t b, std::size_t w)
+  : batch_(b), window_(w), installed_(0), next_(0), pushed_(0)
+{ 
+  assert(b > 0 and w > 0);
+}
+
+/// Move the next batch of messages from the backlog into out, and
+/// record the batch as sent. The batch is partial if the backlog holds
+/// fewer messages than the batch size. The caller must send the
+/// messages followed by a barrier. Returns the size of the batch.
+std::size_t
+Flow_channel::take(std::vector<Buffer>& out) {
+  assert(ready());
+  std::size_t n = std::min(batch_, backlog_.size());
+  for (std::size_t i = 0; i < n; ++i) {
+    out.push_back(std::move(backlog_.front()));
+    backlog_.pop_front();
+  }
+  Uint64 last = pushed_ - backlog_.size();
+  inflight_.push_back(Flow_batch{n, last, now(), Microseconds(0), false});
+  return n;
+}
+
+/// Indicate that the barrier following the oldest unacknowledged batch
+/// was answered (ok is true) or expired. Barrier replies arrive in the
+/// order the barriers were sent.
+void
+Flow_channel::acknowledge(bool ok) {
+  assert(not inflight_.empty());
+  Flow_batch b = inflight_.front();
+  inflight_.pop_front();
+
+  b.latency = std::chrono::duration_cast<Microseconds>(now() - b.sent);
+  b.ok = ok;
+  if (ok)
+    installed_ += b.size;
+  for (const auto& h : handlers_)
+    h.second(b);
+}
+
+} // namespace freeflow
@@ -0,0 +1,116 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_FLOW_CHANNEL_HPP
+#define FREEFLOW_FLOW_CHANNEL_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <freeflow/sys/buffer.hpp>
+#include <freeflow/sys/time.hpp>
+
+namespace freeflow {
+
+/// The statistics of a batch of flow modifications.
+struct Flow_batch {
+  std::size_t  size;    // The number of messages in the batch
+  Uint64       last;    // The sequence number of the last message
+  Time_point   sent;    // When the batch was sent
+  Microseconds latency; // Time from sending to the barrier reply
+  bool         ok;      // False if the barrier expired
+};
+
+
+/// A Flow_channel pipelines flow modifications to a switch.
+///
+/// Applications push encoded flow-mod messages into the channel. The
+/// protocol sends them in batches, each followed by a barrier request.
+/// At most window batches are unacknowledged at any time. When the
+/// switch falls behind in replying to barriers, the channel pauses, and
+/// messages wait in the backlog until a barrier reply opens the window.
+/// This bounds the number of messages buffered by the switch agent while
+/// keeping the connection busy.
+///
+/// Every message pushed into the channel is numbered in sequence,
+/// starting from 1, regardless of which application pushed it. Each
+/// batch carries the sequence number of its last message, so a producer
+/// can tell which of its own messages a batch covers by comparing that
+/// number with the ones returned when it pushed.
+///
+/// Each acknowledged batch is reported to every batch handler with its
+/// install latency. Several applications may subscribe to the batches
+/// of the same switch; each removes its handler by the id returned when
+/// it subscribed.
+///
+/// The protocol session of the switch is signaled whenever a message is
+/// pushed, so that messages pushed from outside the session are sent
+/// without waiting for traffic from the switch.
+class Flow_channel {
+public:
+  using Handler = std::function<void(const Flow_batch&)>;
+  using Handler_id = std::size_t;
+  using Signal = std::function<void()>;
+
+  static constexpr std::size_t default_batch = 256;
+  static constexpr std::size_t default_window = 4;
+
+  Flow_channel(std::size_t b = default_batch, std::size_t w = default_window);
+
+  // Configuration
+  void configure(std::size_t, std::size_t);
+  Handler_id on_batch(Handler);
+  void off_batch(Handler_id);
+  void on_push(Signal);
+
+  // Application interface
+  Uint64 push(Buffer&&);
+
+  // Observers
+  std::size_t batch_size() const;
+  std::size_t window() const;
+  std::size_t backlog() const;
+  std::size_t in_flight() const;
+  std::size_t installed() const;
+  bool paused() const;
+  bool ready() const;
+
+  // Protocol interface
+  std::size_t take(std::vector<Buffer>&);
+  void acknowledge(bool);
+
+private:
+  std::size_t batch_;     // Maximum messages per batch
+  std::size_t window_;    // Maximum unacknowledged batches
+  std::size_t installed_; // Messages in acknowledged batches
+  Handler_id  next_;      // The id of the next handler
+  Uint64      pushed_;    // The sequence number of the last message pushed
+
+  std::deque<Buffer>     backlog_;  // Messages waiting to be sent
+  std::deque<Flow_batch> inflight_; // Unacknowledged batches, oldest first
+
+  // Batch handlers, in the order they were added.
+  std::vector<std::pair<Handler_id, Handler>> handlers_;
+  Signal signal_; // Called when a message is pushed
+};
+
+} // namespace freeflow
+
+#include <freeflow/sdn/flow_channel.ipp>
+
+#endif
@@ -0,0 +1,86 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+/// Set the batch size and window. Batches already sent are unaffected.
+inline void
+Flow_channel::configure(std::size_t b, std::size_t w) {
+  assert(b > 0 and w > 0);
+  batch_ = b;
+  window_ = w;
+}
+
+/// Add a handler called as each batch is acknowledged. Returns the id
+/// used to remove the handler.
+inline Flow_channel::Handler_id
+Flow_channel::on_batch(Handler h) {
+  handlers_.emplace_back(next_, std::move(h));
+  return next_++;
+}
+
+/// Remove the handler with the given id. Handlers must not be added or
+/// removed while a batch is being reported.
+inline void
+Flow_channel::off_batch(Handler_id id) {
+  auto iter = std::find_if(handlers_.begin(), handlers_.end(), 
+    [id](const std::pair<Handler_id, Handler>& h) { return h.first == id; });
+  if (iter != handlers_.end())
+    handlers_.erase(iter);
+}
+
+/// Set the signal called when a message is pushed.
+inline void
+Flow_channel::on_push(Signal s) { signal_ = std::move(s); }
+
+/// Append an encoded flow modification to the backlog. Its xid is
+/// assigned when it is sent. Returns the sequence number of the message.
+inline Uint64
+Flow_channel::push(Buffer&& b) { 
+  backlog_.push_back(std::move(b)); 
+  ++pushed_;
+  if (signal_)
+    signal_();
+  return pushed_;
+}
+
+/// Returns the maximum number of messages in a batch.
+inline std::size_t
+Flow_channel::batch_size() const { return batch_; }
+
+/// Returns the maximum number of unacknowledged batches.
+inline std::size_t
+Flow_channel::window() const { return window_; }
+
+/// Returns the number of messages waiting to be sent.
+inline std::size_t
+Flow_channel::backlog() const { return backlog_.size(); }
+
+/// Returns the number of unacknowledged batches.
+inline std::size_t
+Flow_channel::in_flight() const { return inflight_.size(); }
+
+/// Returns the number of messages acknowledged by barrier replies.
+inline std::size_t
+Flow_channel::installed() const { return installed_; }
+
+/// Returns true when the window is full.
+inline bool
+Flow_channel::paused() const { return inflight_.size() >= window_; }
+
+/// Returns true when a batch can be sent.
+inline bool
+Flow_channel::ready() const { return not backlog_.empty() and not paused(); }
+
+} // namespace freeflow
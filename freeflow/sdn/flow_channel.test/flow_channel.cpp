@@ -0,0 +1,105 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/sdn/flow_channel.hpp>
+
+// Test that the flow channel batches messages and pauses when its
+// window of unacknowledged batches is full, and that acknowledged
+// batches are reported to every handler. Also test that the sequence
+// numbers of messages pushed by several producers identify the batches
+// that carry them.
+
+using namespace freeflow;
+
+int main() {
+  Flow_channel ch(4, 2);
+  std::vector<Flow_batch> acked;
+  ch.on_batch([&](const Flow_batch& b) { acked.push_back(b); });
+  std::size_t seen = 0;
+  Flow_channel::Handler_id h = 
+    ch.on_batch([&](const Flow_batch& b) { seen += b.size; });
+
+  for (int i = 0; i < 10; ++i)
+    assert(ch.push(Buffer(8, Byte(i))) == Uint64(i + 1));
+  assert(ch.backlog() == 10);
+  assert(ch.ready());
+
+  // Two full batches fill the window.
+  std::vector<Buffer> out;
+  assert(ch.take(out) == 4);
+  assert(out[0][0] == 0 and out[3][0] == 3);
+  out.clear();
+  assert(ch.take(out) == 4);
+  assert(ch.in_flight() == 2);
+  assert(ch.paused());
+  assert(not ch.ready());
+  assert(ch.backlog() == 2);
+
+  // Acknowledging a batch re-opens the window. The last batch is
+  // partial.
+  ch.acknowledge(true);
+  assert(acked.size() == 1 and acked[0].size == 4 and acked[0].ok);
+  assert(acked[0].last == 4);
+  assert(seen == 4);
+  assert(ch.installed() == 4);
+  assert(ch.ready());
+  out.clear();
+  assert(ch.take(out) == 2);
+  assert(out[1][0] == 9);
+  assert(not ch.ready());
+
+  // Expired barriers do not count as installed. A removed handler is
+  // no longer called.
+  ch.acknowledge(false);
+  assert(seen == 8);
+  ch.off_batch(h);
+  ch.acknowledge(true);
+  assert(seen == 8);
+  assert(acked.size() == 3);
+  assert(not acked[1].ok);
+  assert(acked[1].last == 8 and acked[2].last == 10);
+  assert(ch.installed() == 6);
+  assert(ch.in_flight() == 0);
+
+  // A second producer shares the channel. Each producer releases its
+  // messages when a batch covering their sequence numbers is acked,
+  // no matter how many of the batch's messages were its own.
+  std::vector<Uint64> mine;
+  std::size_t released = 0;
+  ch.on_batch([&](const Flow_batch& b) {
+    while (released < mine.size() and mine[released] <= b.last)
+      ++released;
+  });
+  ch.push(Buffer(8, Byte(0)));
+  ch.push(Buffer(8, Byte(0)));
+  ch.push(Buffer(8, Byte(0)));
+  mine.push_back(ch.push(Buffer(8, Byte(1))));
+  ch.push(Buffer(8, Byte(0)));
+  mine.push_back(ch.push(Buffer(8, Byte(1))));
+  assert(mine[0] == 14 and mine[1] == 16);
+
+  // The first batch holds three messages of the other producer and one
+  // of ours, the second batch holds the rest.
+  out.clear();
+  assert(ch.take(out) == 4);
+  assert(ch.take(out) == 2);
+  ch.acknowledge(true);
+  assert(acked.back().last == 14);
+  assert(released == 1);
+  ch.acknowledge(true);
+  assert(acked.back().last == 16);
+  assert(released == 2);
+}
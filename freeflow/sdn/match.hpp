@@ -15,51 +15,64 @@
 #ifndef FREEFLOW_MATCH_HPP
 #define FREEFLOW_MATCH_HPP
 
+#include <freeflow/sys/bitset.hpp>
+
 namespace freeflow {
 
-struct Match {
-  bool in_port;            // True
-  bool in_port_mask;       // From StatsRes.Table.wildcards
-  bool eth_src;            // True
-  bool eth_src_mask;       // From StatsRes.Table.wildcards
-  bool eth_dst;            // True
-  bool eth_dst_mask;       // From StatsRes.Table.wildcards
-  bool vlan_id;            // True
-  bool vlan_id_mask;       // From StatsRes.Table.wildcards
-  bool vlan_pcp;           // True
-  bool vlan_pcp_mask;      // From StatsRes.Table.wildcards
-  bool eth_type;           // True
-  bool eth_type_mask;      // From StatsRes.Table.wildcards
-  bool arp_opcode;         // From FeatureRes.capabilities
-  bool arp_opcode_mask;    // From FeatureRes.capabilities
-  bool arp_spa;            // From FeatureRes.capabilities
-  bool arp_spa_mask;       // From FeatureRes.capabilities
-  bool arp_tpa;            // From FeatureRes.capabilities
-  bool arp_tpa_mask;       // From FeatureRes.capabilities
-  bool ipv4_tos;           // True
-  bool ipv4_tos_mask;      // From FeatureRes.capabilities
-  bool ipv4_protocol;      // True
-  bool ipv4_protocol_mask; // From FeatureRes.capabilities
-  bool ipv4_src;           // True
-  bool ipv4_src_mask;      // From FeatureRes.capabilities
-  bool ipv4_dst;           // True
-  bool ipv4_dst_mask;      // From FeatureRes.capabilities
-  bool tcp_src;            // True
-  bool tcp_src_mask;       // From FeatureRes.capabilities
-  bool tcp_dst;            // True
-  bool tcp_dst_mask;       // From FeatureRes.capabilities
-  bool udp_src;            // True
-  bool udp_src_mask;       // From FeatureRes.capabilities
-  bool udp_dst;            // True
-  bool udp_dst_mask;       // From FeatureRes.capabilities
-  bool icmpv4_type;        // True
-  bool icmpv4_type_mask;   // From FeatureRes.capabilities
-  bool icmpv4_code;        // True
-  bool icmpv4_code_mask;   // From FeatureRes.capabilities
+/// The Match_field enumeration identifies the fields (and masks of
+/// fields) that a switch can match. Each enumerator is the index of the
+/// field in a Match.
+enum class Match_field {
+  IN_PORT,            // True
+  IN_PORT_MASK,       // From StatsRes.Table.wildcards
+  ETH_SRC,            // True
+  ETH_SRC_MASK,       // From StatsRes.Table.wildcards
+  ETH_DST,            // True
+  ETH_DST_MASK,       // From StatsRes.Table.wildcards
+  VLAN_ID,            // True
+  VLAN_ID_MASK,       // From StatsRes.Table.wildcards
+  VLAN_PCP,           // True
+  VLAN_PCP_MASK,      // From StatsRes.Table.wildcards
+  ETH_TYPE,           // True
+  ETH_TYPE_MASK,      // From StatsRes.Table.wildcards
+  ARP_OPCODE,         // From FeatureRes.capabilities
+  ARP_OPCODE_MASK,    // From FeatureRes.capabilities
+  ARP_SPA,            // From FeatureRes.capabilities
+  ARP_SPA_MASK,       // From FeatureRes.capabilities
+  ARP_TPA,            // From FeatureRes.capabilities
+  ARP_TPA_MASK,       // From FeatureRes.capabilities
+  IPV4_TOS,           // True
+  IPV4_TOS_MASK,      // From FeatureRes.capabilities
+  IPV4_PROTOCOL,      // True
+  IPV4_PROTOCOL_MASK, // From FeatureRes.capabilities
+  IPV4_SRC,           // True
+  IPV4_SRC_MASK,      // From FeatureRes.capabilities
+  IPV4_DST,           // True
+  IPV4_DST_MASK,      // From FeatureRes.capabilities
+  TCP_SRC,            // True
+  TCP_SRC_MASK,       // From FeatureRes.capabilities
+  TCP_DST,            // True
+  TCP_DST_MASK,       // From FeatureRes.capabilities
+  UDP_SRC,            // True
+  UDP_SRC_MASK,       // From FeatureRes.capabilities
+  UDP_DST,            // True
+  UDP_DST_MASK,       // From FeatureRes.capabilities
+  ICMPV4_TYPE,        // True
+  ICMPV4_TYPE_MASK,   // From FeatureRes.capabilities
+  ICMPV4_CODE,        // True
+  ICMPV4_CODE_MASK,   // From FeatureRes.capabilities
 };
 
+/// The number of match fields.
+constexpr std::size_t match_fields = 38;
+
+/// A Match is a set of match fields. It describes either the fields
+/// supported by a switch or the fields required by a flow. A switch
+/// supports a flow when its match contains the flow's.
+using Match = Bitset<Match_field, match_fields>;
+
 } // namespace freeflow
 
 #include <freeflow/sdn/match.ipp>
 
-#endif
\ No newline at end of file
+#endif
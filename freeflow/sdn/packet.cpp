@@ -0,0 +1,302 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cstring>
+
+#include "packet.hpp"
+
+namespace freeflow {
+
+namespace {
+
+inline Uint16
+load16(const Byte* p) {
+  Uint16 n;
+  std::memcpy(&n, p, sizeof(n));
+  return Byte_order::msbf(n);
+}
+
+inline Uint32
+load32(const Byte* p) {
+  Uint32 n;
+  std::memcpy(&n, p, sizeof(n));
+  return Byte_order::msbf(n);
+}
+
+// The LLC/SNAP header that encapsulates an Ethernet type in an 802.3
+// frame: DSAP, SSAP, control and a zero OUI.
+constexpr Byte snap_header[6] = { 0xaa, 0xaa, 0x03, 0x00, 0x00, 0x00 };
+
+// Extension headers that may precede the transport header of an IPv6
+// packet.
+constexpr Uint8 ipv6_hop_by_hop = 0;
+constexpr Uint8 ipv6_routing    = 43;
+constexpr Uint8 ipv6_fragment   = 44;
+constexpr Uint8 ipv6_auth       = 51;
+constexpr Uint8 ipv6_no_next    = 59;
+constexpr Uint8 ipv6_dest_opts  = 60;
+
+// Bound the number of extension headers that are skipped so that a
+// malicious chain cannot stall the controller.
+constexpr int ipv6_max_ext = 8;
+
+} // namespace
+
+constexpr Uint16 Packet_key::NO_VLAN;
+constexpr Uint16 Packet::npos;
+constexpr Uint32 Packet::NO_BUFFER;
+
+/// Hash the fields of the key. The key contains padding, so it cannot
+/// be hashed as a sequence of bytes.
+std::size_t
+Packet_key::Hash::operator()(const Packet_key& k) const {
+  Uint64 a = 0;
+  Uint64 b = 0;
+  std::memcpy(&a, k.dl_src, 6);
+  std::memcpy(&b, k.dl_dst, 6);
+  Uint64 h = a ^ (b << 16) ^ (b >> 48);
+  h = h * 0x9e3779b97f4a7c15ull ^ (Uint64(k.in_port) << 48 
+                                 | Uint64(k.dl_vlan) << 32 
+                                 | Uint64(k.dl_type) << 16 
+                                 | Uint64(k.nw_proto) << 8 
+                                 | k.nw_tos);
+  h = h * 0x9e3779b97f4a7c15ull ^ (Uint64(k.nw_src) << 32 | k.nw_dst);
+  h = h * 0x9e3779b97f4a7c15ull ^ (Uint64(k.tp_src) << 16 | k.tp_dst 
+                                 | Uint64(k.dl_pcp) << 32);
+  return h ^ (h >> 29);
+}
+
+/// Returns true if the keys have the same fields.
+bool
+operator==(const Packet_key& a, const Packet_key& b) {
+  return a.in_port == b.in_port
+     and std::memcmp(a.dl_src, b.dl_src, 6) == 0
+     and std::memcmp(a.dl_dst, b.dl_dst, 6) == 0
+     and a.dl_vlan == b.dl_vlan
+     and a.dl_pcp == b.dl_pcp
+     and a.dl_type == b.dl_type
+     and a.nw_tos == b.nw_tos
+     and a.nw_proto == b.nw_proto
+     and a.nw_src == b.nw_src
+     and a.nw_dst == b.nw_dst
+     and a.tp_src == b.tp_src
+     and a.tp_dst == b.tp_dst;
+}
+
+// Returns true if n bytes are available at offset k. Otherwise, the
+// packet is marked as truncated.
+inline bool
+Packet::available(std::size_t k, std::size_t n) {
+  if (k + n <= size_)
+    return true;
+  trunc_ = true;
+  return false;
+}
+
+// Parse the Ethernet header, including any VLAN tag or SNAP
+// encapsulation, and dispatch on the Ethernet type.
+void
+Packet::parse() {
+  key_.dl_vlan = Packet_key::NO_VLAN;
+  if (not available(0, 14))
+    return;
+  hdrs_.set(Packet_header::ETHERNET);
+  std::memcpy(key_.dl_dst, data_, 6);
+  std::memcpy(key_.dl_src, data_ + 6, 6);
+
+  std::size_t k = 12;
+  Uint16 type = load16(data_ + k);
+  if (type == eth_type::VLAN) {
+    if (not available(k, 6))
+      return;
+    hdrs_.set(Packet_header::VLAN);
+    Uint16 tci = load16(data_ + k + 2);
+    key_.dl_vlan = tci & 0x0fff;
+    key_.dl_pcp = tci >> 13;
+    k += 4;
+    type = load16(data_ + k);
+  }
+  k += 2;
+
+  // An 802.3 frame carries a length. The Ethernet type is recovered
+  // from its SNAP header, if it has one.
+  if (type < 0x0600) {
+    type = eth_type::NONE;
+    if (k + 8 <= size_ and std::memcmp(data_ + k, snap_header, 6) == 0) {
+      type = load16(data_ + k + 6);
+      k += 8;
+    }
+  }
+  key_.dl_type = type;
+  payload_ = k;
+
+  switch (type) {
+  case eth_type::ARP: return parse_arp(k);
+  case eth_type::IPV4: return parse_ipv4(k);
+  case eth_type::IPV6: return parse_ipv6(k);
+  default: return;
+  }
+}
+
+// Parse an ARP header. Only requests and replies for IPv4 over Ethernet
+// are recognized.
+void
+Packet::parse_arp(std::size_t k) {
+  if (not available(k, 28))
+    return;
+  const Byte* p = data_ + k;
+  if (load16(p) != 1 or load16(p + 2) != eth_type::IPV4 
+      or p[4] != 6 or p[5] != 4)
+    return;
+  hdrs_.set(Packet_header::ARP);
+  l3_ = k;
+  key_.nw_proto = load16(p + 6) & 0xff;
+  key_.nw_src = load32(p + 14);
+  key_.nw_dst = load32(p + 24);
+  payload_ = k + 28;
+}
+
+// Parse an IPv4 header. The transport header of a non-initial fragment
+// is not present.
+void
+Packet::parse_ipv4(std::size_t k) {
+  if (not available(k, 20))
+    return;
+  const Byte* p = data_ + k;
+  std::size_t len = (p[0] & 0x0f) * 4;
+  if ((p[0] >> 4) != 4 or len < 20 or not available(k, len))
+    return;
+  hdrs_.set(Packet_header::IPV4);
+  l3_ = k;
+  key_.nw_tos = p[1] & 0xfc;
+  key_.nw_proto = p[9];
+  key_.nw_src = load32(p + 12);
+  key_.nw_dst = load32(p + 16);
+  payload_ = k + len;
+
+  if (load16(p + 6) & 0x1fff) {
+    hdrs_.set(Packet_header::FRAGMENT);
+    return;
+  }
+  parse_transport(k + len, key_.nw_proto);
+}
+
+// Parse an IPv6 header and skip its extension headers. OpenFlow 1.0
+// cannot match IPv6 addresses, so only the traffic class and the final
+// next header are recorded in the key. The addresses can be read from
+// the network header.
+void
+Packet::parse_ipv6(std::size_t k) {
+  if (not available(k, 40))
+    return;
+  const Byte* p = data_ + k;
+  if ((p[0] >> 4) != 6)
+    return;
+  hdrs_.set(Packet_header::IPV6);
+  l3_ = k;
+  key_.nw_tos = ((p[0] << 4) | (p[1] >> 4)) & 0xfc;
+  Uint8 next = p[6];
+  k += 40;
+  payload_ = k;
+
+  for (int i = 0; i < ipv6_max_ext; ++i) {
+    std::size_t len;
+    switch (next) {
+    case ipv6_hop_by_hop:
+    case ipv6_routing:
+    case ipv6_dest_opts:
+      if (not available(k, 2))
+        return;
+      len = (data_[k + 1] + 1) * 8;
+      break;
+    case ipv6_auth:
+      if (not available(k, 2))
+        return;
+      len = (data_[k + 1] + 2) * 4;
+      break;
+    case ipv6_fragment:
+      if (not available(k, 8))
+        return;
+      if (load16(data_ + k + 2) & 0xfff8) {
+        hdrs_.set(Packet_header::FRAGMENT);
+        key_.nw_proto = data_[k];
+        payload_ = k + 8;
+        return;
+      }
+      len = 8;
+      break;
+    case ipv6_no_next:
+      key_.nw_proto = next;
+      return;
+    default:
+      key_.nw_proto = next;
+      return parse_transport(k, next);
+    }
+    if (not available(k, len))
+      return;
+    next = data_[k];
+    k += len;
+    payload_ = k;
+  }
+}
+
+// Parse the transport header starting at offset k. The ports, or the
+// ICMP type and code, are recorded even if the rest of the header is
+// truncated. The payload of a TCP segment is only located if its data
+// offset is at least the header size and lies within the frame.
+void
+Packet::parse_transport(std::size_t k, Uint8 proto) {
+  l4_ = k;
+  const Byte* p = data_ + k;
+  switch (proto) {
+  case ip_proto::TCP: {
+    if (not available(k, 4))
+      return;
+    hdrs_.set(Packet_header::TCP);
+    key_.tp_src = load16(p);
+    key_.tp_dst = load16(p + 2);
+    if (not available(k, 20))
+      return;
+    std::size_t len = (p[12] >> 4) * 4;
+    if (len >= 20 and available(k, len))
+      payload_ = k + len;
+    break;
+  }
+  case ip_proto::UDP:
+    if (not available(k, 4))
+      return;
+    hdrs_.set(Packet_header::UDP);
+    key_.tp_src = load16(p);
+    key_.tp_dst = load16(p + 2);
+    if (available(k, 8))
+      payload_ = k + 8;
+    break;
+  case ip_proto::ICMP:
+  case ip_proto::ICMPV6:
+    if (not available(k, 2))
+      return;
+    hdrs_.set(proto == ip_proto::ICMP ? Packet_header::ICMP 
+                                      : Packet_header::ICMPV6);
+    key_.tp_src = p[0];
+    key_.tp_dst = p[1];
+    if (available(k, 4))
+      payload_ = k + 4;
+    break;
+  default:
+    payload_ = k;
+    break;
+  }
+}
+
+} // namespace freeflow
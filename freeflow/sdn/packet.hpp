@@ -0,0 +1,169 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_PACKET_HPP
+#define FREEFLOW_PACKET_HPP
+
+#include <cstddef>
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/buffer.hpp>
+#include <freeflow/sys/bitset.hpp>
+#include <freeflow/proto/ofp/v1.0/match.hpp>
+
+/// \file packet.hpp
+/// Parsing of packets delivered to the controller.
+///
+/// A Packet is a read-only view of the frame carried by a packet-in
+/// message. Its headers are parsed once, when the packet is constructed,
+/// into a flow key and a set of header offsets. Parsing does not copy the
+/// frame or allocate memory, so applications can inspect the packet as
+/// often as needed without re-parsing it.
+///
+/// The flow key follows the field definitions of OpenFlow 1.0, so that an
+/// exact match for the packet can be built directly from the key. Fields
+/// of headers that are not present are zero.
+
+namespace freeflow {
+
+/// Well-known Ethernet types.
+namespace eth_type {
+constexpr Uint16 IPV4 = 0x0800;
+constexpr Uint16 ARP  = 0x0806;
+constexpr Uint16 VLAN = 0x8100;
+constexpr Uint16 IPV6 = 0x86dd;
+constexpr Uint16 LLDP = 0x88cc;
+
+/// The type given to 802.3 frames, which carry a length instead of a
+/// type.
+constexpr Uint16 NONE = 0x05ff;
+} // namespace eth_type
+
+/// Well-known IP protocol numbers.
+namespace ip_proto {
+constexpr Uint8 ICMP   = 1;
+constexpr Uint8 TCP    = 6;
+constexpr Uint8 UDP    = 17;
+constexpr Uint8 ICMPV6 = 58;
+} // namespace ip_proto
+
+/// The headers that can be recognized in a packet.
+enum class Packet_header {
+  ETHERNET,
+  VLAN,
+  ARP,
+  IPV4,
+  IPV6,
+  FRAGMENT, // A non-initial IP fragment; no transport header is present
+  TCP,
+  UDP,
+  ICMP,
+  ICMPV6
+};
+
+using Packet_headers = Bitset<Packet_header, 10>;
+
+/// A Packet_key holds the header fields of a packet that can be matched
+/// by a flow table. All values are in host byte order. For ARP packets,
+/// the network fields hold the opcode and protocol addresses. For ICMP
+/// packets, the transport ports hold the type and code.
+struct Packet_key {
+  static constexpr Uint16 NO_VLAN = 0xffff;
+
+  struct Hash {
+    std::size_t operator()(const Packet_key&) const;
+  };
+
+  Uint16 in_port;
+  Uint8  dl_src[6];
+  Uint8  dl_dst[6];
+  Uint16 dl_vlan; // NO_VLAN if the frame is not tagged
+  Uint8  dl_pcp;
+  Uint16 dl_type;
+  Uint8  nw_tos;  // The DSCP bits of the type of service
+  Uint8  nw_proto;
+  Uint32 nw_src;
+  Uint32 nw_dst;
+  Uint16 tp_src;
+  Uint16 tp_dst;
+};
+
+// Equality comparison
+bool operator==(const Packet_key&, const Packet_key&);
+bool operator!=(const Packet_key&, const Packet_key&);
+
+// Flow matches
+ofp::v1_0::Match exact_match(const Packet_key&);
+
+/// A Packet is a parsed view of an Ethernet frame. The frame's storage
+/// is not owned by the packet and must outlive it.
+///
+/// The offsets of the network and transport headers, and of the data
+/// following them, are recorded during parsing. An offset of npos
+/// indicates that the header is not present. A truncated packet, such as
+/// one whose data was cut short by the switch's miss_send_len, is parsed
+/// as far as its headers are complete.
+///
+/// A packet may also identify the buffer in which the switch holds the
+/// complete frame, so that the frame can later be released without
+/// sending it back to the switch.
+class Packet {
+public:
+  static constexpr Uint16 npos = 0xffff;
+  static constexpr Uint32 NO_BUFFER = 0xffffffff;
+
+  Packet(const Byte*, std::size_t, Uint16 = 0, Uint32 = NO_BUFFER);
+  Packet(const Buffer&, Uint16 = 0, Uint32 = NO_BUFFER);
+
+  // Frame
+  const Byte* data() const;
+  std::size_t size() const;
+  Uint32 buffer_id() const;
+
+  // Parsed headers
+  const Packet_key& key() const;
+  const Packet_headers& headers() const;
+  bool has(Packet_header) const;
+  bool truncated() const;
+  Uint16 eth_type() const;
+
+  // Header offsets
+  Uint16 l3() const;
+  Uint16 l4() const;
+  Uint16 payload() const;
+
+private:
+  bool available(std::size_t, std::size_t);
+  void parse();
+  void parse_arp(std::size_t);
+  void parse_ipv4(std::size_t);
+  void parse_ipv6(std::size_t);
+  void parse_transport(std::size_t, Uint8);
+
+  const Byte*    data_;
+  std::size_t    size_;
+  Uint32         buffer_;
+  Packet_key     key_;
+  Packet_headers hdrs_;
+  bool           trunc_;
+  Uint16         l3_;
+  Uint16         l4_;
+  Uint16         payload_;
+};
+
+} // namespace freeflow
+
+#include <freeflow/sdn/packet.ipp>
+
+#endif
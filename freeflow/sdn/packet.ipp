@@ -0,0 +1,110 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+inline bool
+operator!=(const Packet_key& a, const Packet_key& b) { return not (a == b); }
+
+/// Returns an OpenFlow 1.0 match for exactly the packets having the key
+/// k. Fields that OpenFlow 1.0 does not extract for the key's Ethernet
+/// type are wildcarded.
+inline ofp::v1_0::Match
+exact_match(const Packet_key& k) {
+  using Match = ofp::v1_0::Match;
+  Uint32 w = 0;
+  if (k.dl_type == eth_type::ARP)
+    w = Match::NW_TOS | Match::TP_SRC | Match::TP_DST;
+  else if (k.dl_type != eth_type::IPV4)
+    w = Match::NW_TOS | Match::NW_PROTO | Match::NW_SRC | Match::NW_DST
+      | Match::TP_SRC | Match::TP_DST;
+
+  Match m;
+  m.wildcards = Match::Wildcards(w);
+  m.in_port = k.in_port;
+  std::memcpy(m.dl_src.addr, k.dl_src, 6);
+  std::memcpy(m.dl_dst.addr, k.dl_dst, 6);
+  m.dl_vlan = k.dl_vlan;
+  m.dl_pcp = k.dl_pcp;
+  m.dl_type = k.dl_type;
+  m.nw_tos = k.nw_tos;
+  m.nw_proto = k.nw_proto;
+  ofp::Wire<Uint32>::store(m.nw_src.addr, k.nw_src);
+  ofp::Wire<Uint32>::store(m.nw_dst.addr, k.nw_dst);
+  m.tp_src = k.tp_src;
+  m.tp_dst = k.tp_dst;
+  return m;
+}
+
+/// Parse the n bytes of the frame starting at p, which was received on
+/// the given port and may be held in a switch buffer.
+inline
+Packet::Packet(const Byte* p, std::size_t n, Uint16 port, Uint32 buf)
+  : data_(p), size_(n), buffer_(buf), key_(), trunc_(false)
+  , l3_(npos), l4_(npos), payload_(npos) {
+  key_.in_port = port;
+  parse();
+}
+
+/// Parse the frame held in the buffer.
+inline
+Packet::Packet(const Buffer& b, Uint16 port, Uint32 buf)
+  : Packet(b.data(), b.size(), port, buf) { }
+
+/// Returns the first byte of the frame.
+inline const Byte*
+Packet::data() const { return data_; }
+
+/// Returns the number of bytes in the frame.
+inline std::size_t
+Packet::size() const { return size_; }
+
+/// Returns the id of the switch buffer holding the frame, or NO_BUFFER
+/// if the frame is not buffered.
+inline Uint32
+Packet::buffer_id() const { return buffer_; }
+
+/// Returns the flow key of the packet.
+inline const Packet_key&
+Packet::key() const { return key_; }
+
+/// Returns the set of headers found in the packet.
+inline const Packet_headers&
+Packet::headers() const { return hdrs_; }
+
+/// Returns true if the packet contains the given header.
+inline bool
+Packet::has(Packet_header h) const { return hdrs_.test(h); }
+
+/// Returns true if the frame ended before its headers were complete.
+inline bool
+Packet::truncated() const { return trunc_; }
+
+/// Returns the Ethernet type of the frame, after any VLAN tag.
+inline Uint16
+Packet::eth_type() const { return key_.dl_type; }
+
+/// Returns the offset of the network header.
+inline Uint16
+Packet::l3() const { return l3_; }
+
+/// Returns the offset of the transport header.
+inline Uint16
+Packet::l4() const { return l4_; }
+
+/// Returns the offset of the data following the innermost header.
+inline Uint16
+Packet::payload() const { return payload_; }
+
+} // namespace freeflow
@@ -0,0 +1,167 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+#include <initializer_list>
+
+#include <freeflow/sdn/packet.hpp>
+
+// Test that packet headers are parsed into the flow key and header
+// offsets, including VLAN tags, IPv6 extension headers, fragments and
+// truncated frames.
+
+using namespace freeflow;
+
+// Builds a frame from a sequence of bytes.
+struct Frame : Buffer {
+  Frame& bytes(std::initializer_list<int> l) {
+    for (int b : l)
+      push_back(b);
+    return *this;
+  }
+
+  Frame& u16(Uint16 n) { return bytes({n >> 8, n & 0xff}); }
+
+  Frame& zeros(std::size_t n) { 
+    insert(end(), n, 0); 
+    return *this;
+  }
+
+  // Destination 02:..:02, source 02:..:01.
+  Frame& ethernet(Uint16 type) {
+    bytes({2, 0, 0, 0, 0, 2, 2, 0, 0, 0, 0, 1});
+    return u16(type);
+  }
+
+  // An IPv4 header from 10.0.0.1 to 10.0.0.2.
+  Frame& ipv4(Uint8 proto, Uint16 frag = 0) {
+    bytes({0x45, 0xb8}).u16(0).u16(0).u16(frag);
+    bytes({64, proto, 0, 0});
+    return bytes({10, 0, 0, 1, 10, 0, 0, 2});
+  }
+};
+
+void test_tcp() {
+  Frame f;
+  f.ethernet(eth_type::VLAN).u16(0xa00a).u16(eth_type::IPV4);
+  f.ipv4(ip_proto::TCP);
+  f.u16(1234).u16(80).zeros(8).bytes({0x50, 0}).zeros(6);
+  f.bytes({'G', 'E', 'T'});
+
+  Packet p(f, 3);
+  const Packet_key& k = p.key();
+  assert(not p.truncated());
+  assert(p.has(Packet_header::VLAN) and p.has(Packet_header::TCP));
+  assert(k.in_port == 3);
+  assert(k.dl_src[5] == 1 and k.dl_dst[5] == 2);
+  assert(k.dl_vlan == 10 and k.dl_pcp == 5);
+  assert(k.dl_type == eth_type::IPV4);
+  assert(k.nw_tos == 0xb8 and k.nw_proto == ip_proto::TCP);
+  assert(k.nw_src == 0x0a000001 and k.nw_dst == 0x0a000002);
+  assert(k.tp_src == 1234 and k.tp_dst == 80);
+  assert(p.l3() == 18 and p.l4() == 38 and p.payload() == 58);
+  assert(p.data()[p.payload()] == 'G');
+}
+
+void test_arp() {
+  Frame f;
+  f.ethernet(eth_type::ARP).u16(1).u16(eth_type::IPV4).bytes({6, 4}).u16(2);
+  f.zeros(6).bytes({10, 0, 0, 7}).zeros(6).bytes({10, 0, 0, 9});
+
+  Packet p(f);
+  assert(p.has(Packet_header::ARP));
+  assert(p.key().dl_vlan == Packet_key::NO_VLAN);
+  assert(p.key().nw_proto == 2);
+  assert(p.key().nw_src == 0x0a000007 and p.key().nw_dst == 0x0a000009);
+  assert(p.payload() == f.size());
+}
+
+void test_ipv6() {
+  // A hop-by-hop options header followed by UDP.
+  Frame f;
+  f.ethernet(eth_type::IPV6).bytes({0x6b, 0x80, 0, 0}).u16(16);
+  f.bytes({0, 64}).zeros(32);
+  f.bytes({ip_proto::UDP, 0}).zeros(6);
+  f.u16(546).u16(547).u16(8).u16(0);
+
+  Packet p(f);
+  assert(p.has(Packet_header::IPV6) and p.has(Packet_header::UDP));
+  assert(p.key().nw_tos == 0xb8);
+  assert(p.key().nw_proto == ip_proto::UDP);
+  assert(p.key().tp_src == 546 and p.key().tp_dst == 547);
+  assert(p.l3() == 14 and p.l4() == 62 and p.payload() == 70);
+}
+
+void test_fragment() {
+  // Later fragments have no transport header.
+  Frame f;
+  f.ethernet(eth_type::IPV4).ipv4(ip_proto::UDP, 0x0010).u16(53).u16(53);
+  Packet p(f);
+  assert(p.has(Packet_header::FRAGMENT));
+  assert(not p.has(Packet_header::UDP));
+  assert(p.key().nw_proto == ip_proto::UDP);
+  assert(p.key().tp_src == 0 and p.l4() == Packet::npos);
+}
+
+void test_truncated() {
+  // The switch sent only the first bytes of the TCP header.
+  Frame f;
+  f.ethernet(eth_type::IPV4).ipv4(ip_proto::TCP).u16(22).u16(2222).zeros(2);
+  Packet p(f);
+  assert(p.truncated());
+  assert(p.has(Packet_header::TCP));
+  assert(p.key().tp_src == 22 and p.key().tp_dst == 2222);
+
+  // The data offset of the TCP header runs past the end of the frame.
+  Frame g;
+  g.ethernet(eth_type::IPV4).ipv4(ip_proto::TCP);
+  g.u16(22).u16(2222).zeros(8).bytes({0xf0, 0}).zeros(6);
+  Packet r(g);
+  assert(r.truncated() and r.has(Packet_header::TCP));
+  assert(r.payload() == r.l4());
+
+  // The data offset is smaller than the TCP header.
+  g[46] = 0x20;
+  Packet s(g);
+  assert(not s.truncated() and s.has(Packet_header::TCP));
+  assert(s.payload() == s.l4());
+
+  // A runt frame has no headers at all.
+  Packet q(f.data(), 10);
+  assert(q.truncated() and q.headers().none());
+}
+
+void test_snap() {
+  // An 802.3 frame with a SNAP header carrying IPv4, and one without.
+  Frame f;
+  f.ethernet(60).bytes({0xaa, 0xaa, 3, 0, 0, 0}).u16(eth_type::IPV4);
+  f.ipv4(ip_proto::ICMP).bytes({8, 0, 0, 0});
+  Packet p(f);
+  assert(p.eth_type() == eth_type::IPV4);
+  assert(p.has(Packet_header::ICMP));
+  assert(p.key().tp_src == 8 and p.key().tp_dst == 0);
+
+  Frame g;
+  g.ethernet(60).bytes({0x42, 0x42, 3}).zeros(40);
+  assert(Packet(g).eth_type() == eth_type::NONE);
+}
+
+int main() {
+  test_tcp();
+  test_arp();
+  test_ipv6();
+  test_fragment();
+  test_truncated();
+  test_snap();
+}
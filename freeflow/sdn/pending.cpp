@@ -0,0 +1,94 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include "pending.hpp"
+
+namespace freeflow {
+
+constexpr std::size_t Pending_flows::max_held;
+
+/// Mark the flow with key k as pending, starting at time t. Returns false
+/// if the flow is already pending.
+bool
+Pending_flows::hold(const Packet_key& k, Time_point t) {
+  Entry e;
+  e.deadline = t + life_;
+  e.serial = ++serial_;
+  e.count = 0;
+  if (not flows_.emplace(k, e).second)
+    return false;
+  order_.push_back(Deadline{e.deadline, e.serial, k});
+  return true;
+}
+
+/// If the flow of packet p is pending, absorb the packet and return true.
+/// The packet's buffer, if any, is held until the flow is released. A
+/// packet whose flow has expired is not absorbed.
+bool
+Pending_flows::absorb(const Packet& p, Time_point t) {
+  auto iter = flows_.find(p.key());
+  if (iter == flows_.end())
+    return false;
+  Entry& e = iter->second;
+  if (e.deadline <= t)
+    return false;
+  if (p.buffer_id() != Packet::NO_BUFFER and e.count < max_held)
+    e.held[e.count++] = Held_packet{p.buffer_id(), p.key().in_port};
+  ++absorbed_;
+  return true;
+}
+
+/// Remove the pending flow with key k, appending its held packets to
+/// the list. Nothing is appended when the policy is to drop them.
+void
+Pending_flows::release(const Packet_key& k, Held_packets& out) {
+  auto iter = flows_.find(k);
+  if (iter == flows_.end())
+    return;
+  take(iter->second, out);
+  flows_.erase(iter);
+}
+
+/// Remove the flows whose deadlines have passed by time t, appending
+/// their held packets to the list.
+void
+Pending_flows::expire(Time_point t, Held_packets& out) {
+  while (not order_.empty() and order_.front().time <= t) {
+    const Deadline& d = order_.front();
+    auto iter = flows_.find(d.key);
+
+    // The flow may have been released, and possibly held again, since
+    // this deadline was recorded.
+    if (iter != flows_.end() and iter->second.serial == d.serial) {
+      take(iter->second, out);
+      flows_.erase(iter);
+    }
+    order_.pop_front();
+  }
+}
+
+/// Remove all pending flows, discarding their held packets.
+void
+Pending_flows::clear() {
+  flows_.clear();
+  order_.clear();
+}
+
+void
+Pending_flows::take(Entry& e, Held_packets& out) {
+  if (policy_ == Pending_policy::RELEASE)
+    out.insert(out.end(), e.held, e.held + e.count);
+}
+
+} // namespace freeflow
@@ -0,0 +1,120 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_PENDING_HPP
+#define FREEFLOW_PENDING_HPP
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/time.hpp>
+#include <freeflow/sdn/packet.hpp>
+
+/// \file pending.hpp
+/// Suppression of duplicate packet-ins during flow setup.
+///
+/// When a reactive application sees the first packet of a new flow, it
+/// installs a rule for the flow. Until the rule reaches the switch, every
+/// further packet of the flow is also sent to the controller. The pending
+/// flow table records the flows whose rules are in flight so that those
+/// packets are absorbed by the controller instead of being delivered to
+/// the applications again.
+///
+/// A packet absorbed by the table may have been buffered by the switch.
+/// Its buffer id is held until the flow is released, at which point the
+/// packet is either sent back through the switch's flow table (where the
+/// new rule now applies) or dropped, according to the table's policy.
+/// Entries expire after a short lifetime in case the flow is never
+/// released.
+
+namespace freeflow {
+
+/// Determines what happens to the packets held for a pending flow when
+/// the flow is released or expires.
+enum class Pending_policy {
+  RELEASE, // Resubmit buffered packets to the flow table
+  DROP     // Let the switch discard buffered packets
+};
+
+/// A packet buffered by the switch while its flow was pending.
+struct Held_packet {
+  Uint32 buffer_id;
+  Uint16 in_port;
+};
+
+using Held_packets = std::vector<Held_packet>;
+
+/// The Pending_flows table maps the keys of flows being set up to the
+/// packets held for them. Because every entry has the same lifetime,
+/// entries expire in the order they were created, and expiry examines
+/// only the oldest entries.
+class Pending_flows {
+public:
+  /// The maximum number of buffered packets held for a flow. Further
+  /// packets are absorbed but not held; the switch discards their
+  /// buffers.
+  static constexpr std::size_t max_held = 8;
+
+  explicit Pending_flows(Microseconds = 200_ms, 
+                         Pending_policy = Pending_policy::RELEASE);
+
+  // Configuration
+  Microseconds lifetime() const;
+  Pending_policy policy() const;
+  void set_policy(Pending_policy);
+
+  // Observers
+  bool empty() const;
+  std::size_t size() const;
+  bool pending(const Packet_key&) const;
+  Uint64 absorbed() const;
+
+  // Flow setup
+  bool hold(const Packet_key&, Time_point);
+  bool absorb(const Packet&, Time_point);
+  void release(const Packet_key&, Held_packets&);
+  void expire(Time_point, Held_packets&);
+  void clear();
+
+private:
+  struct Entry {
+    Time_point  deadline;
+    Uint64      serial;  // Distinguishes re-holds of the same key
+    std::size_t count;   // The number of held packets
+    Held_packet held[max_held];
+  };
+
+  struct Deadline {
+    Time_point time;
+    Uint64     serial;
+    Packet_key key;
+  };
+
+  void take(Entry&, Held_packets&);
+
+  std::unordered_map<Packet_key, Entry, Packet_key::Hash> flows_;
+  std::deque<Deadline> order_; // Deadlines in the order of creation
+  Microseconds   life_;
+  Pending_policy policy_;
+  Uint64         serial_;
+  Uint64         absorbed_; // The number of packet-ins absorbed
+};
+
+} // namespace freeflow
+
+#include <freeflow/sdn/pending.ipp>
+
+#endif
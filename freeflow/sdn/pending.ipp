@@ -0,0 +1,51 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+inline
+Pending_flows::Pending_flows(Microseconds life, Pending_policy p)
+  : life_(life), policy_(p), serial_(0), absorbed_(0) { }
+
+/// Returns the time after which a pending flow expires.
+inline Microseconds
+Pending_flows::lifetime() const { return life_; }
+
+/// Returns the policy for held packets.
+inline Pending_policy
+Pending_flows::policy() const { return policy_; }
+
+/// Sets the policy for held packets.
+inline void
+Pending_flows::set_policy(Pending_policy p) { policy_ = p; }
+
+/// Returns true if no flows are pending.
+inline bool
+Pending_flows::empty() const { return flows_.empty(); }
+
+/// Returns the number of pending flows.
+inline std::size_t
+Pending_flows::size() const { return flows_.size(); }
+
+/// Returns true if the flow with key k is pending.
+inline bool
+Pending_flows::pending(const Packet_key& k) const { 
+  return flows_.count(k) != 0; 
+}
+
+/// Returns the total number of packet-ins absorbed by the table.
+inline Uint64
+Pending_flows::absorbed() const { return absorbed_; }
+
+} // namespace freeflow
@@ -0,0 +1,92 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/sdn/pending.hpp>
+
+// Test that packets of pending flows are absorbed, that their buffers
+// are held until the flow is released or expires, and that the policy
+// determines whether held buffers are returned.
+
+using namespace freeflow;
+
+// Returns an IPv4 frame whose source address ends with the given byte.
+Buffer frame(Uint8 src) {
+  Buffer b(34, 0);
+  b[12] = 0x08;
+  b[14] = 0x45;
+  b[29] = src;
+  return b;
+}
+
+int main() {
+  Pending_flows pf(100_ms);
+  Time_point t0 = now();
+  Buffer f1 = frame(1);
+  Buffer f2 = frame(2);
+
+  // Nothing is absorbed until a flow is held.
+  assert(not pf.absorb(Packet(f1, 1, 10), t0));
+  assert(pf.hold(Packet(f1, 1, 10).key(), t0));
+  assert(not pf.hold(Packet(f1, 1, 10).key(), t0));
+  assert(pf.pending(Packet(f1, 1).key()));
+
+  // Later packets of the flow are absorbed, whether or not they are
+  // buffered. Other flows, and the same flow on another port, are not.
+  assert(pf.absorb(Packet(f1, 1, 11), t0 + 1_ms));
+  assert(pf.absorb(Packet(f1, 1), t0 + 2_ms));
+  assert(pf.absorb(Packet(f1, 1, 12), t0 + 3_ms));
+  assert(not pf.absorb(Packet(f2, 1, 13), t0));
+  assert(not pf.absorb(Packet(f1, 2, 14), t0));
+  assert(pf.absorbed() == 3);
+
+  // Releasing the flow returns the held buffers.
+  Held_packets held;
+  pf.release(Packet(f1, 1).key(), held);
+  assert(held.size() == 2);
+  assert(held[0].buffer_id == 11 and held[1].buffer_id == 12);
+  assert(held[0].in_port == 1);
+  assert(pf.empty());
+  assert(not pf.absorb(Packet(f1, 1, 15), t0));
+
+  // Re-holding a released flow is not disturbed by its old deadline.
+  held.clear();
+  assert(pf.hold(Packet(f1, 1).key(), t0 + 50_ms));
+  pf.expire(t0 + 100_ms, held);
+  assert(pf.size() == 1);
+  assert(pf.absorb(Packet(f1, 1, 16), t0 + 120_ms));
+
+  // Expired flows no longer absorb packets and return their buffers.
+  assert(not pf.absorb(Packet(f1, 1, 17), t0 + 150_ms));
+  pf.expire(t0 + 150_ms, held);
+  assert(pf.empty());
+  assert(held.size() == 1 and held[0].buffer_id == 16);
+
+  // The number of held buffers is bounded.
+  held.clear();
+  pf.hold(Packet(f2, 1).key(), t0);
+  for (Uint32 i = 0; i < 2 * Pending_flows::max_held; ++i)
+    assert(pf.absorb(Packet(f2, 1, i), t0));
+  pf.release(Packet(f2, 1).key(), held);
+  assert(held.size() == Pending_flows::max_held);
+
+  // When the policy is to drop, no buffers are returned.
+  held.clear();
+  pf.set_policy(Pending_policy::DROP);
+  pf.hold(Packet(f2, 1).key(), t0);
+  assert(pf.absorb(Packet(f2, 1, 20), t0));
+  pf.release(Packet(f2, 1).key(), held);
+  assert(held.empty());
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+
+#include "poller.hpp"
+
+namespace freeflow {
+
+/// Begin polling a switch. Returns the delay until its first round,
+/// which is chosen uniformly from the initial interval so that switches
+/// connecting together are not polled together.
+Microseconds
+Stats_poller::start(Switch_poll& p) {
+  p = Switch_poll();
+  p.interval = limits_.initial_interval;
+  return Microseconds(Microseconds::rep(uniform() * p.interval.count()));
+}
+
+/// Reserve n requests for a round of the switch. Returns false if the
+/// global budget would be exceeded, in which case the round should be
+/// deferred. A round is always admitted when nothing is outstanding, so
+/// a budget smaller than a round does not stop polling.
+bool
+Stats_poller::acquire(Switch_poll& p, std::size_t n) {
+  if (in_flight_ + n > limits_.max_in_flight and in_flight_ != 0)
+    return false;
+  in_flight_ += n;
+  p.in_flight += n;
+  return true;
+}
+
+/// Defer a round of the switch. Returns the delay before it is retried.
+Microseconds
+Stats_poller::defer(Switch_poll& p) {
+  ++p.deferred;
+  return jittered(limits_.retry);
+}
+
+/// Complete a round of the switch, releasing its requests. The total is
+/// the sum of the switch's packet counters in the replies. The interval
+/// is scaled by the ratio of the steady change to the actual change
+/// since the last round. Returns the delay until the next round.
+Microseconds
+Stats_poller::complete(Switch_poll& p, Uint64 total) {
+  in_flight_ -= p.in_flight;
+  p.in_flight = 0;
+  ++p.rounds;
+
+  // Counters that went backwards were reset. Count from zero.
+  double scale = 1;
+  if (p.primed) {
+    Uint64 change = total >= p.total ? total - p.total : total;
+    if (change == 0)
+      scale = 2;
+    else
+      scale = std::min(2.0, std::max(0.5, 
+                double(limits_.steady_change) / double(change)));
+  }
+  p.total = total;
+  p.primed = true;
+
+  Microseconds::rep i = p.interval.count() * scale;
+  i = std::max(i, limits_.min_interval.count());
+  i = std::min(i, limits_.max_interval.count());
+  p.interval = Microseconds(i);
+  return jittered(p.interval);
+}
+
+/// Abandon the round of a disconnected switch, releasing its requests.
+void
+Stats_poller::cancel(Switch_poll& p) {
+  in_flight_ -= p.in_flight;
+  p.in_flight = 0;
+}
+
+/// Deliver a reply to every handler.
+void
+Stats_poller::deliver(Switch& sw, Stats_kind k, const Buffer& b) const {
+  for (const Handler& h : handlers_)
+    h(sw, k, b);
+}
+
+// Returns the delay d varied uniformly by up to the jitter fraction.
+Microseconds
+Stats_poller::jittered(Microseconds d) {
+  double f = 1 + limits_.jitter * (2 * uniform() - 1);
+  return Microseconds(Microseconds::rep(d.count() * f));
+}
+
+// Returns a number uniformly distributed in [0, 1), from an xorshift
+// generator. The quality of the generator is unimportant here.
+double
+Stats_poller::uniform() {
+  seed_ ^= seed_ >> 12;
+  seed_ ^= seed_ << 25;
+  seed_ ^= seed_ >> 27;
+  Uint64 x = seed_ * 0x2545f4914f6cdd1d;
+  return (x >> 11) * (1.0 / (Uint64(1) << 53));
+}
+
+} // namespace freeflow
@@ -0,0 +1,129 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_POLLER_HPP
+#define FREEFLOW_POLLER_HPP
+
+#include <functional>
+#include <vector>
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/time.hpp>
+#include <freeflow/sys/buffer.hpp>
+#include <freeflow/sdn/request.hpp>
+
+/// \file poller.hpp
+/// Scheduling of periodic statistics requests.
+///
+/// Polling every switch on a common timer sends every request at the
+/// same instant, producing spikes of load on the controller and the
+/// network. The stats poller schedules each switch separately. The first
+/// poll of a switch is placed at a random point within the interval,
+/// and every later poll is jittered, so requests spread evenly across
+/// the interval.
+///
+/// Each switch's interval adapts to the activity of its counters. A poll
+/// round requests several kinds of statistics; when all of the replies
+/// have arrived, they are decoded together and the change in the
+/// switch's packet counters since the previous round is reported to the
+/// poller. Busy switches are polled more often and idle switches less.
+///
+/// A global budget bounds the number of outstanding requests. A round
+/// that would exceed the budget, or that would be sent to a switch whose
+/// packet-ins are currently being limited, is retried shortly after,
+/// so polling never competes with event handling.
+
+namespace freeflow {
+
+class Switch;
+
+/// Configures the stats poller.
+struct Poll_limits {
+  Microseconds min_interval     = 1_s;
+  Microseconds max_interval     = 60_s;
+  Microseconds initial_interval = 10_s;
+
+  /// Each delay is varied by up to this fraction of itself.
+  double jitter = 0.2;
+
+  /// The change in packet counters per round at which a switch's
+  /// interval is steady. Larger changes shorten the interval and
+  /// smaller ones lengthen it, by at most a factor of 2 per round.
+  Uint64 steady_change = 10000;
+
+  /// The maximum number of outstanding requests over all switches.
+  std::size_t max_in_flight = 32;
+
+  /// The delay before retrying a deferred round.
+  Microseconds retry = 100_ms;
+
+  /// The statistics requested by each round.
+  std::vector<Stats_kind> kinds {Stats_kind::PORT, Stats_kind::FLOW};
+};
+
+/// The polling state of a single switch.
+struct Switch_poll {
+  Microseconds interval  = Microseconds(0); // The current interval
+  Uint64       total     = 0;     // The packet counters at the last round
+  bool         primed    = false; // True once a total has been recorded
+  std::size_t  in_flight = 0;     // Outstanding requests of the round
+  Uint64       rounds    = 0;     // Completed rounds
+  Uint64       deferred  = 0;     // Rounds deferred
+};
+
+/// The Stats_poller holds the polling limits, the global budget of
+/// outstanding requests, and the handlers to which replies are
+/// delivered. Delays are computed here; the protocol sends the requests
+/// and collects the replies.
+class Stats_poller {
+public:
+  /// A handler receives each reply of a completed round. The reply
+  /// holds the encoded reply messages, which handlers decode in place.
+  using Handler = std::function<void(Switch&, Stats_kind, const Buffer&)>;
+
+  explicit Stats_poller(const Poll_limits& = Poll_limits(), Uint64 = 1);
+
+  // Configuration
+  const Poll_limits& limits() const;
+  void configure(const Poll_limits&);
+
+  // Observers
+  std::size_t in_flight() const;
+
+  // Scheduling
+  Microseconds start(Switch_poll&);
+  bool acquire(Switch_poll&, std::size_t);
+  Microseconds defer(Switch_poll&);
+  Microseconds complete(Switch_poll&, Uint64);
+  void cancel(Switch_poll&);
+
+  // Delivery
+  void listen(Handler);
+  void deliver(Switch&, Stats_kind, const Buffer&) const;
+
+private:
+  Microseconds jittered(Microseconds);
+  double uniform();
+
+  Poll_limits          limits_;
+  std::size_t          in_flight_; // Outstanding requests of all switches
+  Uint64               seed_;      // State of the random generator
+  std::vector<Handler> handlers_;
+};
+
+} // namespace freeflow
+
+#include <freeflow/sdn/poller.ipp>
+
+#endif
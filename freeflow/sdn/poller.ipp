@@ -0,0 +1,38 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+inline
+Stats_poller::Stats_poller(const Poll_limits& l, Uint64 seed)
+  : limits_(l), in_flight_(0), seed_(seed ? seed : 1) { }
+
+/// Returns the limits of the poller.
+inline const Poll_limits&
+Stats_poller::limits() const { return limits_; }
+
+/// Change the limits of the poller. Switches adopt the new interval
+/// bounds at their next round.
+inline void
+Stats_poller::configure(const Poll_limits& l) { limits_ = l; }
+
+/// Returns the number of outstanding requests over all switches.
+inline std::size_t
+Stats_poller::in_flight() const { return in_flight_; }
+
+/// Register a handler for the replies of completed rounds.
+inline void
+Stats_poller::listen(Handler h) { handlers_.push_back(std::move(h)); }
+
+} // namespace freeflow
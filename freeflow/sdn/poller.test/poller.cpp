@@ -0,0 +1,107 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/sdn/poller.hpp>
+
+// Test that the first round of each switch is spread over the initial
+// interval, that delays are jittered within bounds, that intervals
+// adapt to counter activity, and that the global budget defers rounds.
+
+using namespace freeflow;
+
+int main() {
+  Poll_limits l;
+  l.min_interval = 1_s;
+  l.max_interval = 8_s;
+  l.initial_interval = 4_s;
+  l.jitter = 0.25;
+  l.steady_change = 1000;
+  l.max_in_flight = 4;
+  Stats_poller sp(l);
+
+  // First rounds fall within the initial interval, and are not all
+  // placed at the same instant.
+  Switch_poll p[4];
+  Microseconds first = sp.start(p[0]);
+  bool spread = false;
+  for (Switch_poll& s : p) {
+    Microseconds d = sp.start(s);
+    assert(d >= Microseconds(0) and d < l.initial_interval);
+    assert(s.interval == l.initial_interval);
+    spread |= d != first;
+  }
+  assert(spread);
+
+  // Retries are jittered around the retry delay.
+  for (int i = 0; i < 100; ++i) {
+    Microseconds d = sp.defer(p[0]);
+    assert(d >= Microseconds(75000) and d <= Microseconds(125000));
+  }
+  assert(p[0].deferred == 100);
+
+  // The budget admits two rounds of two requests, and no more.
+  assert(sp.acquire(p[0], 2));
+  assert(sp.acquire(p[1], 2));
+  assert(sp.in_flight() == 4);
+  assert(not sp.acquire(p[2], 2));
+
+  // Cancelling a round releases its requests.
+  sp.cancel(p[1]);
+  assert(sp.in_flight() == 2);
+  assert(p[1].in_flight == 0);
+
+  // The first completed round records the total without adapting.
+  Microseconds d = sp.complete(p[0], 5000);
+  assert(sp.in_flight() == 0);
+  assert(p[0].interval == 4_s);
+  assert(d >= 3_s and d <= 5_s);
+
+  // A large change halves the interval, at most, and never below the
+  // minimum.
+  sp.acquire(p[0], 2);
+  sp.complete(p[0], 5000 + 100000);
+  assert(p[0].interval == 2_s);
+  sp.acquire(p[0], 2);
+  sp.complete(p[0], 5000 + 200000);
+  assert(p[0].interval == 1_s);
+  sp.acquire(p[0], 2);
+  sp.complete(p[0], 5000 + 300000);
+  assert(p[0].interval == 1_s);
+
+  // The steady change keeps the interval; no change doubles it, up to
+  // the maximum.
+  sp.acquire(p[0], 2);
+  sp.complete(p[0], 305000 + 1000);
+  assert(p[0].interval == 1_s);
+  for (int i = 0; i < 5; ++i) {
+    sp.acquire(p[0], 2);
+    sp.complete(p[0], 306000);
+  }
+  assert(p[0].interval == 8_s);
+  assert(p[0].rounds == 10);
+
+  // Counters that were reset count from zero.
+  sp.acquire(p[0], 2);
+  sp.complete(p[0], 4000);
+  assert(p[0].interval == 4_s);
+
+  // A round larger than the budget is admitted when nothing else is
+  // outstanding.
+  assert(sp.acquire(p[3], 10));
+  assert(not sp.acquire(p[2], 1));
+  sp.complete(p[3], 0);
+  assert(sp.in_flight() == 0);
+}
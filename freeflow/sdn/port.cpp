@@ -12,4 +12,86 @@
 // or implied. See the License for the specific language governing
 // permissions and limitations under the License.
 
+#include <algorithm>
+
 #include "port.hpp"
+
+namespace freeflow {
+
+constexpr Uint32 Ports::dense_limit;
+constexpr Ports::Slot Ports::npos;
+
+/// Insert the port p, replacing any port with the same number. The
+/// status of a new port is zero-initialized. Returns the stored port.
+Port&
+Ports::insert(const Port& p) {
+  Slot s = lookup(p.port_number);
+  if (s != npos) {
+    ports_[s] = p;
+    return ports_[s];
+  }
+
+  s = ports_.size();
+  ports_.push_back(p);
+  status_.push_back(Port_status());
+  relink(p.port_number, s);
+  return ports_.back();
+}
+
+/// Remove the port with the given number. The last port is moved into
+/// its slot. Returns false if there is no such port.
+bool
+Ports::erase(Uint32 n) {
+  Slot s = lookup(n);
+  if (s == npos)
+    return false;
+
+  // Unlink the port.
+  if (n < dense_limit) {
+    dense_[n] = npos;
+  } else {
+    auto iter = std::find_if(sparse_.begin(), sparse_.end(), 
+      [n](const std::pair<Uint32, Slot>& p) { return p.first == n; });
+    sparse_.erase(iter);
+  }
+
+  // Move the last port into the vacated slot.
+  Slot last = ports_.size() - 1;
+  if (s != last) {
+    ports_[s] = std::move(ports_[last]);
+    status_[s] = status_[last];
+    relink(ports_[s].port_number, s);
+  }
+  ports_.pop_back();
+  status_.pop_back();
+  return true;
+}
+
+/// Remove all ports.
+void
+Ports::clear() {
+  ports_.clear();
+  status_.clear();
+  dense_.clear();
+  sparse_.clear();
+}
+
+// Record that the port with the given number is in slot s.
+void
+Ports::relink(Uint32 n, Slot s) {
+  if (n < dense_limit) {
+    if (n >= dense_.size())
+      dense_.resize(n + 1, npos);
+    dense_[n] = s;
+    return;
+  }
+  for (auto& p : sparse_) {
+    if (p.first == n) {
+      p.second = s;
+      return;
+    }
+  }
+  sparse_.emplace_back(n, s);
+}
+
+} // namespace freeflow
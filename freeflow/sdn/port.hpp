@@ -15,10 +15,12 @@
 #ifndef FREEFLOW_PORT_HPP
 #define FREEFLOW_PORT_HPP
 
-#include <string>
+#include <map>
+#include <vector>
 
 #include <freeflow/sdn/queue.hpp>
 #include <freeflow/sys/data.hpp>
+#include <freeflow/sys/symbol.hpp>
 
 namespace freeflow {
 
@@ -29,7 +31,9 @@ struct Mac_addr {
 
 ///The Port structure represents a port on a switch ...
 ///
-/// todo\ Doesn't this need some of the info from the ofp Config or ofp State?
+/// The Port holds descriptive information that rarely changes. State
+/// that is read or updated while processing packets is kept separately
+/// in a Port_status.
 struct Port {
   static constexpr Uint32 MAX         = 0xffffff00;
   static constexpr Uint32 IN_PORT     = 0xfffffff8;
@@ -76,18 +80,59 @@ struct Port {
   Uint32      port_number; // Physical port number
   Queues      queues;      // Queues linked to this port
   Mac_addr    hw_addr;     // From FeatureRes.ports[]
-  std::string name;        // From FeatureRes.ports[]
+  Symbol      name;        // From FeatureRes.ports[]
   Features    current;     // From FeatureRes.ports[].supported
   Features    advertised;  // From FeatureRes.ports[].supported
   Features    supported;   // From FeatureRes.ports[].supported
   Features    peer;        // From FeatureRes.ports[].supported
 };
 
-/// The Ports structure represents a sequence of ports and some information 
-/// related to them.
-struct Ports : public std::map<Uint32, Port> {
-  bool port_stats;  // From FeatureRes.capabilities
-  bool stp;         // From FeatureRes.capabilities
+/// The Port_status structure contains the state of a port that changes
+/// frequently or is needed when processing packets.
+struct Port_status {
+  Uint32 config;     // From FeatureRes.ports[].config
+  Uint32 state;      // From FeatureRes.ports[].state
+  Uint64 rx_packets; // From StatsRes.Port
+  Uint64 tx_packets; // From StatsRes.Port
+  Uint64 rx_bytes;   // From StatsRes.Port
+  Uint64 tx_bytes;   // From StatsRes.Port
+};
+
+/// The Ports class stores the ports of a switch in a flat table. Ports
+/// and their statuses are kept in parallel arrays, ordered arbitrarily.
+/// Physical ports are numbered densely from 1, so they are found by
+/// indexing a table of slots with the port number. Ports numbered above
+/// the dense range (e.g., the local port) are found by a linear search
+/// of a short list.
+class Ports {
+public:
+  using iterator = std::vector<Port>::iterator;
+  using const_iterator = std::vector<Port>::const_iterator;
+
+  /// Ports numbered below this limit are found by indexing.
+  static constexpr Uint32 dense_limit = 4096;
+
+  // Observers
+  bool empty() const;
+  std::size_t size() const;
+
+  // Lookup
+  Port* find(Uint32);
+  const Port* find(Uint32) const;
+  Port_status* status(Uint32);
+  const Port_status* status(Uint32) const;
+
+  // Mutators
+  Port& insert(const Port&);
+  bool erase(Uint32);
+  void clear();
+
+  // Iterators
+  iterator begin();
+  iterator end();
+  const_iterator begin() const;
+  const_iterator end() const;
+
   bool all;         // True
   bool controller;  // True
   bool local;       // True
@@ -96,6 +141,18 @@ struct Ports : public std::map<Uint32, Port> {
   bool normal;      // ?
   bool flood;       // ?
   bool none;        // True
+
+private:
+  using Slot = Uint32;
+  static constexpr Slot npos = Slot(-1);
+
+  Slot lookup(Uint32) const;
+  void relink(Uint32, Slot);
+
+  std::vector<Port>        ports_;  // Descriptions
+  std::vector<Port_status> status_; // Statuses, parallel to ports_
+  std::vector<Slot>        dense_;  // Slots of ports below dense_limit
+  std::vector<std::pair<Uint32, Slot>> sparse_; // Slots of other ports
 };
 
 /// The Port_stats_entry structure contains all of the counters for a
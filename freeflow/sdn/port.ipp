@@ -14,4 +14,63 @@
 
 namespace freeflow {
 
-} // namespace freeflow
\ No newline at end of file
+/// Returns true if there are no ports.
+inline bool
+Ports::empty() const { return ports_.empty(); }
+
+/// Returns the number of ports.
+inline std::size_t
+Ports::size() const { return ports_.size(); }
+
+/// Returns the port with the given number, or nullptr if there is no
+/// such port.
+inline Port*
+Ports::find(Uint32 n) {
+  Slot s = lookup(n);
+  return s == npos ? nullptr : &ports_[s];
+}
+
+inline const Port*
+Ports::find(Uint32 n) const {
+  Slot s = lookup(n);
+  return s == npos ? nullptr : &ports_[s];
+}
+
+/// Returns the status of the port with the given number, or nullptr if
+/// there is no such port.
+inline Port_status*
+Ports::status(Uint32 n) {
+  Slot s = lookup(n);
+  return s == npos ? nullptr : &status_[s];
+}
+
+inline const Port_status*
+Ports::status(Uint32 n) const {
+  Slot s = lookup(n);
+  return s == npos ? nullptr : &status_[s];
+}
+
+inline Ports::iterator
+Ports::begin() { return ports_.begin(); }
+
+inline Ports::iterator
+Ports::end() { return ports_.end(); }
+
+inline Ports::const_iterator
+Ports::begin() const { return ports_.begin(); }
+
+inline Ports::const_iterator
+Ports::end() const { return ports_.end(); }
+
+// Returns the slot of the port with the given number, or npos.
+inline Ports::Slot
+Ports::lookup(Uint32 n) const {
+  if (n < dense_limit)
+    return n < dense_.size() ? dense_[n] : npos;
+  for (const auto& p : sparse_)
+    if (p.first == n)
+      return p.second;
+  return npos;
+}
+
+} // namespace freeflow
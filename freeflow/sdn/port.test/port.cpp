@@ -0,0 +1,75 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/sdn/port.hpp>
+
+// Test lookup of dense and sparse port numbers, and that erasing a port
+// keeps the remaining ports reachable.
+
+using namespace freeflow;
+
+Port
+make_port(Uint32 n, const char* name) {
+  Port p = Port();
+  p.port_number = n;
+  p.name = Symbol(name);
+  return p;
+}
+
+int main() {
+  Ports ps;
+  assert(ps.empty());
+  assert(ps.find(1) == nullptr);
+
+  for (Uint32 n = 1; n <= 48; ++n)
+    ps.insert(make_port(n, "eth"));
+  ps.insert(make_port(0xfffe, "local"));
+  assert(ps.size() == 49);
+
+  // Names are interned.
+  assert(ps.find(1)->name == ps.find(2)->name);
+  assert(ps.find(1)->name != ps.find(0xfffe)->name);
+  assert(ps.find(0xfffe)->name.str() == "local");
+
+  // Statuses are zero-initialized and found by port number.
+  assert(ps.status(7)->rx_packets == 0);
+  ps.status(7)->rx_packets = 10;
+  ps.status(0xfffe)->state = 1;
+  assert(ps.find(49) == nullptr);
+  assert(ps.status(5000) == nullptr);
+
+  // Erasing a port moves another into its slot.
+  assert(ps.erase(7));
+  assert(not ps.erase(7));
+  assert(ps.find(7) == nullptr);
+  assert(ps.find(0xfffe)->port_number == 0xfffe);
+  assert(ps.status(0xfffe)->state == 1);
+  assert(ps.erase(1));
+  for (Uint32 n = 2; n <= 48; ++n)
+    assert(n == 7 or ps.find(n)->port_number == n);
+  assert(ps.size() == 47);
+
+  // Re-inserting a port starts with a fresh status.
+  ps.insert(make_port(7, "eth"));
+  assert(ps.status(7)->rx_packets == 0);
+
+  std::size_t n = 0;
+  for (const Port& p : ps) {
+    assert(ps.find(p.port_number) == &p);
+    ++n;
+  }
+  assert(n == ps.size());
+}
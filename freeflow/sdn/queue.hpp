@@ -31,7 +31,6 @@ struct Queue {
 
 struct Queues {
   bool pause_asym;   // From FeatureRes.ports[].supported
-  bool queue_stats;  // From FeatureRes.capabilities
   std::vector<Queue> queues;
 };
 
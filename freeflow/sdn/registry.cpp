@@ -0,0 +1,101 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include "registry.hpp"
+#include "switch.hpp"
+
+namespace freeflow {
+
+constexpr Uint32 Switch_handle::npos;
+
+/// Associate the switch with the datapath id, returning the handle of
+/// the datapath's record. If the datapath was previously connected, the
+/// retained datapath state is moved into the switch. If another switch
+/// claims the same datapath, it is superseded by s.
+Switch_handle
+Switch_registry::attach(Switch& s, Uint64 dpid) {
+  Uint32 i;
+  if (const Uint32* p = dpids_.find(dpid)) {
+    i = *p;
+    Record& r = records_[i];
+    if (r.sw)
+      r.sw->handle_ = Switch_handle{};
+    else
+      s.datapath() = std::move(r.dp);
+    r.dp = Datapath();
+    r.sw = &s;
+  } else {
+    if (free_.empty()) {
+      i = records_.size();
+      records_.emplace_back();
+      records_.back().generation = 0;
+    } else {
+      i = free_.back();
+      free_.pop_back();
+    }
+    Record& r = records_[i];
+    r.dpid = dpid;
+    r.sw = &s;
+    r.used = true;
+    dpids_.insert(dpid, i);
+  }
+  s.datapath().datapath_id = dpid;
+  s.handle_ = Switch_handle{i, records_[i].generation};
+  return s.handle_;
+}
+
+/// Dissociate the switch from its datapath. The datapath state is
+/// retained for a later reconnection. Switches that were never attached
+/// are ignored.
+void
+Switch_registry::detach(Switch& s) {
+  if (not record(s.handle_))
+    return;
+  Record& r = records_[s.handle_.index];
+  if (r.sw == &s) {
+    r.dp = std::move(s.datapath());
+    r.sw = nullptr;
+  }
+  s.handle_ = Switch_handle{};
+}
+
+/// Discard the record of a disconnected datapath, invalidating its
+/// handles. Returns false if the datapath is unknown or connected.
+bool
+Switch_registry::forget(Uint64 dpid) {
+  const Uint32* p = dpids_.find(dpid);
+  if (not p)
+    return false;
+  Uint32 i = *p;
+  Record& r = records_[i];
+  if (r.sw)
+    return false;
+  r.dp = Datapath();
+  r.used = false;
+  ++r.generation;
+  dpids_.erase(dpid);
+  free_.push_back(i);
+  return true;
+}
+
+/// Append the state of every known datapath to the list. The state of a
+/// connected datapath is held by its switch.
+void
+Switch_registry::datapaths(std::vector<const Datapath*>& out) const {
+  for (const Record& r : records_)
+    if (r.used)
+      out.push_back(r.sw ? &r.sw->datapath() : &r.dp);
+}
+
+} // namespace freeflow
@@ -0,0 +1,142 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_REGISTRY_HPP
+#define FREEFLOW_REGISTRY_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sdn/datapath.hpp>
+
+/// \file registry.hpp
+/// Lookup of connected switches.
+///
+/// The switch registry finds switches by their connection and by their
+/// datapath id. Each datapath that has connected is given a record, and
+/// applications can refer to the record by a Switch_handle. A handle
+/// remains valid across reconnections of the same datapath, so an
+/// application can hold a handle to a switch that is currently
+/// disconnected.
+///
+/// When a switch disconnects, the registry retains its Datapath state.
+/// If the same datapath reconnects, that state is given to the new
+/// switch instead of being rebuilt from scratch.
+
+namespace freeflow {
+
+struct Socket;
+class Switch;
+
+/// A Flat_index maps keys to values using open addressing with linear
+/// probing. Keys are integers or pointers. Deletion shifts later entries
+/// of a probe sequence backwards, so no tombstones accumulate.
+template<typename K, typename V>
+  class Flat_index {
+  public:
+    explicit Flat_index(std::size_t = 16);
+
+    // Observers
+    bool empty() const;
+    std::size_t size() const;
+
+    // Lookup
+    const V* find(K) const;
+    void values(std::vector<V>&) const;
+
+    // Mutators
+    bool insert(K, V);
+    bool erase(K);
+
+  private:
+    struct Slot {
+      K    key;
+      V    value;
+      bool used;
+    };
+
+    std::size_t home(K) const;
+    std::size_t lookup(K) const;
+    void place(const Slot&);
+    void rehash(std::size_t);
+
+    std::vector<Slot> slots_;
+    std::size_t       size_;
+    unsigned          shift_; // 64 - log2(capacity)
+  };
+
+/// A Switch_handle refers to the record of a datapath in the registry.
+/// The generation distinguishes records that reuse the same index.
+struct Switch_handle {
+  static constexpr Uint32 npos = Uint32(-1);
+
+  Switch_handle();
+  Switch_handle(Uint32, Uint32);
+
+  Uint32 index;
+  Uint32 generation;
+};
+
+// Equality comparison
+bool operator==(Switch_handle, Switch_handle);
+bool operator!=(Switch_handle, Switch_handle);
+
+/// The Switch_registry indexes switches by connection and by datapath
+/// id. It does not own switches.
+class Switch_registry {
+public:
+  // Observers
+  std::size_t connections() const;
+  std::size_t datapaths() const;
+
+  // Connections
+  bool insert(const Socket*, Switch*);
+  bool erase(const Socket*);
+  Switch* find(const Socket*) const;
+  void connected(std::vector<Switch*>&) const;
+
+  // Datapaths
+  Switch_handle attach(Switch&, Uint64);
+  void detach(Switch&);
+  bool forget(Uint64);
+  Switch_handle handle(Uint64) const;
+  Switch* find(Uint64) const;
+  Switch* find(Switch_handle) const;
+  void datapaths(std::vector<const Datapath*>&) const;
+
+private:
+  /// The record of a datapath. The datapath is retained while the
+  /// switch is disconnected.
+  struct Record {
+    Uint64   dpid;
+    Uint32   generation;
+    Switch*  sw;
+    Datapath dp;
+    bool     used;
+  };
+
+  const Record* record(Switch_handle) const;
+
+  std::vector<Record>                records_;
+  std::vector<Uint32>                free_;
+  Flat_index<Uint64, Uint32>         dpids_;
+  Flat_index<const Socket*, Switch*> conns_;
+};
+
+} // namespace freeflow
+
+#include <freeflow/sdn/registry.ipp>
+
+#endif
@@ -0,0 +1,241 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+namespace registry_impl {
+
+// Returns the integer value of an index key.
+inline Uint64
+key_bits(Uint64 k) { return k; }
+
+inline Uint64
+key_bits(const void* p) { return reinterpret_cast<std::uintptr_t>(p); }
+
+// Returns the base 2 logarithm of the smallest power of 2 not less
+// than n, with a minimum of 8 slots.
+inline unsigned
+log2_ceil(std::size_t n) {
+  unsigned k = 3;
+  while ((std::size_t(1) << k) < n)
+    ++k;
+  return k;
+}
+
+} // namespace registry_impl
+
+// -------------------------------------------------------------------------- //
+// Flat index
+
+/// Initialize the index with room for at least n slots.
+template<typename K, typename V>
+  Flat_index<K, V>::Flat_index(std::size_t n)
+    : slots_(std::size_t(1) << registry_impl::log2_ceil(n))
+    , size_(0)
+    , shift_(64 - registry_impl::log2_ceil(n))
+  { }
+
+template<typename K, typename V>
+  inline bool
+  Flat_index<K, V>::empty() const { return size_ == 0; }
+
+template<typename K, typename V>
+  inline std::size_t
+  Flat_index<K, V>::size() const { return size_; }
+
+/// Returns the value of the key k, or nullptr if k is not in the index.
+template<typename K, typename V>
+  inline const V*
+  Flat_index<K, V>::find(K k) const {
+    std::size_t i = lookup(k);
+    return i == std::size_t(-1) ? nullptr : &slots_[i].value;
+  }
+
+/// Append the value of every key in the index to the list, in no
+/// particular order.
+template<typename K, typename V>
+  inline void
+  Flat_index<K, V>::values(std::vector<V>& out) const {
+    for (const Slot& s : slots_)
+      if (s.used)
+        out.push_back(s.value);
+  }
+
+/// Insert the key k with the value v. Returns false, leaving the index
+/// unchanged, if k is already in the index. The index grows to keep
+/// the load factor at or below one half.
+template<typename K, typename V>
+  bool
+  Flat_index<K, V>::insert(K k, V v) {
+    if (lookup(k) != std::size_t(-1))
+      return false;
+    if (2 * (size_ + 1) > slots_.size())
+      rehash(2 * slots_.size());
+    place({k, v, true});
+    ++size_;
+    return true;
+  }
+
+/// Remove the key k. Returns false if k is not in the index.
+template<typename K, typename V>
+  bool
+  Flat_index<K, V>::erase(K k) {
+    std::size_t i = lookup(k);
+    if (i == std::size_t(-1))
+      return false;
+
+    // Shift later entries of the probe sequence into the hole, unless
+    // that would move them before their home slot.
+    std::size_t mask = slots_.size() - 1;
+    std::size_t j = i;
+    while (true) {
+      j = (j + 1) & mask;
+      if (not slots_[j].used)
+        break;
+      std::size_t h = home(slots_[j].key);
+      if (((j - h) & mask) >= ((j - i) & mask)) {
+        slots_[i] = slots_[j];
+        i = j;
+      }
+    }
+    slots_[i].used = false;
+    --size_;
+    return true;
+  }
+
+// Keys are scattered by Fibonacci hashing.
+template<typename K, typename V>
+  inline std::size_t
+  Flat_index<K, V>::home(K k) const {
+    return (registry_impl::key_bits(k) * 0x9e3779b97f4a7c15ull) >> shift_;
+  }
+
+template<typename K, typename V>
+  inline std::size_t
+  Flat_index<K, V>::lookup(K k) const {
+    std::size_t mask = slots_.size() - 1;
+    for (std::size_t i = home(k); slots_[i].used; i = (i + 1) & mask)
+      if (slots_[i].key == k)
+        return i;
+    return std::size_t(-1);
+  }
+
+template<typename K, typename V>
+  inline void
+  Flat_index<K, V>::place(const Slot& s) {
+    std::size_t mask = slots_.size() - 1;
+    std::size_t i = home(s.key);
+    while (slots_[i].used)
+      i = (i + 1) & mask;
+    slots_[i] = s;
+  }
+
+template<typename K, typename V>
+  void
+  Flat_index<K, V>::rehash(std::size_t n) {
+    std::vector<Slot> old(n);
+    old.swap(slots_);
+    shift_ = 64 - registry_impl::log2_ceil(n);
+    for (const Slot& s : old)
+      if (s.used)
+        place(s);
+  }
+
+// -------------------------------------------------------------------------- //
+// Switch handle
+
+/// Initialize an invalid handle.
+inline
+Switch_handle::Switch_handle() : index(npos), generation(0) { }
+
+inline
+Switch_handle::Switch_handle(Uint32 i, Uint32 g) : index(i), generation(g) { }
+
+inline bool
+operator==(Switch_handle a, Switch_handle b) {
+  return a.index == b.index and a.generation == b.generation;
+}
+
+inline bool
+operator!=(Switch_handle a, Switch_handle b) { return not (a == b); }
+
+// -------------------------------------------------------------------------- //
+// Switch registry
+
+/// Returns the number of connected switches.
+inline std::size_t
+Switch_registry::connections() const { return conns_.size(); }
+
+/// Returns the number of known datapaths, including those that are
+/// disconnected.
+inline std::size_t
+Switch_registry::datapaths() const { return dpids_.size(); }
+
+/// Register the switch connected by the socket s. Returns false if the
+/// connection is already registered.
+inline bool
+Switch_registry::insert(const Socket* s, Switch* sw) {
+  return conns_.insert(s, sw);
+}
+
+/// Remove the connection s.
+inline bool
+Switch_registry::erase(const Socket* s) { return conns_.erase(s); }
+
+/// Returns the switch connected by the socket s, or nullptr.
+inline Switch*
+Switch_registry::find(const Socket* s) const {
+  Switch* const* p = conns_.find(s);
+  return p ? *p : nullptr;
+}
+
+/// Append every connected switch to the list, whether or not its
+/// datapath has been identified.
+inline void
+Switch_registry::connected(std::vector<Switch*>& out) const {
+  conns_.values(out);
+}
+
+/// Returns the handle of the datapath with the given id. The handle is
+/// invalid if the datapath is unknown.
+inline Switch_handle
+Switch_registry::handle(Uint64 dpid) const {
+  const Uint32* i = dpids_.find(dpid);
+  return i ? Switch_handle{*i, records_[*i].generation} : Switch_handle{};
+}
+
+/// Returns the connected switch with the given datapath id, or nullptr.
+inline Switch*
+Switch_registry::find(Uint64 dpid) const {
+  const Uint32* i = dpids_.find(dpid);
+  return i ? records_[*i].sw : nullptr;
+}
+
+/// Returns the connected switch referred to by the handle, or nullptr
+/// if the handle is invalid or the switch is disconnected.
+inline Switch*
+Switch_registry::find(Switch_handle h) const {
+  const Record* r = record(h);
+  return r ? r->sw : nullptr;
+}
+
+inline const Switch_registry::Record*
+Switch_registry::record(Switch_handle h) const {
+  if (h.index >= records_.size())
+    return nullptr;
+  const Record& r = records_[h.index];
+  return r.used and r.generation == h.generation ? &r : nullptr;
+}
+
+} // namespace freeflow
@@ -0,0 +1,116 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/sdn/controller.hpp>
+#include <freeflow/sdn/switch.hpp>
+
+// Test lookup of switches by connection, datapath id and handle, that
+// datapath state survives a reconnection, and that the ports of a
+// switch whose features changed are discarded.
+
+using namespace freeflow;
+
+int main() {
+  Controller ctrl;
+  Socket s1;
+  Socket s2;
+
+  Switch& a = ctrl.connect(s1);
+  Switch& b = ctrl.connect(s2);
+  assert(ctrl.switches().connections() == 2);
+  assert(ctrl.switches().find(&s1) == &a);
+  assert(ctrl.switches().find(&s2) == &b);
+
+  // Switches are unknown until identified.
+  assert(ctrl.find_switch(Uint64(1)) == nullptr);
+  assert(ctrl.find_switch(a.handle()) == nullptr);
+
+  ctrl.identify(a, 1);
+  ctrl.identify(b, 2);
+  assert(ctrl.find_switch(Uint64(1)) == &a);
+  assert(ctrl.find_switch(Uint64(2)) == &b);
+  assert(ctrl.find_switch(a.handle()) == &a);
+  assert(a.datapath().datapath_id == 1);
+
+  // Disconnecting retains the datapath and its handle.
+  Switch_handle h = a.handle();
+  Port p = Port();
+  p.port_number = 3;
+  a.datapath().ports.insert(p);
+  ctrl.disconnect(a);
+  assert(ctrl.switches().connections() == 1);
+  assert(ctrl.switches().datapaths() == 2);
+  assert(ctrl.find_switch(Uint64(1)) == nullptr);
+  assert(ctrl.find_switch(h) == nullptr);
+
+  // Reconnecting restores the datapath state.
+  Switch& c = ctrl.connect(s1);
+  ctrl.identify(c, 1);
+  assert(c.handle() == h);
+  assert(ctrl.find_switch(h) == &c);
+  assert(c.datapath().ports.find(3) != nullptr);
+
+  // Forgetting a datapath invalidates its handles.
+  ctrl.disconnect(c);
+  assert(ctrl.switches().handle(1) == h);
+  Switch_registry& r = const_cast<Switch_registry&>(ctrl.switches());
+  assert(not r.forget(2));
+  assert(r.forget(1));
+  assert(r.handle(1) == Switch_handle{});
+  Switch& d = ctrl.connect(s1);
+  ctrl.identify(d, 1);
+  assert(d.handle() != h);
+  assert(ctrl.find_switch(h) == nullptr);
+  assert(d.datapath().ports.empty());
+
+  // A reconnection with the same feature reply keeps the ports.
+  assert(not ctrl.restore(d, 7));
+  d.datapath().ports.insert(p);
+  p.port_number = 4;
+  d.datapath().ports.insert(p);
+  d.datapath().state["app"] = Buffer(1, Byte(1));
+  ctrl.disconnect(d);
+  Switch& e = ctrl.connect(s1);
+  ctrl.identify(e, 1);
+  assert(ctrl.restore(e, 7));
+  assert(e.datapath().ports.size() == 2);
+
+  // A reconnection whose feature reply drops port 3 discards the old
+  // ports before the switch is configured, but keeps the application
+  // state.
+  ctrl.disconnect(e);
+  Switch& f = ctrl.connect(s1);
+  ctrl.identify(f, 1);
+  assert(not ctrl.restore(f, 8));
+  assert(f.datapath().ports.empty());
+  f.datapath().ports.insert(p);
+  assert(f.datapath().ports.find(3) == nullptr);
+  assert(f.datapath().ports.find(4) != nullptr);
+  assert(f.datapath().datapath_id == 1);
+  assert(f.datapath().fingerprint == 8);
+  assert(f.datapath().state.count("app") == 1);
+
+  // Many datapaths.
+  Socket ss[100];
+  for (Uint64 i = 0; i < 100; ++i)
+    ctrl.identify(ctrl.connect(ss[i]), 1000 + i);
+  for (Uint64 i = 0; i < 100; ++i)
+    assert(ctrl.find_switch(1000 + i)->datapath().datapath_id == 1000 + i);
+  for (Uint64 i = 0; i < 100; i += 2)
+    ctrl.disconnect(*ctrl.switches().find(&ss[i]));
+  for (Uint64 i = 0; i < 100; ++i)
+    assert((ctrl.find_switch(1000 + i) != nullptr) == (i % 2 == 1));
+}
@@ -15,7 +15,11 @@
 #ifndef FREEFLOW_REQUEST_HPP
 #define FREEFLOW_REQUEST_HPP
 
-#include <queue>
+#include <memory>
+
+#include <freeflow/sys/ring.hpp>
+#include <freeflow/sdn/transaction.hpp>
+#include <freeflow/sdn/packet.hpp>
 
 namespace freeflow {
 
@@ -24,7 +28,21 @@ class Application;
 /// Enumerates the types of application requests.
 enum class Request_type {
   DISCONNECT,
-  TERMINATE
+  TERMINATE,
+  STATS,
+  BARRIER,
+  RELEASE
+};
+
+/// The kinds of statistics that can be requested from a switch. Each
+/// request covers all flows, tables, ports or queues, as appropriate.
+enum class Stats_kind {
+  DESCRIPTION,
+  FLOW,
+  AGGREGATE,
+  TABLE,
+  PORT,
+  QUEUE
 };
 
 /// Represents a request to disconnect the switch.
@@ -38,13 +56,42 @@ struct Terminate_request {
 };
 
 
+/// Represents a request for statistics from the switch. The reply is
+/// delivered through the request's transaction.
+struct Stats_request {
+  static constexpr Request_type Kind = Request_type::STATS;
+
+  Stats_kind kind;
+};
+
+/// Represents a request for a barrier. The transaction completes when
+/// the switch has processed all previously sent messages.
+struct Barrier_request {
+  static constexpr Request_type Kind = Request_type::BARRIER;
+};
+
+/// Represents a request to release a pending flow. Any packets held for
+/// the flow are released according to the pending flow policy.
+struct Release_request {
+  static constexpr Request_type Kind = Request_type::RELEASE;
+
+  Packet_key key;
+};
+
+
 /// The request value is a union of different request types.
 union Request_data {
   Request_data(const Disconnect_request&);
   Request_data(const Terminate_request&);
+  Request_data(const Stats_request&);
+  Request_data(const Barrier_request&);
+  Request_data(const Release_request&);
 
   Disconnect_request disconnect;
   Terminate_request terminate;
+  Stats_request stats;
+  Barrier_request barrier;
+  Release_request release;
 };
 
 
@@ -54,19 +101,34 @@ struct Request {
   using Type = Request_type;
   static constexpr Type DISCONNECT = Type::DISCONNECT;
   static constexpr Type TERMINATE = Type::TERMINATE;
+  static constexpr Type STATS = Type::STATS;
+  static constexpr Type BARRIER = Type::BARRIER;
+  static constexpr Type RELEASE = Type::RELEASE;
 
   using Data = Request_data;
 
   template<typename T>
     Request(Application*, const T&);
 
+  template<typename T>
+    Request(Application*, const T&, std::shared_ptr<Transaction>);
+
   Application* app;   // The requesting pplication
   Type         type;  // The request type
   Data         data;  // Additional request data
+
+  std::shared_ptr<Transaction> txn; // The transaction, if any
 };
 
-/// The request queue stores requests from the application.
-using Request_queue = std::queue<Request>;
+/// The maximum number of requests that can be queued for a switch
+/// before it is serviced.
+constexpr std::size_t request_capacity = 256;
+
+/// The request queue stores requests from the applications. The queue
+/// has a fixed capacity and may be filled by an application thread while
+/// being drained by the controller thread. A full queue rejects new
+/// requests.
+using Request_queue = Ring<Request, request_capacity>;
 
 } // namespace freeflow
 
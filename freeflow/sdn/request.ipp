@@ -22,9 +22,26 @@ inline
 Request_data::Request_data(const Terminate_request& x)
   : terminate(x) { }
 
+inline
+Request_data::Request_data(const Stats_request& x)
+  : stats(x) { }
+
+inline
+Request_data::Request_data(const Barrier_request& x)
+  : barrier(x) { }
+
+inline
+Request_data::Request_data(const Release_request& x)
+  : release(x) { }
+
 template<typename T>
   inline
   Request::Request(Application* a, const T& x)
     : app(a), type(x.Kind), data(x) { }
 
+template<typename T>
+  inline
+  Request::Request(Application* a, const T& x, std::shared_ptr<Transaction> t)
+    : app(a), type(x.Kind), data(x), txn(std::move(t)) { }
+
 } // namespace freeflow
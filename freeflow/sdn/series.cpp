@@ -0,0 +1,287 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+#include <cassert>
+#include <initializer_list>
+
+#include "series.hpp"
+
+namespace freeflow {
+
+namespace {
+
+// Returns the microseconds since the epoch of t.
+inline Uint64
+micros(Time_point t) {
+  return std::chrono::duration_cast<Microseconds>(t.time_since_epoch()).count();
+}
+
+// Zigzag encoding maps signed values of small magnitude to small
+// unsigned values: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+inline Uint64
+zigzag(Uint64 n) { return (n << 1) ^ Uint64(Int64(n) >> 63); }
+
+inline Uint64
+unzigzag(Uint64 n) { return (n >> 1) ^ (~(n & 1) + 1); }
+
+// Append n to b in 7-bit groups, least significant first.
+inline void
+put_varint(Buffer& b, Uint64 n) {
+  while (n >= 0x80) {
+    b.push_back(Byte(n | 0x80));
+    n >>= 7;
+  }
+  b.push_back(Byte(n));
+}
+
+// Read a varint from p, advancing p.
+inline Uint64
+get_varint(const Byte*& p, const Byte* last) {
+  Uint64 n = 0;
+  for (unsigned s = 0; p != last; s += 7) {
+    Byte b = *p++;
+    n |= Uint64(b & 0x7f) << s;
+    if (not (b & 0x80))
+      break;
+  }
+  return n;
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------- //
+// Column
+
+/// Read the next value into v. Returns false if there are no more
+/// values.
+bool
+Column::Reader::next(Uint64& v) {
+  if (p_ == last_)
+    return false;
+  Uint64 n = get_varint(p_, last_);
+  if (i_ == 0) {
+    value_ = n;
+  } else {
+    if (i_ == 1)
+      delta_ = unzigzag(n);
+    else
+      delta_ += unzigzag(n);
+    value_ += delta_;
+  }
+  ++i_;
+  v = value_;
+  return true;
+}
+
+/// Append the value n to the column.
+void
+Column::append(Uint64 n) {
+  if (size_ == 0) {
+    put_varint(data_, n);
+  } else {
+    Uint64 d = n - value_;
+    put_varint(data_, zigzag(size_ == 1 ? d : d - delta_));
+    delta_ = d;
+  }
+  value_ = n;
+  ++size_;
+}
+
+// -------------------------------------------------------------------------- //
+// Counter series
+
+/// Create a series of samples of n counters, stored in blocks of b
+/// samples.
+Counter_series::Counter_series(std::size_t n, std::size_t b)
+  : columns_(n), block_(b ? b : 1), size_(0), first_(0) { }
+
+/// Returns the number of bytes used to encode the series.
+std::size_t
+Counter_series::bytes() const {
+  std::size_t n = 0;
+  for (const Block& b : blocks_) {
+    n += b.time.bytes();
+    for (const Column& c : b.values)
+      n += c.bytes();
+  }
+  return n;
+}
+
+/// Append a sample taken at time t. The values of the counters are
+/// read from v. Samples must be appended in order of time.
+void
+Counter_series::append(Time_point t, const Uint64* v) {
+  if (blocks_.empty() or blocks_.back().time.size() == block_) {
+    if (not blocks_.empty()) {
+      Block& b = blocks_.back();
+      b.time.shrink();
+      for (Column& c : b.values)
+        c.shrink();
+    }
+    blocks_.emplace_back();
+    blocks_.back().values.resize(columns_);
+  }
+  Block& b = blocks_.back();
+  Uint64 us = micros(t);
+  assert(size_ == 0 or us >= b.time.back());
+  b.time.append(us);
+  for (std::size_t i = 0; i < columns_; ++i)
+    b.values[i].append(v[i]);
+  if (size_++ == 0)
+    first_ = us;
+}
+
+/// Discard the blocks whose samples are all older than t.
+void
+Counter_series::expire(Time_point t) {
+  Uint64 us = micros(t);
+  while (not blocks_.empty() and blocks_.front().time.back() < us) {
+    size_ -= blocks_.front().time.size();
+    blocks_.pop_front();
+  }
+  if (not blocks_.empty()) {
+    Column::Reader r(blocks_.front().time);
+    r.next(first_);
+  }
+}
+
+/// Call f(dt, dv) for each pair of successive samples of the nth counter
+/// within the window [from, to], where dt is the time in microseconds
+/// between them and dv is the increase of the counter. Blocks outside
+/// the window are skipped without being decoded.
+template<typename F>
+  void
+  Counter_series::scan(std::size_t n, Time_point from, Time_point to, 
+                       F f) const {
+    assert(n < columns_);
+    Uint64 lo = micros(from);
+    Uint64 hi = micros(to);
+    bool prev = false;
+    Uint64 pt = 0;
+    Uint64 pv = 0;
+    for (const Block& b : blocks_) {
+      if (b.time.back() < lo)
+        continue;
+      Column::Reader tr(b.time);
+      Column::Reader vr(b.values[n]);
+      Uint64 t;
+      Uint64 v;
+      while (tr.next(t) and vr.next(v)) {
+        if (t < lo)
+          continue;
+        if (t > hi)
+          return;
+        if (prev)
+          f(t - pt, v >= pv ? v - pv : v);
+        prev = true;
+        pt = t;
+        pv = v;
+      }
+    }
+  }
+
+/// Returns the average rate of increase per second of the nth counter
+/// over the samples within the window [from, to]. Returns 0 if the
+/// window holds fewer than two samples.
+double
+Counter_series::rate(std::size_t n, Time_point from, Time_point to) const {
+  Uint64 dt = 0;
+  Uint64 dv = 0;
+  scan(n, from, to, [&](Uint64 t, Uint64 v) {
+    dt += t;
+    dv += v;
+  });
+  return dt ? dv * 1e6 / dt : 0;
+}
+
+/// Returns the qth quantile, for q in [0, 1], of the per-second rates of
+/// the nth counter between successive samples within the window [from,
+/// to]. Returns 0 if the window holds fewer than two samples.
+double
+Counter_series::percentile(std::size_t n, Time_point from, Time_point to, 
+                           double q) const {
+  std::vector<double> rates;
+  scan(n, from, to, [&rates](Uint64 t, Uint64 v) {
+    rates.push_back(t ? v * 1e6 / t : 0);
+  });
+  if (rates.empty())
+    return 0;
+  q = std::min(1.0, std::max(0.0, q));
+  auto i = rates.begin() + std::size_t(q * (rates.size() - 1) + 0.5);
+  std::nth_element(rates.begin(), i, rates.end());
+  return *i;
+}
+
+// -------------------------------------------------------------------------- //
+// Counter store
+
+/// Create a store that keeps samples for the given duration, in blocks
+/// of b samples.
+Counter_store::Counter_store(Microseconds r, std::size_t b)
+  : retention_(r), block_(b) { }
+
+/// Returns the number of bytes used to encode every series.
+std::size_t
+Counter_store::bytes() const {
+  std::size_t n = 0;
+  for (const auto& x : ports_)
+    n += x.second.bytes();
+  for (const auto& x : flows_)
+    n += x.second.bytes();
+  return n;
+}
+
+/// Returns the series of the port, or nullptr if there is none.
+const Counter_series*
+Counter_store::port(Uint64 k) const {
+  auto iter = ports_.find(k);
+  return iter == ports_.end() ? nullptr : &iter->second;
+}
+
+/// Returns the series of the flow, or nullptr if there is none.
+const Counter_series*
+Counter_store::flow(Uint64 k) const {
+  auto iter = flows_.find(k);
+  return iter == flows_.end() ? nullptr : &iter->second;
+}
+
+/// Discard samples older than the retention period before t. Series
+/// left with no samples, such as those of removed flows, are discarded.
+void
+Counter_store::expire(Time_point t) {
+  Time_point cutoff = t - retention_;
+  for (Series_map* m : {&ports_, &flows_}) {
+    for (auto iter = m->begin(); iter != m->end(); ) {
+      iter->second.expire(cutoff);
+      if (iter->second.empty())
+        iter = m->erase(iter);
+      else
+        ++iter;
+    }
+  }
+}
+
+// Record a sample of n counters in the series k of m, creating the
+// series if needed.
+void
+Counter_store::add(Series_map& m, std::size_t n, Uint64 k, Time_point t, 
+                   const Uint64* v) {
+  auto iter = m.find(k);
+  if (iter == m.end())
+    iter = m.emplace(k, Counter_series(n, block_)).first;
+  iter->second.append(t, v);
+}
+
+} // namespace freeflow
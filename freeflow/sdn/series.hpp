@@ -0,0 +1,181 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_SERIES_HPP
+#define FREEFLOW_SERIES_HPP
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/time.hpp>
+#include <freeflow/sys/buffer.hpp>
+
+/// \file series.hpp
+/// Compressed history of switch counters.
+///
+/// Port and flow counters are sampled by the stats poller and kept so
+/// that rates can be computed over past windows. Successive samples of a
+/// counter differ by similar amounts, so each counter is stored as the
+/// difference between successive deltas (the delta-of-delta), zigzag and
+/// varint encoded. A counter that grows steadily, and a timestamp that
+/// advances by a nearly constant interval, costs one byte per sample
+/// rather than eight.
+///
+/// A series stores several counters of one port or flow. Its samples
+/// are kept in blocks of fixed size, and each block stores its
+/// timestamps and each of its counters in separate columns. A query
+/// decodes only the blocks that overlap its window, and only the columns
+/// that it needs. Expiry discards whole blocks.
+
+namespace freeflow {
+
+/// The counters of a port series.
+enum class Port_counter : std::size_t {
+  RX_PACKETS, TX_PACKETS, RX_BYTES, TX_BYTES,
+  RX_DROPPED, TX_DROPPED, RX_ERRORS, TX_ERRORS,
+  COUNT
+};
+
+/// The counters of a flow series.
+enum class Flow_counter : std::size_t {
+  PACKETS, BYTES,
+  COUNT
+};
+
+/// A Column is a delta-of-delta encoded sequence of 64-bit integers.
+/// The first value is stored as is, the second as its difference from
+/// the first, and each later value as the change in that difference.
+/// Arithmetic wraps, so any sequence of values is represented exactly.
+class Column {
+public:
+  /// A Reader decodes the values of a column in order.
+  class Reader {
+  public:
+    explicit Reader(const Column&);
+
+    bool next(Uint64&);
+
+  private:
+    const Byte* p_;
+    const Byte* last_;
+    std::size_t i_;
+    Uint64      value_;
+    Uint64      delta_;
+  };
+
+  Column();
+
+  // Observers
+  std::size_t size() const;
+  std::size_t bytes() const;
+  Uint64 back() const;
+
+  // Mutators
+  void append(Uint64);
+  void shrink();
+
+private:
+  Buffer      data_;
+  std::size_t size_;
+  Uint64      value_; // The last value
+  Uint64      delta_; // The difference between the last two values
+};
+
+/// A Counter_series holds the samples of a fixed number of counters.
+/// The times of samples are kept to the microsecond.
+/// Counter values are unsigned and may wrap or be reset by the switch;
+/// a decrease is taken to be a reset, after which the counter counted
+/// up from zero.
+class Counter_series {
+public:
+  explicit Counter_series(std::size_t, std::size_t = 128);
+
+  // Observers
+  bool empty() const;
+  std::size_t columns() const;
+  std::size_t size() const;
+  std::size_t bytes() const;
+  Time_point first() const;
+  Time_point last() const;
+
+  // Mutators
+  void append(Time_point, const Uint64*);
+  void expire(Time_point);
+
+  // Queries
+  Uint64 latest(std::size_t) const;
+  double rate(std::size_t, Time_point, Time_point) const;
+  double percentile(std::size_t, Time_point, Time_point, double) const;
+
+private:
+  struct Block {
+    Column              time;
+    std::vector<Column> values;
+  };
+
+  template<typename F>
+    void scan(std::size_t, Time_point, Time_point, F) const;
+
+  std::size_t       columns_;
+  std::size_t       block_;  // Samples per block
+  std::deque<Block> blocks_;
+  std::size_t       size_;
+  Uint64            first_;  // The first timestamp, in microseconds
+};
+
+/// A Counter_store holds the port and flow series of one switch. Ports
+/// are keyed by port number and flows by a key chosen by the caller,
+/// usually a hash of the flow's table, priority and match.
+class Counter_store {
+public:
+  using Series_map = std::unordered_map<Uint64, Counter_series>;
+
+  explicit Counter_store(Microseconds = 1_h, std::size_t = 128);
+
+  // Configuration
+  Microseconds retention() const;
+
+  // Observers
+  std::size_t bytes() const;
+  const Series_map& ports() const;
+  const Series_map& flows() const;
+
+  // Lookup
+  const Counter_series* port(Uint64) const;
+  const Counter_series* flow(Uint64) const;
+
+  // Ingestion
+  void add_port(Uint64, Time_point, const Uint64*);
+  void add_flow(Uint64, Time_point, const Uint64*);
+
+  // Expiry
+  void expire(Time_point);
+  void clear();
+
+private:
+  void add(Series_map&, std::size_t, Uint64, Time_point, const Uint64*);
+
+  Microseconds retention_; // How long samples are kept
+  std::size_t  block_;     // Samples per block of each series
+  Series_map   ports_;
+  Series_map   flows_;
+};
+
+} // namespace freeflow
+
+#include <freeflow/sdn/series.ipp>
+
+#endif
@@ -0,0 +1,116 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+// -------------------------------------------------------------------------- //
+// Column
+
+inline
+Column::Reader::Reader(const Column& c)
+  : p_(c.data_.data()), last_(c.data_.data() + c.data_.size()), i_(0),
+    value_(0), delta_(0) { }
+
+inline
+Column::Column() : size_(0), value_(0), delta_(0) { }
+
+/// Returns the number of values in the column.
+inline std::size_t
+Column::size() const { return size_; }
+
+/// Returns the number of bytes used to encode the column.
+inline std::size_t
+Column::bytes() const { return data_.size(); }
+
+/// Returns the last value in the column. Behavior is undefined if the
+/// column is empty.
+inline Uint64
+Column::back() const { return value_; }
+
+/// Release the unused capacity of the column. This is done when the
+/// column will not grow further.
+inline void
+Column::shrink() { data_.shrink_to_fit(); }
+
+// -------------------------------------------------------------------------- //
+// Counter series
+
+/// Returns true if the series has no samples.
+inline bool
+Counter_series::empty() const { return size_ == 0; }
+
+/// Returns the number of counters in each sample.
+inline std::size_t
+Counter_series::columns() const { return columns_; }
+
+/// Returns the number of samples in the series.
+inline std::size_t
+Counter_series::size() const { return size_; }
+
+/// Returns the time of the first sample. Behavior is undefined if the
+/// series is empty.
+inline Time_point
+Counter_series::first() const { return Time_point(Microseconds(first_)); }
+
+/// Returns the time of the last sample. Behavior is undefined if the
+/// series is empty.
+inline Time_point
+Counter_series::last() const {
+  return Time_point(Microseconds(blocks_.back().time.back()));
+}
+
+/// Returns the last value of the nth counter. Behavior is undefined if
+/// the series is empty.
+inline Uint64
+Counter_series::latest(std::size_t n) const {
+  return blocks_.back().values[n].back();
+}
+
+// -------------------------------------------------------------------------- //
+// Counter store
+
+/// Returns the duration for which samples are kept.
+inline Microseconds
+Counter_store::retention() const { return retention_; }
+
+/// Returns the series of each port.
+inline const Counter_store::Series_map&
+Counter_store::ports() const { return ports_; }
+
+/// Returns the series of each flow.
+inline const Counter_store::Series_map&
+Counter_store::flows() const { return flows_; }
+
+/// Record a sample of the port's counters, which are given in the order
+/// of Port_counter.
+inline void
+Counter_store::add_port(Uint64 k, Time_point t, const Uint64* v) {
+  add(ports_, std::size_t(Port_counter::COUNT), k, t, v);
+}
+
+/// Record a sample of the flow's counters, which are given in the order
+/// of Flow_counter.
+inline void
+Counter_store::add_flow(Uint64 k, Time_point t, const Uint64* v) {
+  add(flows_, std::size_t(Flow_counter::COUNT), k, t, v);
+}
+
+/// Discard every series.
+inline void
+Counter_store::clear() {
+  ports_.clear();
+  flows_.clear();
+}
+
+} // namespace freeflow
@@ -0,0 +1,118 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <freeflow/sdn/series.hpp>
+
+// Test that columns reproduce their values exactly, that steady
+// counters are stored compactly, that rates and percentiles are
+// computed over windows, and that old samples expire.
+
+using namespace freeflow;
+
+bool near(double a, double b) { return std::abs(a - b) < 1e-6; }
+
+int main() {
+  // Arbitrary values, including wrapping differences, round-trip.
+  {
+    std::mt19937_64 gen(7);
+    std::vector<Uint64> xs {0, ~Uint64(0), 1, Uint64(1) << 63, 5, 5, 5};
+    for (int i = 0; i < 1000; ++i)
+      xs.push_back(gen() >> (gen() % 64));
+    Column c;
+    for (Uint64 x : xs)
+      c.append(x);
+    assert(c.size() == xs.size());
+    assert(c.back() == xs.back());
+
+    Column::Reader r(c);
+    Uint64 x;
+    for (Uint64 y : xs) {
+      assert(r.next(x));
+      assert(x == y);
+    }
+    assert(not r.next(x));
+  }
+
+  // Times are kept to the microsecond.
+  Time_point t0(std::chrono::duration_cast<Microseconds>(
+    now().time_since_epoch()));
+  Time_point t = t0;
+  Uint64 v[2];
+
+  // A counter sampled every second that grows by 100 per second takes
+  // a few bytes per sample across its two columns.
+  Counter_series s(2, 16);
+  for (int i = 0; i <= 100; ++i) {
+    v[0] = 1000 + i * 100;
+    v[1] = i < 50 ? i * 10 : (i - 50) * 30;
+    s.append(t0 + Seconds(i), v);
+  }
+  assert(s.size() == 101);
+  assert(s.latest(0) == 1000 + 100 * 100);
+  assert(s.bytes() < 101 * 4);
+
+  // Rates are per second, over the samples within the window. The
+  // second counter was reset at 50s and counts from zero.
+  assert(near(s.rate(0, t0, t0 + Seconds(100)), 100));
+  assert(near(s.rate(0, t0 + Seconds(20), t0 + Seconds(30)), 100));
+  assert(near(s.rate(1, t0, t0 + Seconds(49)), 10));
+  assert(near(s.rate(1, t0 + Seconds(51), t0 + Seconds(100)), 30));
+  assert(near(s.rate(1, t0 + Seconds(49), t0 + Seconds(50)), 0));
+  assert(near(s.rate(0, t0 + Seconds(200), t0 + Seconds(300)), 0));
+
+  // Percentiles are taken over the rates between successive samples.
+  assert(near(s.percentile(1, t0, t0 + Seconds(100), 0), 0));
+  assert(near(s.percentile(1, t0, t0 + Seconds(100), 0.25), 10));
+  assert(near(s.percentile(1, t0, t0 + Seconds(100), 1), 30));
+  assert(near(s.percentile(0, t0, t0 + Seconds(100), 0.99), 100));
+
+  // Expiry discards whole blocks older than the cutoff.
+  s.expire(t0 + Seconds(40));
+  assert(s.size() < 101 and s.size() > 100 - 40);
+  assert(s.first() <= t0 + Seconds(40));
+  assert(s.first() > t0 + Seconds(40 - 16));
+  assert(s.last() == t0 + Seconds(100));
+  s.expire(t0 + Seconds(101));
+  assert(s.empty());
+
+  // The store keeps a series per port and flow, and discards series
+  // whose samples have all expired.
+  Counter_store cs(10_s, 4);
+  Uint64 p[std::size_t(Port_counter::COUNT)] = { };
+  Uint64 f[std::size_t(Flow_counter::COUNT)] = { };
+  for (int i = 0; i < 20; ++i) {
+    t = t0 + Seconds(i);
+    p[std::size_t(Port_counter::RX_PACKETS)] += 5;
+    cs.add_port(1, t, p);
+    if (i < 5)
+      cs.add_flow(42, t, f);
+  }
+  assert(cs.port(1) and not cs.port(2));
+  assert(cs.flow(42));
+  assert(cs.port(1)->columns() == std::size_t(Port_counter::COUNT));
+  assert(near(cs.port(1)->rate(0, t0, t), 5));
+  assert(cs.bytes() > 0);
+
+  cs.expire(t);
+  assert(cs.port(1));
+  assert(not cs.flow(42));
+  assert(cs.flows().empty());
+  cs.clear();
+  assert(cs.ports().empty());
+}
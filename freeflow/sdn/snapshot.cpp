@@ -0,0 +1,439 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "snapshot.hpp"
+
+namespace freeflow {
+
+namespace {
+
+// Identifies snapshot files.
+constexpr char magic[8] = { 'F', 'F', 'S', 'N', 'A', 'P', 'S', 'H' };
+
+// Written in host byte order. A file from a host of the other byte
+// order reads this backwards.
+constexpr Uint32 byte_order = 0x01020304;
+
+// The file header.
+struct Header {
+  char   magic[8];
+  Uint32 version;
+  Uint32 order;
+  Uint64 count; // The number of records
+  Uint64 size;  // The size of the file
+};
+
+// Appends fixed-width values and length-prefixed strings to a buffer.
+struct Writer {
+  Writer(Buffer& b) : buf(b) { }
+
+  template<typename T>
+    void put(T x) { bytes(&x, sizeof(T)); }
+
+  void bytes(const void* p, std::size_t n) {
+    const Byte* b = static_cast<const Byte*>(p);
+    buf.insert(buf.end(), b, b + n);
+  }
+
+  void string(const std::string& s) {
+    put<Uint32>(s.size());
+    bytes(s.data(), s.size());
+  }
+
+  Buffer& buf;
+};
+
+// Reads values written by a Writer. Reading past the end of the record
+// fails, and every later read fails as well.
+struct Reader {
+  Reader(const Byte* p, std::size_t n) : first(p), last(p + n), ok(true) { }
+
+  template<typename T>
+    T get() {
+      T x = T();
+      bytes(&x, sizeof(T));
+      return x;
+    }
+
+  bool bytes(void* p, std::size_t n) {
+    if (not ok or std::size_t(last - first) < n)
+      return ok = false;
+    std::memcpy(p, first, n);
+    first += n;
+    return true;
+  }
+
+  bool view(const Byte*& p, std::size_t n) {
+    if (not ok or std::size_t(last - first) < n)
+      return ok = false;
+    p = first;
+    first += n;
+    return true;
+  }
+
+  std::string string() {
+    const Byte* p;
+    std::size_t n = get<Uint32>();
+    if (not view(p, n))
+      return std::string();
+    return std::string(reinterpret_cast<const char*>(p), n);
+  }
+
+  const Byte* first;
+  const Byte* last;
+  bool        ok;
+};
+
+void
+put_features(Writer& w, const Port::Features& f) {
+  w.put<Int32>(f.speed);
+  w.put<Uint8>(f.mode);
+  w.put<Uint8>(f.medium);
+  w.put<Uint8>(f.auto_neg | f.pause << 1 | f.pause_asym << 2);
+}
+
+void
+get_features(Reader& r, Port::Features& f) {
+  f.speed = r.get<Int32>();
+  f.mode = Port::Mode(r.get<Uint8>());
+  f.medium = Port::Medium(r.get<Uint8>());
+  Uint8 flags = r.get<Uint8>();
+  f.auto_neg = flags & 1;
+  f.pause = flags & 2;
+  f.pause_asym = flags & 4;
+}
+
+// Ports do not save their queues or packet counters.
+void
+put_ports(Writer& w, const Ports& ps) {
+  w.put<Uint8>(ps.all | ps.controller << 1 | ps.local << 2 | ps.table << 3 
+               | ps.in_port << 4 | ps.normal << 5 | ps.flood << 6 
+               | ps.none << 7);
+  w.put<Uint32>(ps.size());
+  for (const Port& p : ps) {
+    const Port_status* s = ps.status(p.port_number);
+    w.put<Uint32>(p.port_number);
+    w.bytes(p.hw_addr.addr, 6);
+    w.string(p.name.str());
+    put_features(w, p.current);
+    put_features(w, p.advertised);
+    put_features(w, p.supported);
+    put_features(w, p.peer);
+    w.put<Uint32>(s->config);
+    w.put<Uint32>(s->state);
+  }
+}
+
+void
+get_ports(Reader& r, Ports& ps) {
+  Uint8 flags = r.get<Uint8>();
+  ps.all = flags & 1;
+  ps.controller = flags & 2;
+  ps.local = flags & 4;
+  ps.table = flags & 8;
+  ps.in_port = flags & 16;
+  ps.normal = flags & 32;
+  ps.flood = flags & 64;
+  ps.none = flags & 128;
+  Uint32 n = r.get<Uint32>();
+  for (Uint32 i = 0; i < n and r.ok; ++i) {
+    Port p = Port();
+    p.port_number = r.get<Uint32>();
+    r.bytes(p.hw_addr.addr, 6);
+    p.name = Symbol(r.string());
+    get_features(r, p.current);
+    get_features(r, p.advertised);
+    get_features(r, p.supported);
+    get_features(r, p.peer);
+    Uint32 config = r.get<Uint32>();
+    Uint32 state = r.get<Uint32>();
+    if (not r.ok)
+      return;
+    ps.insert(p);
+    Port_status* s = ps.status(p.port_number);
+    s->config = config;
+    s->state = state;
+  }
+}
+
+void
+put_tables(Writer& w, const Flow_tables& ts) {
+  w.put<Uint32>(ts.size());
+  for (const auto& t : ts) {
+    w.put<Int32>(t.first);
+    w.string(t.second.name);
+    w.put<Uint32>(t.second.size());
+    for (const auto& f : t.second) {
+      w.put<Uint64>(f.first.word(0));
+      w.put<Uint64>(f.second.word(0));
+    }
+  }
+}
+
+void
+get_tables(Reader& r, Flow_tables& ts) {
+  Uint32 n = r.get<Uint32>();
+  for (Uint32 i = 0; i < n and r.ok; ++i) {
+    int id = r.get<Int32>();
+    Flow_table& t = ts[id];
+    t.flowtable_id = id;
+    t.name = r.string();
+    Uint32 m = r.get<Uint32>();
+    for (Uint32 j = 0; j < m and r.ok; ++j) {
+      Match match(r.get<Uint64>());
+      Action action(r.get<Uint64>());
+      t.emplace(match, action);
+    }
+  }
+}
+
+void
+put_state(Writer& w, const Datapath::App_state& s) {
+  w.put<Uint32>(s.size());
+  for (const auto& x : s) {
+    w.string(x.first);
+    w.put<Uint32>(x.second.size());
+    w.bytes(x.second.data(), x.second.size());
+  }
+}
+
+void
+get_state(Reader& r, Datapath::App_state& s) {
+  Uint32 n = r.get<Uint32>();
+  for (Uint32 i = 0; i < n and r.ok; ++i) {
+    std::string name = r.string();
+    const Byte* p;
+    if (r.view(p, r.get<Uint32>()))
+      s[name] = Buffer(p, r.first);
+  }
+}
+
+// Encode the datapath, excluding its packet buffers, which do not
+// survive a restart.
+void
+put_datapath(Writer& w, const Datapath& dp) {
+  w.put<Uint64>(dp.capabilities.word(0));
+  w.put<Uint64>(dp.match.word(0));
+  w.put<Uint64>(dp.actions.word(0));
+  w.string(dp.mfr_desc);
+  w.string(dp.hw_desc);
+  w.string(dp.sw_desc);
+  w.string(dp.serial_num);
+  w.string(dp.dp_desc);
+  put_ports(w, dp.ports);
+  put_tables(w, dp.flow_tables);
+  put_state(w, dp.state);
+}
+
+bool
+get_datapath(Reader& r, Datapath& dp) {
+  dp.capabilities = Capabilities(r.get<Uint64>());
+  dp.match = Match(r.get<Uint64>());
+  dp.actions = Action(r.get<Uint64>());
+  dp.mfr_desc = r.string();
+  dp.hw_desc = r.string();
+  dp.sw_desc = r.string();
+  dp.serial_num = r.string();
+  dp.dp_desc = r.string();
+  get_ports(r, dp.ports);
+  get_tables(r, dp.flow_tables);
+  get_state(r, dp.state);
+  return r.ok and r.first == r.last;
+}
+
+} // namespace
+
+constexpr Uint32 Snapshot::version;
+
+/// Returns the FNV-1a hash of the n bytes at p. The hash of a feature
+/// reply, excluding its header, identifies the configuration of a
+/// datapath.
+Uint64
+fingerprint(const Byte* p, std::size_t n) {
+  Uint64 h = 0xcbf29ce484222325;
+  for (std::size_t i = 0; i < n; ++i) {
+    h ^= p[i];
+    h *= 0x100000001b3;
+  }
+  return h;
+}
+
+/// The directory entry of a record. The checksum is the fingerprint of
+/// the record's bytes.
+struct Snapshot::Entry {
+  Uint64 dpid;
+  Uint64 fingerprint;
+  Uint64 offset;
+  Uint64 length;
+  Uint64 checksum;
+};
+
+/// Map the snapshot file at the path. Returns false, leaving the
+/// snapshot empty, if the file cannot be mapped or is not a snapshot
+/// of this version. Records are validated when they are restored.
+bool
+Snapshot::open(const std::string& path) {
+  close();
+  try {
+    map_ = Mapping(path);
+  } catch (Error&) {
+    return false;
+  }
+
+  Header h;
+  if (map_.size() < sizeof(Header)) {
+    close();
+    return false;
+  }
+  std::memcpy(&h, map_.data(), sizeof(Header));
+  if (std::memcmp(h.magic, magic, sizeof(magic)) != 0 
+      or h.version != version or h.order != byte_order
+      or h.size != map_.size()
+      or h.count > (h.size - sizeof(Header)) / sizeof(Entry)) {
+    close();
+    return false;
+  }
+  count_ = h.count;
+  return true;
+}
+
+/// Unmap the snapshot file.
+void
+Snapshot::close() {
+  map_.unmap();
+  count_ = 0;
+}
+
+/// Returns true if the snapshot has a record of the datapath.
+bool
+Snapshot::contains(Uint64 dpid) const {
+  Entry e;
+  return entry(dpid, e);
+}
+
+/// If the snapshot has a valid record of the datapath with the given
+/// fingerprint, decode it into dp and return true. Otherwise, dp is
+/// unchanged. The datapath's id and packet buffers are not affected.
+bool
+Snapshot::restore(Uint64 dpid, Uint64 fp, Datapath& dp) const {
+  Entry e;
+  if (not entry(dpid, e) or e.fingerprint != fp)
+    return false;
+  if (e.offset > map_.size() or e.length > map_.size() - e.offset)
+    return false;
+  const Byte* p = map_.data() + e.offset;
+  if (fingerprint(p, e.length) != e.checksum)
+    return false;
+
+  Datapath x;
+  Reader r(p, e.length);
+  if (not get_datapath(r, x))
+    return false;
+  x.datapath_id = dp.datapath_id;
+  x.buffers = std::move(dp.buffers);
+  x.fingerprint = fp;
+  dp = std::move(x);
+  return true;
+}
+
+// Find the directory entry of the datapath by binary search.
+bool
+Snapshot::entry(Uint64 dpid, Entry& e) const {
+  const Byte* dir = map_.data() + sizeof(Header);
+  std::size_t lo = 0;
+  std::size_t hi = count_;
+  while (lo < hi) {
+    std::size_t mid = lo + (hi - lo) / 2;
+    std::memcpy(&e, dir + mid * sizeof(Entry), sizeof(Entry));
+    if (e.dpid == dpid)
+      return true;
+    if (e.dpid < dpid)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return false;
+}
+
+/// Encode the datapath as a record. A datapath that was never
+/// configured from a feature reply cannot be validated, so it is not
+/// saved.
+void
+Snapshot_writer::add(const Datapath& dp) {
+  if (dp.fingerprint == 0)
+    return;
+  Record r {dp.datapath_id, Buffer(), dp.fingerprint};
+  Writer w(r.data);
+  put_datapath(w, dp);
+  records_.push_back(std::move(r));
+}
+
+/// Returns the contents of the snapshot file.
+Buffer
+Snapshot_writer::image() const {
+  std::vector<const Record*> rs;
+  for (const Record& r : records_)
+    rs.push_back(&r);
+  std::sort(rs.begin(), rs.end(), [](const Record* a, const Record* b) {
+    return a->dpid < b->dpid;
+  });
+
+  Buffer b;
+  Writer w(b);
+  Header h;
+  std::memcpy(h.magic, magic, sizeof(magic));
+  h.version = Snapshot::version;
+  h.order = byte_order;
+  h.count = rs.size();
+  h.size = sizeof(Header) + rs.size() * sizeof(Snapshot::Entry);
+  Uint64 offset = h.size;
+  for (const Record* r : rs)
+    h.size += r->data.size();
+  w.put(h);
+
+  for (const Record* r : rs) {
+    Snapshot::Entry e { 
+      r->dpid, r->fingerprint, offset, r->data.size(), 
+      fingerprint(r->data.data(), r->data.size())
+    };
+    w.put(e);
+    offset += r->data.size();
+  }
+  for (const Record* r : rs)
+    w.bytes(r->data.data(), r->data.size());
+  return b;
+}
+
+/// Write the snapshot file at the path. The file is written under a
+/// temporary name and renamed into place, so a mapped or partially
+/// written snapshot is never observed. Returns false on failure.
+bool
+Snapshot_writer::write(const std::string& path) const {
+  std::string tmp = path + ".tmp";
+  Buffer b = image();
+  {
+    std::ofstream os(tmp, std::ios::binary | std::ios::trunc);
+    os.write(reinterpret_cast<const char*>(b.data()), b.size());
+    if (not os.flush())
+      return false;
+  }
+  return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+} // namespace freeflow
@@ -0,0 +1,111 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_SNAPSHOT_HPP
+#define FREEFLOW_SNAPSHOT_HPP
+
+#include <string>
+#include <vector>
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/buffer.hpp>
+#include <freeflow/sys/mapping.hpp>
+#include <freeflow/sdn/datapath.hpp>
+
+/// \file snapshot.hpp
+/// Datapath state saved across controller restarts.
+///
+/// When the controller restarts, every switch reconnects and would
+/// normally be rediscovered from scratch. A snapshot saves the state of
+/// each known datapath, including the state that applications store in
+/// it, to a binary file. At startup the file is mapped rather than read,
+/// and a switch's record is decoded only when that switch reconnects.
+///
+/// Each record carries a fingerprint of the feature reply that
+/// configured the datapath. A reconnecting switch whose feature reply
+/// has the same fingerprint is unchanged, so its saved state is
+/// restored and reconfiguration is skipped. Any other switch is
+/// configured as usual.
+///
+/// The file begins with a header, followed by a directory of records
+/// sorted by datapath id, followed by the records. Integers are stored
+/// in host byte order; files written on a host of another byte order
+/// are rejected, as are files of another version.
+
+namespace freeflow {
+
+// Fingerprinting
+Uint64 fingerprint(const Byte*, std::size_t);
+
+/// A Snapshot is a read-only view of a mapped snapshot file.
+class Snapshot {
+public:
+  /// The version of the file format. Files of other versions are not
+  /// loaded.
+  static constexpr Uint32 version = 1;
+
+  Snapshot();
+
+  // Loading
+  bool open(const std::string&);
+  void close();
+
+  // Observers
+  bool empty() const;
+  std::size_t size() const;
+  bool contains(Uint64) const;
+
+  // Restoration
+  bool restore(Uint64, Uint64, Datapath&) const;
+
+private:
+  friend class Snapshot_writer;
+
+  struct Entry;
+
+  bool entry(Uint64, Entry&) const;
+
+  Mapping     map_;
+  std::size_t count_; // The number of records
+};
+
+/// The Snapshot_writer collects the state of datapaths and writes it
+/// as a snapshot file.
+class Snapshot_writer {
+public:
+  // Observers
+  std::size_t size() const;
+
+  // Collection
+  void add(const Datapath&);
+
+  // Output
+  Buffer image() const;
+  bool write(const std::string&) const;
+
+private:
+  struct Record {
+    Uint64 dpid;
+    Buffer data;
+    Uint64 fingerprint;
+  };
+
+  std::vector<Record> records_;
+};
+
+} // namespace freeflow
+
+#include <freeflow/sdn/snapshot.ipp>
+
+#endif
@@ -0,0 +1,32 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+inline
+Snapshot::Snapshot() : count_(0) { }
+
+/// Returns true if no snapshot is loaded, or it has no records.
+inline bool
+Snapshot::empty() const { return count_ == 0; }
+
+/// Returns the number of records in the loaded snapshot.
+inline std::size_t
+Snapshot::size() const { return count_; }
+
+/// Returns the number of datapaths collected.
+inline std::size_t
+Snapshot_writer::size() const { return records_.size(); }
+
+} // namespace freeflow
@@ -0,0 +1,137 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+
+#include <freeflow/sdn/controller.hpp>
+#include <freeflow/sdn/switch.hpp>
+#include <freeflow/sdn/snapshot.hpp>
+
+// Test that datapath state saved by one controller is restored by
+// another when the switch's features are unchanged, and that damaged
+// or foreign snapshots are rejected.
+
+using namespace freeflow;
+
+const std::string path = "sdn_snapshot.bin";
+
+// Configure the datapath of a switch with a port, a table and some
+// application state.
+void configure(Datapath& dp, Uint64 fp) {
+  dp.fingerprint = fp;
+  dp.capabilities = Capabilities {Capability::FLOW_STATS, Capability::STP};
+  dp.actions = Action {Action_kind::OUTPUT};
+  dp.mfr_desc = "Flowgrammable";
+  dp.dp_desc = "edge";
+
+  Port p = Port();
+  p.port_number = 3;
+  p.hw_addr = Mac_addr {{1, 2, 3, 4, 5, 6}};
+  p.name = Symbol("eth3");
+  p.current.speed = 1000;
+  p.current.auto_neg = true;
+  dp.ports.insert(p);
+  dp.ports.status(3)->state = 1;
+
+  Flow_table& t = dp.flow_tables[0];
+  t.flowtable_id = 0;
+  t.name = "main";
+  t.emplace(Match {Match_field::IN_PORT}, Action {Action_kind::OUTPUT});
+
+  dp.state["learning"] = Buffer(4, 7);
+}
+
+int main() {
+  // Save the state of two switches, one of which has disconnected.
+  {
+    Controller ctrl;
+    Socket s1;
+    Socket s2;
+    Socket s3;
+    Switch& a = ctrl.connect(s1);
+    Switch& b = ctrl.connect(s2);
+    Switch& c = ctrl.connect(s3);
+    ctrl.identify(a, 1);
+    ctrl.identify(b, 2);
+    ctrl.identify(c, 3);
+    configure(a.datapath(), 100);
+    configure(b.datapath(), 200);
+    ctrl.disconnect(b);
+
+    // The third switch was never configured, so it is not saved.
+    assert(ctrl.save_snapshot(path));
+  }
+
+  Snapshot snap;
+  assert(snap.open(path));
+  assert(snap.size() == 2);
+  assert(snap.contains(1) and snap.contains(2) and not snap.contains(3));
+
+  // An unchanged switch is restored.
+  Controller ctrl;
+  assert(ctrl.load_snapshot(path));
+  Socket s1;
+  Switch& a = ctrl.connect(s1);
+  ctrl.identify(a, 1);
+  assert(ctrl.restore(a, 100));
+  const Datapath& dp = a.datapath();
+  assert(dp.datapath_id == 1);
+  assert(dp.fingerprint == 100);
+  assert(dp.capabilities == (Capabilities {Capability::FLOW_STATS, 
+                                           Capability::STP}));
+  assert(dp.actions == Action {Action_kind::OUTPUT});
+  assert(dp.mfr_desc == "Flowgrammable" and dp.dp_desc == "edge");
+  assert(dp.ports.size() == 1);
+  const Port* p = dp.ports.find(3);
+  assert(p and p->name == Symbol("eth3") and p->hw_addr.addr[5] == 6);
+  assert(p->current.speed == 1000 and p->current.auto_neg);
+  assert(dp.ports.status(3)->state == 1);
+  assert(dp.flow_tables.at(0).name == "main");
+  assert(dp.flow_tables.at(0).size() == 1);
+  assert(dp.state.at("learning") == Buffer(4, 7));
+
+  // Restoring again, as on a reconnection, uses the retained state.
+  assert(ctrl.restore(a, 100));
+
+  // A changed switch is not restored, but is marked with its new
+  // fingerprint.
+  Socket s2;
+  Switch& b = ctrl.connect(s2);
+  ctrl.identify(b, 2);
+  assert(not ctrl.restore(b, 201));
+  assert(b.datapath().ports.empty());
+  assert(b.datapath().fingerprint == 201);
+
+  // A damaged record is not restored.
+  Buffer img = read(path);
+  img.back() ^= 0xff;
+  write(img, path.c_str());
+  assert(snap.open(path));
+  Datapath x;
+  assert(not snap.restore(2, 200, x));
+
+  // Truncated and foreign files are not loaded.
+  img.resize(img.size() - 1);
+  write(img, path.c_str());
+  assert(not snap.open(path));
+  img[0] = 'X';
+  write(img, path.c_str());
+  assert(not snap.open(path));
+  assert(snap.empty());
+
+  std::remove(path.c_str());
+  assert(not snap.open(path));
+}
@@ -12,5 +12,74 @@
 // or implied. See the License for the specific language governing
 // permissions and limitations under the License.
 
+#include <algorithm>
+
 #include "switch.hpp"
 
+namespace freeflow {
+
+/// Bind the application to the switch. The application's subscription
+/// is read at this time. Applications cannot be bound or unbound while
+/// the switch is sending an event.
+void
+Switch::bind(Application* app) {
+  assert(not current_);
+  assert(std::find(apps_.begin(), apps_.end(), app) == apps_.end());
+  apps_.push_back(app);
+  route();
+  if (app->subscription().accepts(Event::BIND))
+    notify(App_list{app}, [this](Application* a) { a->bind(*this); });
+}
+
+/// Unbind the application from the switch.
+void
+Switch::unbind(Application* app) {
+  assert(not current_);
+  auto iter = std::find(apps_.begin(), apps_.end(), app);
+  assert(iter != apps_.end());
+  apps_.erase(iter);
+  route();
+  if (app->subscription().accepts(Event::UNBIND))
+    notify(App_list{app}, [this](Application* a) { a->unbind(*this); });
+}
+
+/// Unbind all applications from the switch, in the reverse of the
+/// order in which they were bound.
+void
+Switch::unbind() {
+  while (not apps_.empty())
+    unbind(apps_.back());
+}
+
+// Recompute the dispatch lists from the subscriptions of the bound
+// applications. Each list preserves the order in which applications
+// were bound.
+void
+Switch::route() {
+  for (App_list& l : subs_)
+    l.clear();
+  packet_any_.clear();
+  packet_by_type_.clear();
+
+  // Every Ethernet type named by some filter gets its own list.
+  for (Application* a : apps_)
+    for (Uint16 t : a->subscription().eth_types)
+      packet_by_type_[t];
+
+  for (Application* a : apps_) {
+    const Subscription& s = a->subscription();
+    for (std::size_t i = 0; i < events; ++i)
+      if (s.accepts(Event(i)))
+        subs_[i].push_back(a);
+
+    if (not s.accepts(Event::PACKET_IN))
+      continue;
+    if (s.eth_types.empty())
+      packet_any_.push_back(a);
+    for (auto& p : packet_by_type_)
+      if (s.accepts_packet(p.first))
+        p.second.push_back(a);
+  }
+}
+
+} // namespace freeflow
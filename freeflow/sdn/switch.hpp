@@ -16,12 +16,21 @@
 #define FREEFLOW_SWITCH_HPP
 
 #include <cassert>
-
+#include <unordered_map>
+#include <vector>
 
 #include <freeflow/sys/data.hpp>
 #include <freeflow/sdn/datapath.hpp>
+#include <freeflow/sdn/registry.hpp>
 #include <freeflow/sdn/application.hpp>
+#include <freeflow/sdn/packet.hpp>
+#include <freeflow/sdn/pending.hpp>
+#include <freeflow/sdn/admission.hpp>
+#include <freeflow/sdn/poller.hpp>
+#include <freeflow/sdn/series.hpp>
 #include <freeflow/sdn/request.hpp>
+#include <freeflow/sdn/transaction.hpp>
+#include <freeflow/sdn/flow_channel.hpp>
 
 namespace freeflow {
 
@@ -30,14 +39,25 @@ class Controller;
 
 /// A Switch represents a connected physical packet switching device.
 ///
-/// \todo Allow the switch to run multiple applications.
+/// Any number of applications can be bound to a switch. When the set of
+/// bound applications changes, the switch computes the list of
+/// applications subscribed to each event, so sending an event only
+/// visits interested applications. Packet-in events are further routed
+/// by Ethernet type.
+///
+/// While an application handles an event, it is the switch's current
+/// application, and requests made through the switch are attributed
+/// to it.
 class Switch {
+  friend class Switch_registry;
 public:
   Switch(Controller&, Socket& s);
 
   // Observers
   Controller& controller();
+  Socket& socket();
   Datapath& datapath();
+  Switch_handle handle() const;
 
   // Transport
   // FIXME: Get socket address and other information.
@@ -54,10 +74,45 @@ public:
   void bind(Application*);
   void unbind(Application*);
   void unbind();
+  const std::vector<Application*>& applications() const;
+  const std::vector<Application*>& subscribers(Event) const;
+  const std::vector<Application*>& packet_subscribers(Uint16) const;
+  Application* current() const;
+
+  // Datapath events
+  void packet_in(const Packet&);
+  void flow_removed(const Flow&);
+  void port_status(const Port&);
+  void table_status(const Flow_table&);
+  void role_status(const Role&);
 
   // Requests
-  void disconnect();
-  void terminate();
+  bool disconnect();
+  bool terminate();
+
+  // Transactions
+  Reply_future request_stats(Stats_kind);
+  Reply_future barrier();
+
+  // Flow programming
+  Flow_channel& flows();
+
+  // Flow setup
+  bool hold(const Packet&);
+  bool release(const Packet_key&);
+  Pending_flows& pending();
+
+  // Event admission
+  Switch_admission& admission();
+  const Switch_admission& admission() const;
+
+  // Stats polling
+  Switch_poll& polling();
+  const Switch_poll& polling() const;
+
+  // Counter history
+  Counter_store& counters();
+  const Counter_store& counters() const;
 
   Request_queue& requests();
   
@@ -66,10 +121,27 @@ private:
   Socket&       sock_;
   Request_queue reqs_;
   Datapath dp_;
-
-  // The hosted application.
-  // TODO: Should be applications.
-  Application* app_; 
+  Flow_channel flows_;
+  Pending_flows pending_; // Flows whose rules are being installed
+  Switch_admission admit_; // Limits on packet-ins from the switch
+  Switch_poll poll_; // Scheduling of stats requests
+  Counter_store counters_; // History of port and flow counters
+  Switch_handle handle_; // The datapath's record in the registry
+
+  using App_list = std::vector<Application*>;
+
+  void route();
+
+  template<typename F>
+    void notify(const App_list&, F);
+
+  // The hosted applications, in the order they were bound, and the
+  // dispatch lists computed from their subscriptions.
+  App_list apps_;
+  App_list subs_[events];
+  App_list packet_any_; // Packet-in for any Ethernet type
+  std::unordered_map<Uint16, App_list> packet_by_type_;
+  Application* current_; // The application handling an event
   
   // TODO: Allow different protocols to be supported.
   Uint8 proto_vsn; // The negotiated protocol version.
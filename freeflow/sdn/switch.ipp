@@ -17,16 +17,25 @@ namespace freeflow {
 /// Initialize the switch object for the given controller.
 inline
 Switch::Switch(Controller& c, Socket& s)
-  : ctrl_(c), sock_(s) { }
+  : ctrl_(c), sock_(s), current_(nullptr), proto_vsn(0), proto_exp(0) { }
 
 /// Return the controller associated with the switch.
 inline Controller& 
 Switch::controller() { return ctrl_; }
 
+/// Return the socket connecting the switch.
+inline Socket&
+Switch::socket() { return sock_; }
+
 /// Return the switch's datapath.
 inline Datapath& 
 Switch::datapath() { return dp_; }
 
+/// Returns the handle of the switch's datapath in the controller's
+/// registry. The handle is invalid until the datapath id is known.
+inline Switch_handle
+Switch::handle() const { return handle_; }
+
 /// Returns the negotiated protocol version.
 ///
 /// \todo Find a more abstract scheme for managing the protocol. Also,
@@ -45,7 +54,9 @@ inline void
 Switch::set_protocol(Uint8 v, Uint8 e) {
   proto_vsn = v;
   proto_exp = e;
-  app_->version_known(*this);
+  notify(subs_[std::size_t(Event::VERSION_KNOWN)], [this](Application* a) {
+    a->version_known(*this);
+  });
 }
 
 /// Indicate that the switch is ready to begin operation. The features-known
@@ -53,55 +64,179 @@ Switch::set_protocol(Uint8 v, Uint8 e) {
 /// be started, depending on configuration.
 inline void
 Switch::configured() {
-  app_->features_known(*this);
+  notify(subs_[std::size_t(Event::FEATURES_KNOWN)], [this](Application* a) {
+    a->features_known(*this);
+  });
 
   // TODO: Auto-start applications? Should the controller have a special
   // auto-start application that listens and requests application startup?
 }
 
-/// Bind given application to the switch.
+/// Returns the applications bound to the switch.
+inline const std::vector<Application*>&
+Switch::applications() const { return apps_; }
+
+/// Returns the bound applications subscribed to the event e.
+inline const std::vector<Application*>&
+Switch::subscribers(Event e) const { return subs_[std::size_t(e)]; }
+
+/// Returns the bound applications that receive packet-in events for
+/// packets with the Ethernet type t.
+inline const std::vector<Application*>&
+Switch::packet_subscribers(Uint16 t) const {
+  auto iter = packet_by_type_.find(t);
+  return iter == packet_by_type_.end() ? packet_any_ : iter->second;
+}
+
+/// Returns the application handling the current event, or nullptr if
+/// no event is being handled.
+inline Application*
+Switch::current() const { return current_; }
+
+/// Send a packet-in event to the applications interested in the
+/// packet's Ethernet type.
 inline void
-Switch::bind(Application* app) {
-  app_ = app;
-  app_->bind(*this);
+Switch::packet_in(const Packet& p) {
+  notify(packet_subscribers(p.eth_type()), [this, &p](Application* a) {
+    a->packet_in(*this, p);
+  });
 }
 
-/// Unbind the given application from the switch.
 inline void
-Switch::unbind(Application* app) {
-  assert(app_ == app);
-  app_->unbind(*this);
-  app_ = nullptr;
+Switch::flow_removed(const Flow& f) {
+  notify(subs_[std::size_t(Event::FLOW_REMOVED)], [this, &f](Application* a) {
+    a->flow_removed(*this, f);
+  });
 }
 
-/// Unbind all applications from the switch.
-///
-/// \todo Actually unbind multiple applications.
 inline void
-Switch::unbind() { unbind(app_); }
+Switch::port_status(const Port& p) {
+  notify(subs_[std::size_t(Event::PORT_STATUS)], [this, &p](Application* a) {
+    a->port_status(*this, p);
+  });
+}
+
+inline void
+Switch::table_status(const Flow_table& t) {
+  notify(subs_[std::size_t(Event::TABLE_STATUS)], [this, &t](Application* a) {
+    a->table_status(*this, t);
+  });
+}
 
-/// Request that the switch be disconnected.
+inline void
+Switch::role_status(const Role& r) {
+  notify(subs_[std::size_t(Event::ROLE_STATUS)], [this, &r](Application* a) {
+    a->role_status(*this, r);
+  });
+}
+
+/// Request that the switch be disconnected. Returns false if the request
+/// queue is full, in which case the request should be retried after the
+/// switch has been serviced.
 ///
 /// \todo Verify that the application has permission to close the
 /// connection.
-inline void
+inline bool
 Switch::disconnect() {
-  // FIXME: Invent a framework that maintains the current application
-  // when dispatching events. That way, the requesting application does't
-  // have to keep passing itself back to the controller when sending
-  // events.
-  reqs_.emplace(app_, Disconnect_request{});
+  return reqs_.emplace(current_, Disconnect_request{});
 }
 
-/// Request that the application be terminated on this switch.
-inline void
+/// Request that the current application be terminated on this switch.
+/// Returns false if the request queue is full.
+inline bool
 Switch::terminate() {
-  reqs_.emplace(app_, Terminate_request{});
+  return reqs_.emplace(current_, Terminate_request{});
+}
+
+/// Request statistics from the switch. The returned future becomes
+/// ready when the complete reply has been received, or when the request
+/// times out. Any number of requests may be outstanding. If the request
+/// queue is full, the future is returned already expired.
+inline Reply_future
+Switch::request_stats(Stats_kind k) {
+  auto t = std::make_shared<Transaction>();
+  if (not reqs_.emplace(current_, Stats_request{k}, t))
+    t->expire();
+  return Reply_future(t);
+}
+
+/// Send a barrier to the switch. The returned future becomes ready when
+/// the switch has processed every message sent before the barrier. If
+/// the request queue is full, the future is returned already expired.
+inline Reply_future
+Switch::barrier() {
+  auto t = std::make_shared<Transaction>();
+  if (not reqs_.emplace(current_, Barrier_request{}, t))
+    t->expire();
+  return Reply_future(t);
+}
+
+/// Returns the channel through which flow modifications are pipelined
+/// to the switch.
+inline Flow_channel&
+Switch::flows() { return flows_; }
+
+/// Mark the flow of the packet as pending while the application installs
+/// a rule for it. Until the flow is released or expires, further packets
+/// of the flow are absorbed by the controller instead of being delivered
+/// to applications. This must be called by the controller's thread, usually
+/// while handling the packet-in. Returns false if the flow is already
+/// pending.
+inline bool
+Switch::hold(const Packet& p) { return pending_.hold(p.key(), now()); }
+
+/// Request that the pending flow with key k be released, typically after
+/// the rule for the flow has been acknowledged by a barrier. Returns false
+/// if the request queue is full; the flow will then expire instead.
+inline bool
+Switch::release(const Packet_key& k) {
+  return reqs_.emplace(current_, Release_request{k});
 }
 
+/// Returns the table of pending flows.
+inline Pending_flows&
+Switch::pending() { return pending_; }
+
+/// Returns the switch's admission state, including its counts of
+/// admitted and dropped packet-ins.
+inline Switch_admission&
+Switch::admission() { return admit_; }
+
+inline const Switch_admission&
+Switch::admission() const { return admit_; }
+
+/// Returns the polling state of the switch, which is maintained by the
+/// controller's stats poller.
+inline Switch_poll&
+Switch::polling() { return poll_; }
+
+inline const Switch_poll&
+Switch::polling() const { return poll_; }
+
+/// Returns the history of the switch's port and flow counters, which is
+/// recorded from the replies of each stats poll round.
+inline Counter_store&
+Switch::counters() { return counters_; }
+
+inline const Counter_store&
+Switch::counters() const { return counters_; }
+
 /// Returns a reference to the request queue, allowing a protocol
 /// implementation to service any application requsts.
 inline Request_queue&
 Switch::requests() { return reqs_; }
 
+// Send an event to each application in the list by calling f. Each
+// application is current while it handles the event.
+template<typename F>
+  inline void
+  Switch::notify(const App_list& apps, F f) {
+    Application* prev = current_;
+    for (Application* a : apps) {
+      current_ = a;
+      f(a);
+    }
+    current_ = prev;
+  }
+
 } // namespace freeflow
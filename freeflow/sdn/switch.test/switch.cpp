@@ -0,0 +1,139 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/sdn/controller.hpp>
+#include <freeflow/sdn/switch.hpp>
+
+// Test that events reach only the applications subscribed to them, and
+// that packet-in events are routed by Ethernet type. Also test that the
+// controller binds its running applications to connected switches.
+
+using namespace freeflow;
+
+struct Counter : Application {
+  Counter(Controller& c, const Subscription& s)
+    : Application(c) { subscribe(s); }
+
+  void bind(Switch&) override { ++binds; }
+  void unbind(Switch&) override { ++unbinds; }
+  void features_known(Switch&) override { ++features; }
+  void packet_in(Switch& s, const Packet&) override { 
+    assert(s.current() == this);
+    ++packets; 
+  }
+
+  int binds = 0;
+  int unbinds = 0;
+  int features = 0;
+  int packets = 0;
+};
+
+// Returns an Ethernet frame with the given type and no payload.
+Buffer frame(Uint16 type) {
+  Buffer b(14, 0);
+  b[12] = type >> 8;
+  b[13] = type & 0xff;
+  return b;
+}
+
+// Every running application is bound to a switch when it connects, and
+// to the connected switches when it starts, so each receives the same
+// events.
+void test_controller() {
+  Controller ctrl;
+  Counter a(ctrl, Subscription());
+  Counter b(ctrl, Subscription());
+
+  Process* pa = ctrl.start(&a);
+  Socket sock;
+  Switch& sw = ctrl.connect(sock);
+  assert(a.binds == 1);
+  Process* pb = ctrl.start(&b);
+  assert(b.binds == 1);
+  assert(sw.applications().size() == 2);
+
+  sw.configured();
+  sw.packet_in(Packet(frame(0x0800)));
+  assert(a.features == 1 and b.features == 1);
+  assert(a.packets == 1 and b.packets == 1);
+
+  // Stopping an application unbinds it from the switch.
+  ctrl.stop(pb);
+  assert(b.unbinds == 1);
+  assert(sw.applications().size() == 1);
+
+  ctrl.disconnect(sw);
+  assert(a.unbinds == 1);
+  ctrl.stop(pa);
+  assert(a.unbinds == 1);
+}
+
+void test_dispatch() {
+  Controller ctrl;
+  Socket sock;
+  Switch& sw = ctrl.connect(sock);
+
+  // Receives everything.
+  Counter all(ctrl, Subscription());
+
+  // Receives only ARP and LLDP packet-ins.
+  Subscription s1;
+  s1.events.clear();
+  s1.events.set(Event::PACKET_IN);
+  s1.eth_types = {0x0806, 0x88cc};
+  Counter arp(ctrl, s1);
+
+  // Receives only features.
+  Subscription s2;
+  s2.events.clear();
+  s2.events.set(Event::FEATURES_KNOWN);
+  Counter feat(ctrl, s2);
+
+  sw.bind(&all);
+  sw.bind(&arp);
+  sw.bind(&feat);
+  assert(sw.applications().size() == 3);
+  assert(all.binds == 1 and arp.binds == 0 and feat.binds == 0);
+  assert(sw.subscribers(Event::PACKET_IN).size() == 2);
+  assert(sw.subscribers(Event::FEATURES_KNOWN).size() == 2);
+
+  sw.configured();
+  assert(all.features == 1 and arp.features == 0 and feat.features == 1);
+
+  sw.packet_in(Packet(frame(0x0800)));
+  sw.packet_in(Packet(frame(0x0806)));
+  sw.packet_in(Packet(frame(0x88cc)));
+  assert(all.packets == 3);
+  assert(arp.packets == 2);
+  assert(feat.packets == 0);
+  assert(sw.packet_subscribers(0x0800).size() == 1);
+  assert(sw.packet_subscribers(0x88cc).size() == 2);
+  assert(sw.current() == nullptr);
+
+  sw.unbind(&all);
+  sw.packet_in(Packet(frame(0x0800)));
+  assert(all.packets == 3);
+  assert(sw.packet_subscribers(0x0800).empty());
+
+  sw.unbind();
+  assert(sw.applications().empty());
+  ctrl.disconnect(sw);
+}
+
+int main() {
+  test_dispatch();
+  test_controller();
+}
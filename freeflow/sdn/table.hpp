@@ -44,10 +44,7 @@ struct Flow_table : public std::map<Match, Action> {
 
 /// Flow_tables represents a sequence of Flow_table objects in the 
 /// form of a flowtable_id to Flow_table mapping. 
-struct Flow_tables : public std::map<int, Flow_table> {
-  bool table_stats; // From FeatureRes.capabilities
-  bool flow_stats;  // From FeatureRes.capabilities
-};
+struct Flow_tables : public std::map<int, Flow_table> { };
 
 } // namespace freeflow
 
@@ -0,0 +1,383 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <functional>
+
+#include "topology.hpp"
+
+namespace freeflow {
+
+namespace {
+
+// LLDP frames are sent to the nearest-bridge group address, which
+// bridges do not forward.
+constexpr Byte lldp_group[6] = { 0x01, 0x80, 0xc2, 0x00, 0x00, 0x0e };
+
+// LLDP TLV types.
+constexpr Uint16 tlv_end     = 0;
+constexpr Uint16 tlv_chassis = 1;
+constexpr Uint16 tlv_port    = 2;
+constexpr Uint16 tlv_ttl     = 3;
+
+// Chassis and port ids are locally assigned: the datapath id and the
+// port number in network byte order.
+constexpr Uint8 locally_assigned = 7;
+
+// The time to live advertised by probes, in seconds.
+constexpr Uint16 probe_ttl = 120;
+
+// The minimum size of an Ethernet frame, excluding the FCS.
+constexpr std::size_t min_frame = 60;
+
+template<typename T>
+  inline void
+  store(Byte* p, T x) {
+    x = Byte_order::msbf(x);
+    std::memcpy(p, &x, sizeof(T));
+  }
+
+template<typename T>
+  inline T
+  load(const Byte* p) {
+    T x;
+    std::memcpy(&x, p, sizeof(T));
+    return Byte_order::msbf(x);
+  }
+
+// Write the header of a TLV with the type t and n bytes of value. The
+// type takes the high 7 bits and the length the low 9.
+inline Byte*
+store_tlv(Byte* p, Uint16 t, Uint16 n) {
+  store<Uint16>(p, Uint16(t << 9 | n));
+  return p + 2;
+}
+
+template<typename T>
+  inline void
+  remove(std::vector<T>& v, T x) {
+    auto iter = std::find(v.begin(), v.end(), x);
+    assert(iter != v.end());
+    *iter = v.back();
+    v.pop_back();
+  }
+
+} // namespace
+
+constexpr Uint32 Topology::unreachable;
+constexpr Uint32 Topology::none;
+
+/// Add the switch to the graph. It is initially unconnected. Returns
+/// false if the switch is already in the graph.
+bool
+Topology::add_switch(Uint64 dpid) {
+  if (contains(dpid))
+    return false;
+  index_.emplace(dpid, allocate(dpid));
+  return true;
+}
+
+/// Remove the switch and every link to or from it. Returns false if the
+/// switch is not in the graph.
+bool
+Topology::remove_switch(Uint64 dpid) {
+  Node n = node(dpid);
+  if (n == none)
+    return false;
+  while (not nodes_[n].out.empty())
+    unlink(nodes_[n].out.back());
+  while (not nodes_[n].in.empty())
+    unlink(nodes_[n].in.back());
+  nodes_[n].live = false;
+  free_nodes_.push_back(n);
+  index_.erase(dpid);
+  return true;
+}
+
+/// Returns the link leaving the port of the switch, or nullptr if there
+/// is none.
+const Link*
+Topology::find_link(Uint64 dpid, Uint16 port) const {
+  Node n = node(dpid);
+  if (n == none)
+    return nullptr;
+  for (Edge_id e : nodes_[n].out)
+    if (edges_[e].link.src_port == port)
+      return &edges_[e].link;
+  return nullptr;
+}
+
+/// Add the link with the given cost to the graph. Both switches must be
+/// in the graph. A port has at most one link: if the sending port is
+/// already linked elsewhere, that link is replaced. Returns false if the
+/// graph is unchanged.
+///
+/// Only the switches to which the new link gives a shorter path are
+/// visited. Every switch in the tree below the link's destination is
+/// one of them, since all of their distances shrink by the same amount.
+bool
+Topology::link_up(const Link& l, Uint32 cost) {
+  assert(cost > 0);
+  Node u = node(l.src);
+  Node v = node(l.dst);
+  if (u == none or v == none or u == v)
+    return false;
+
+  for (Edge_id id : nodes_[u].out) {
+    const Edge& e = edges_[id];
+    if (e.link.src_port != l.src_port)
+      continue;
+    if (e.link == l and e.cost == cost)
+      return false;
+    unlink(id);
+    break;
+  }
+
+  Edge_id id;
+  if (free_edges_.empty()) {
+    id = edges_.size();
+    edges_.emplace_back();
+  } else {
+    id = free_edges_.back();
+    free_edges_.pop_back();
+  }
+  edges_[id] = Edge {l, u, v, cost};
+  nodes_[u].out.push_back(id);
+  nodes_[v].in.push_back(id);
+  ++links_;
+
+  const Edge& e = edges_[id];
+  std::vector<Entry> heap;
+  for (Node s = 0; s < nodes_.size(); ++s) {
+    if (not nodes_[s].live)
+      continue;
+    Tree& t = trees_[s];
+    if (t[u].dist == unreachable)
+      continue;
+    Uint32 d = t[u].dist + cost;
+    if (d < t[v].dist) {
+      t[v] = Route {d, id, first_port(s, u, e)};
+      heap.emplace_back(d, v);
+      settle(s, heap);
+    }
+  }
+  return true;
+}
+
+/// Remove the link leaving the port of the switch. Returns false if
+/// there is no such link.
+bool
+Topology::link_down(Uint64 dpid, Uint16 port) {
+  Node n = node(dpid);
+  if (n == none)
+    return false;
+  for (Edge_id e : nodes_[n].out)
+    if (edges_[e].link.src_port == port) {
+      unlink(e);
+      return true;
+    }
+  return false;
+}
+
+/// Sets p to the hops of the shortest path from src to dst. Each hop
+/// names a switch on the path and the port the path leaves it by; the
+/// last hop leads to dst. Returns false if dst is not reachable from src.
+bool
+Topology::path(Uint64 src, Uint64 dst, Hops& p) const {
+  p.clear();
+  const Route* r = route(src, dst);
+  if (not r or r->dist == unreachable)
+    return false;
+  const Tree& t = trees_[node(src)];
+  for (Edge_id e = r->via; e != none; e = t[edges_[e].src].via)
+    p.push_back(Hop {edges_[e].link.src, edges_[e].link.src_port});
+  std::reverse(p.begin(), p.end());
+  return true;
+}
+
+// Returns a node for the switch. Its routes, and the routes to it, are
+// initially unreachable.
+Topology::Node
+Topology::allocate(Uint64 dpid) {
+  Node n;
+  if (free_nodes_.empty()) {
+    n = nodes_.size();
+    nodes_.emplace_back();
+    trees_.emplace_back();
+    for (Tree& t : trees_)
+      t.resize(nodes_.size());
+  } else {
+    n = free_nodes_.back();
+    free_nodes_.pop_back();
+  }
+  nodes_[n].dpid = dpid;
+  nodes_[n].live = true;
+  reset(n);
+  return n;
+}
+
+void
+Topology::reset(Node n) {
+  const Route empty {unreachable, none, 0};
+  for (Tree& t : trees_)
+    t[n] = empty;
+  std::fill(trees_[n].begin(), trees_[n].end(), empty);
+  trees_[n][n].dist = 0;
+}
+
+// Run Dijkstra's algorithm in the tree of the source s, starting from
+// the nodes in the heap, whose routes have already been shortened. Only
+// nodes whose routes are shortened in turn are visited.
+void
+Topology::settle(Node s, std::vector<Entry>& heap) {
+  using Order = std::greater<Entry>;
+  Tree& t = trees_[s];
+  std::make_heap(heap.begin(), heap.end(), Order());
+  while (not heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), Order());
+    Entry x = heap.back();
+    heap.pop_back();
+    if (x.first != t[x.second].dist)
+      continue;
+    ++visited_;
+    for (Edge_id id : nodes_[x.second].out) {
+      const Edge& e = edges_[id];
+      Uint32 d = x.first + e.cost;
+      if (d < t[e.dst].dist) {
+        t[e.dst] = Route {d, id, first_port(s, x.second, e)};
+        heap.emplace_back(d, e.dst);
+        std::push_heap(heap.begin(), heap.end(), Order());
+      }
+    }
+  }
+}
+
+// The removed edge was the last edge of the route from s to the node n.
+// Every node in the subtree below n loses its route. Each is given the
+// best route through a neighbor outside the subtree, and the routes are
+// settled from there. Nodes outside the subtree are unaffected.
+void
+Topology::sever(Node s, Node n) {
+  Tree& t = trees_[s];
+  std::vector<Node> lost {n};
+  for (std::size_t i = 0; i < lost.size(); ++i) {
+    Node x = lost[i];
+    for (Edge_id id : nodes_[x].out)
+      if (t[edges_[id].dst].via == id)
+        lost.push_back(edges_[id].dst);
+    t[x] = Route {unreachable, none, 0};
+  }
+  visited_ += lost.size();
+
+  std::vector<Entry> heap;
+  for (Node x : lost) {
+    for (Edge_id id : nodes_[x].in) {
+      const Edge& e = edges_[id];
+      if (t[e.src].dist == unreachable)
+        continue;
+      Uint32 d = t[e.src].dist + e.cost;
+      if (d < t[x].dist)
+        t[x] = Route {d, id, first_port(s, e.src, e)};
+    }
+    if (t[x].dist != unreachable)
+      heap.emplace_back(t[x].dist, x);
+  }
+  settle(s, heap);
+}
+
+// Remove the edge from the graph and repair the trees that contained it.
+void
+Topology::unlink(Edge_id id) {
+  const Edge& e = edges_[id];
+  remove(nodes_[e.src].out, id);
+  remove(nodes_[e.dst].in, id);
+  --links_;
+
+  for (Node s = 0; s < nodes_.size(); ++s)
+    if (nodes_[s].live and trees_[s][e.dst].via == id)
+      sever(s, e.dst);
+  free_edges_.push_back(id);
+}
+
+// -------------------------------------------------------------------------- //
+// Discovery probes
+
+/// Returns an LLDP frame identifying the port of the switch. The source
+/// address is derived from the datapath id.
+Buffer
+make_probe(Uint64 dpid, Uint16 port) {
+  Buffer b(min_frame, 0);
+  Byte* p = b.data();
+  std::memcpy(p, lldp_group, 6);
+  for (int i = 0; i < 6; ++i)
+    p[6 + i] = Byte(dpid >> (40 - 8 * i));
+  p[6] &= 0xfe;
+  store<Uint16>(p + 12, eth_type::LLDP);
+  p += 14;
+
+  p = store_tlv(p, tlv_chassis, 9);
+  *p = locally_assigned;
+  store<Uint64>(p + 1, dpid);
+  p += 9;
+
+  p = store_tlv(p, tlv_port, 3);
+  *p = locally_assigned;
+  store<Uint16>(p + 1, port);
+  p += 3;
+
+  p = store_tlv(p, tlv_ttl, 2);
+  store<Uint16>(p, probe_ttl);
+  p += 2;
+
+  store_tlv(p, tlv_end, 0);
+  return b;
+}
+
+/// If the packet is a probe made by make_probe, sets dpid and port to
+/// the switch and port it was sent from and returns true. Other LLDP
+/// frames are not recognized.
+bool
+read_probe(const Packet& pkt, Uint64& dpid, Uint16& port) {
+  if (pkt.eth_type() != eth_type::LLDP)
+    return false;
+  const Byte* p = pkt.data() + pkt.payload();
+  const Byte* last = pkt.data() + pkt.size();
+  bool chassis = false;
+  bool found = false;
+  while (last - p >= 2) {
+    Uint16 h = load<Uint16>(p);
+    Uint16 t = h >> 9;
+    Uint16 n = h & 0x1ff;
+    p += 2;
+    if (t == tlv_end or last - p < n)
+      break;
+    if (t == tlv_chassis) {
+      if (n != 9 or *p != locally_assigned)
+        return false;
+      dpid = load<Uint64>(p + 1);
+      chassis = true;
+    } else if (t == tlv_port) {
+      if (n != 3 or *p != locally_assigned)
+        return false;
+      port = load<Uint16>(p + 1);
+      found = true;
+    }
+    p += n;
+  }
+  return chassis and found;
+}
+
+} // namespace freeflow
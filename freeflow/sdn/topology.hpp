@@ -0,0 +1,153 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_TOPOLOGY_HPP
+#define FREEFLOW_TOPOLOGY_HPP
+
+#include <unordered_map>
+#include <vector>
+
+#include <freeflow/sys/data.hpp>
+#include <freeflow/sys/buffer.hpp>
+#include <freeflow/sdn/packet.hpp>
+
+/// \file topology.hpp
+/// The switch graph and the shortest paths between switches.
+///
+/// Links between switches are discovered by sending an LLDP probe out of
+/// every port of every switch. A probe that arrives at another switch is
+/// returned to the controller as a packet-in, identifying the link from
+/// the probed port to the receiving port.
+///
+/// The Topology maintains the graph of switches and links, together
+/// with the shortest path tree rooted at every switch. The trees are
+/// updated incrementally: when a link comes up, only the switches whose
+/// distance it shortens are visited; when a link goes down, only the
+/// subtrees that were reached through it are recomputed. The distance
+/// and next hop between any two switches are then found by lookup.
+
+namespace freeflow {
+
+/// A Link is a unidirectional connection from a port of one switch to
+/// a port of another. Switches are identified by their datapath ids.
+struct Link {
+  Uint64 src;      // The sending datapath
+  Uint16 src_port; // The sending port
+  Uint64 dst;      // The receiving datapath
+  Uint16 dst_port; // The receiving port
+};
+
+bool operator==(const Link&, const Link&);
+bool operator!=(const Link&, const Link&);
+
+/// A Hop is a step along a path: the packet leaves the datapath through
+/// the port.
+struct Hop {
+  Uint64 dpid;
+  Uint16 port;
+};
+
+using Hops = std::vector<Hop>;
+
+/// The Topology class is the graph of switches and links, annotated
+/// with the shortest path from every switch to every other. Link costs
+/// are positive; by default every link costs 1 and paths are the ones
+/// with the fewest hops.
+///
+/// Memory for the paths grows with the square of the number of switches.
+class Topology {
+public:
+  /// The distance between switches that are not connected.
+  static constexpr Uint32 unreachable = Uint32(-1);
+
+  // Observers
+  std::size_t switches() const;
+  std::size_t links() const;
+  bool contains(Uint64) const;
+  const Link* find_link(Uint64, Uint16) const;
+  Uint64 visited() const;
+
+  // Switches
+  bool add_switch(Uint64);
+  bool remove_switch(Uint64);
+
+  // Links
+  bool link_up(const Link&, Uint32 = 1);
+  bool link_down(Uint64, Uint16);
+
+  // Paths
+  Uint32 distance(Uint64, Uint64) const;
+  bool next_hop(Uint64, Uint64, Uint16&) const;
+  bool path(Uint64, Uint64, Hops&) const;
+
+private:
+  using Node = Uint32;
+  using Edge_id = Uint32;
+
+  static constexpr Uint32 none = Uint32(-1);
+
+  struct Edge {
+    Link   link;
+    Node   src;
+    Node   dst;
+    Uint32 cost;
+  };
+
+  struct Vertex {
+    Uint64               dpid;
+    bool                 live;
+    std::vector<Edge_id> out; // Links leaving the switch
+    std::vector<Edge_id> in;  // Links arriving at the switch
+  };
+
+  // The shortest path from a source to a destination is summarized by
+  // its length, the last edge of the path (giving the tree), and the
+  // port through which it leaves the source.
+  struct Route {
+    Uint32  dist;
+    Edge_id via;
+    Uint16  port;
+  };
+
+  using Tree = std::vector<Route>;
+  using Entry = std::pair<Uint32, Node>;
+
+  const Route* route(Uint64, Uint64) const;
+  Node node(Uint64) const;
+  Node allocate(Uint64);
+  void reset(Node);
+  void settle(Node, std::vector<Entry>&);
+  void sever(Node, Node);
+  void unlink(Edge_id);
+  Uint16 first_port(Node, Node, const Edge&) const;
+
+  std::unordered_map<Uint64, Node> index_;
+  std::vector<Vertex>  nodes_;
+  std::vector<Edge>    edges_;
+  std::vector<Tree>    trees_;      // The shortest path tree of each source
+  std::vector<Node>    free_nodes_;
+  std::vector<Edge_id> free_edges_;
+  std::size_t          links_ = 0;
+  Uint64               visited_ = 0; // Routes updated by changes to links
+};
+
+// Discovery probes
+Buffer make_probe(Uint64, Uint16);
+bool read_probe(const Packet&, Uint64&, Uint16&);
+
+} // namespace freeflow
+
+#include <freeflow/sdn/topology.ipp>
+
+#endif
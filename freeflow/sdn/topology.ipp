@@ -0,0 +1,88 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+inline bool
+operator==(const Link& a, const Link& b) {
+  return a.src == b.src and a.src_port == b.src_port
+     and a.dst == b.dst and a.dst_port == b.dst_port;
+}
+
+inline bool
+operator!=(const Link& a, const Link& b) { return not (a == b); }
+
+/// Returns the number of switches in the graph.
+inline std::size_t
+Topology::switches() const { return index_.size(); }
+
+/// Returns the number of links in the graph.
+inline std::size_t
+Topology::links() const { return links_; }
+
+/// Returns true if the switch with the datapath id is in the graph.
+inline bool
+Topology::contains(Uint64 dpid) const { return index_.count(dpid) != 0; }
+
+/// Returns the number of routes updated in response to changes to
+/// links. This measures the cost of maintaining the paths.
+inline Uint64
+Topology::visited() const { return visited_; }
+
+/// Returns the length of the shortest path from the switch src to the
+/// switch dst, or unreachable if there is no such path.
+inline Uint32
+Topology::distance(Uint64 src, Uint64 dst) const {
+  const Route* r = route(src, dst);
+  return r ? r->dist : unreachable;
+}
+
+/// Sets port to the port through which the shortest path from src to dst
+/// leaves src. Returns false if dst is not reachable from src, or if they
+/// are the same switch.
+inline bool
+Topology::next_hop(Uint64 src, Uint64 dst, Uint16& port) const {
+  const Route* r = route(src, dst);
+  if (not r or r->via == none)
+    return false;
+  port = r->port;
+  return true;
+}
+
+// Returns the index of the switch, or none if it is not in the graph.
+inline Topology::Node
+Topology::node(Uint64 dpid) const {
+  auto iter = index_.find(dpid);
+  return iter == index_.end() ? none : iter->second;
+}
+
+// Returns the route from src to dst, or nullptr if either switch is not
+// in the graph.
+inline const Topology::Route*
+Topology::route(Uint64 src, Uint64 dst) const {
+  Node s = node(src);
+  Node d = node(dst);
+  if (s == none or d == none)
+    return nullptr;
+  return &trees_[s][d];
+}
+
+// Returns the port through which a path leaves the source s when its
+// last edge is e, leaving the switch x.
+inline Uint16
+Topology::first_port(Node s, Node x, const Edge& e) const {
+  return x == s ? e.link.src_port : trees_[s][x].port;
+}
+
+} // namespace freeflow
@@ -0,0 +1,175 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+#include <cstdlib>
+
+#include <freeflow/sdn/topology.hpp>
+
+// Test that shortest paths are maintained as links come and go, that
+// they agree with paths computed from scratch, and that discovery probes
+// survive a round trip.
+
+using namespace freeflow;
+
+// Link the port p of switch a to the port q of switch b in both
+// directions.
+void connect(Topology& t, Uint64 a, Uint16 p, Uint64 b, Uint16 q) {
+  t.link_up(Link {a, p, b, q});
+  t.link_up(Link {b, q, a, p});
+}
+
+void disconnect(Topology& t, Uint64 a, Uint16 p, Uint64 b, Uint16 q) {
+  t.link_down(a, p);
+  t.link_down(b, q);
+}
+
+// Returns the distance from src to dst computed by Bellman-Ford over
+// the links of the n switches numbered 1 to n, each with ports 1 to n.
+Uint32 reference(const Topology& t, Uint64 n, Uint64 src, Uint64 dst) {
+  std::vector<Uint32> d(n + 1, Topology::unreachable);
+  d[src] = 0;
+  for (Uint64 i = 0; i < n; ++i)
+    for (Uint64 a = 1; a <= n; ++a)
+      for (Uint16 p = 1; p <= n; ++p)
+        if (const Link* l = t.find_link(a, p))
+          if (d[a] != Topology::unreachable and d[a] + 1 < d[l->dst])
+            d[l->dst] = d[a] + 1;
+  return d[dst];
+}
+
+// Check that every path is as short as the reference and is made of
+// existing links.
+void check(const Topology& t, Uint64 n) {
+  for (Uint64 a = 1; a <= n; ++a)
+    for (Uint64 b = 1; b <= n; ++b) {
+      Uint32 d = t.distance(a, b);
+      assert(d == reference(t, n, a, b));
+      Hops p;
+      assert(t.path(a, b, p) == (d != Topology::unreachable));
+      if (d == Topology::unreachable or a == b)
+        continue;
+      assert(p.size() == d);
+      Uint16 port;
+      assert(t.next_hop(a, b, port) and port == p.front().port);
+      Uint64 x = a;
+      for (const Hop& h : p) {
+        const Link* l = t.find_link(h.dpid, h.port);
+        assert(h.dpid == x and l);
+        x = l->dst;
+      }
+      assert(x == b);
+    }
+}
+
+int main() {
+  // A line of four switches: 1 - 2 - 3 - 4.
+  Topology t;
+  for (Uint64 i = 1; i <= 4; ++i)
+    assert(t.add_switch(i));
+  assert(not t.add_switch(1));
+  connect(t, 1, 1, 2, 1);
+  connect(t, 2, 2, 3, 1);
+  connect(t, 3, 2, 4, 1);
+  assert(t.links() == 6);
+  assert(t.distance(1, 4) == 3);
+  assert(t.distance(4, 1) == 3);
+  assert(t.distance(2, 2) == 0);
+  check(t, 4);
+
+  Uint16 port;
+  assert(t.next_hop(1, 4, port) and port == 1);
+  assert(t.next_hop(4, 1, port) and port == 1);
+  assert(not t.next_hop(1, 1, port));
+
+  // Closing the ring shortens the path from 1 to 4.
+  connect(t, 4, 2, 1, 2);
+  assert(t.distance(1, 4) == 1);
+  assert(t.next_hop(1, 4, port) and port == 2);
+  check(t, 4);
+
+  // A refreshed link changes nothing.
+  assert(not t.link_up(Link {1, 2, 4, 2}));
+
+  // Breaking the ring elsewhere reroutes around it.
+  disconnect(t, 2, 2, 3, 1);
+  assert(t.distance(2, 3) == 3);
+  assert(t.next_hop(2, 3, port) and port == 1);
+  check(t, 4);
+
+  // A link at the edge of the graph does not disturb the paths between
+  // the other switches.
+  assert(t.add_switch(5));
+  Uint64 v = t.visited();
+  connect(t, 4, 3, 5, 1);
+  assert(t.distance(1, 5) == 2);
+  Uint64 up = t.visited() - v;
+  assert(up < 10);
+  v = t.visited();
+  disconnect(t, 4, 3, 5, 1);
+  assert(t.distance(1, 5) == Topology::unreachable);
+  assert(t.visited() - v <= up);
+  check(t, 5);
+
+  // Moving a port's link replaces it.
+  connect(t, 4, 3, 5, 1);
+  assert(t.link_up(Link {4, 3, 3, 3}));
+  assert(t.find_link(4, 3)->dst == 3);
+  assert(t.distance(4, 5) == Topology::unreachable);
+  assert(t.distance(5, 4) == 1);
+  t.link_down(5, 1);
+  check(t, 5);
+
+  // Removing a switch removes its links.
+  assert(t.remove_switch(1));
+  assert(not t.contains(1));
+  assert(t.distance(2, 4) == Topology::unreachable);
+  assert(t.distance(1, 2) == Topology::unreachable);
+  assert(not t.remove_switch(1));
+  assert(t.add_switch(1));
+  assert(t.distance(1, 2) == Topology::unreachable);
+  check(t, 5);
+
+  // Random changes agree with paths computed from scratch.
+  Topology r;
+  const Uint64 n = 12;
+  for (Uint64 i = 1; i <= n; ++i)
+    r.add_switch(i);
+  std::srand(1);
+  for (int i = 0; i < 400; ++i) {
+    Uint64 a = 1 + std::rand() % n;
+    Uint16 p = 1 + std::rand() % n;
+    if (std::rand() % 3)
+      r.link_up(Link {a, p, 1 + std::rand() % n, Uint16(1)});
+    else
+      r.link_down(a, p);
+    if (i % 20 == 0)
+      check(r, n);
+  }
+  check(r, n);
+
+  // Probes identify the port they were sent from.
+  Buffer b = make_probe(0x0000123456789abc, 7);
+  assert(b.size() == 60);
+  Packet pkt(b, 3);
+  assert(pkt.eth_type() == eth_type::LLDP);
+  Uint64 dpid = 0;
+  port = 0;
+  assert(read_probe(pkt, dpid, port));
+  assert(dpid == 0x0000123456789abc and port == 7);
+
+  // Truncated probes are not recognized.
+  Packet cut(b.data(), 20, 3);
+  assert(not read_probe(cut, dpid, port));
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_TRANSACTION_HPP
+#define FREEFLOW_TRANSACTION_HPP
+
+#include <functional>
+#include <memory>
+
+#include <freeflow/sys/buffer.hpp>
+
+namespace freeflow {
+
+/// The states of a transaction.
+enum class Transaction_state {
+  PENDING,  // Waiting for a reply
+  COMPLETE, // The reply has been received
+  FAILED,   // The switch replied with an error
+  EXPIRED   // No reply was received before the deadline
+};
+
+/// A Transaction is the shared state of a request sent to a switch and
+/// its eventual reply. The reply is the encoded reply message. When a
+/// reply is split over several messages (e.g., a multipart stats reply),
+/// the messages are stored consecutively. When the switch rejects the
+/// request, the reply is the error message instead.
+///
+/// Transactions are created by the switch when an application makes a
+/// request, and completed, failed or expired by the protocol
+/// implementation.
+class Transaction {
+public:
+  using State = Transaction_state;
+  using Handler = std::function<void(const Transaction&)>;
+
+  Transaction();
+
+  // Observers
+  State state() const;
+  bool pending() const;
+  bool failed() const;
+  bool expired() const;
+  const Buffer& reply() const;
+
+  // Notification
+  void then(Handler);
+
+  // Completion
+  void append(const Buffer&);
+  void complete();
+  void fail(const Buffer&);
+  void expire();
+
+private:
+  void notify();
+
+  State   state_;
+  Buffer  reply_;
+  Handler handler_;
+};
+
+
+/// A Reply_future refers to the transaction of an outstanding request.
+/// Applications may poll the future or attach a handler that is invoked
+/// when the transaction completes or expires. Many futures may be
+/// outstanding for a switch at the same time.
+class Reply_future {
+public:
+  Reply_future() = default;
+  explicit Reply_future(std::shared_ptr<Transaction>);
+
+  // Observers
+  bool valid() const;
+  bool ready() const;
+  bool failed() const;
+  bool expired() const;
+  const Buffer& get() const;
+
+  // Notification
+  void then(Transaction::Handler);
+
+private:
+  std::shared_ptr<Transaction> txn_;
+};
+
+} // namespace freeflow
+
+#include <freeflow/sdn/transaction.ipp>
+
+#endif
@@ -0,0 +1,145 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+// -------------------------------------------------------------------------- //
+// Transaction
+
+inline
+Transaction::Transaction()
+  : state_(State::PENDING) { }
+
+/// Returns the state of the transaction.
+inline Transaction_state
+Transaction::state() const { return state_; }
+
+/// Returns true if the transaction is waiting for a reply.
+inline bool
+Transaction::pending() const { return state_ == State::PENDING; }
+
+/// Returns true if the switch replied to the request with an error.
+inline bool
+Transaction::failed() const { return state_ == State::FAILED; }
+
+/// Returns true if the transaction expired without a reply.
+inline bool
+Transaction::expired() const { return state_ == State::EXPIRED; }
+
+/// Returns the encoded reply messages.
+inline const Buffer&
+Transaction::reply() const { return reply_; }
+
+/// Set the handler to be called when the transaction completes or
+/// expires. If the transaction is no longer pending, the handler is
+/// called immediately.
+inline void
+Transaction::then(Handler h) {
+  handler_ = std::move(h);
+  if (not pending())
+    notify();
+}
+
+/// Append a reply message to the transaction.
+inline void
+Transaction::append(const Buffer& b) {
+  assert(pending());
+  reply_.insert(reply_.end(), b.begin(), b.end());
+}
+
+/// Indicate that the last reply message has been received.
+inline void
+Transaction::complete() {
+  assert(pending());
+  state_ = State::COMPLETE;
+  notify();
+}
+
+/// Indicate that the switch rejected the request with the error message
+/// e. Any partial reply is replaced by the error message.
+inline void
+Transaction::fail(const Buffer& e) {
+  assert(pending());
+  state_ = State::FAILED;
+  reply_ = e;
+  notify();
+}
+
+/// Indicate that no reply was received before the deadline. Any partial
+/// reply is discarded.
+inline void
+Transaction::expire() {
+  assert(pending());
+  state_ = State::EXPIRED;
+  reply_.clear();
+  notify();
+}
+
+inline void
+Transaction::notify() {
+  if (handler_) {
+    Handler h = std::move(handler_);
+    handler_ = nullptr;
+    h(*this);
+  }
+}
+
+// -------------------------------------------------------------------------- //
+// Reply future
+
+inline
+Reply_future::Reply_future(std::shared_ptr<Transaction> t)
+  : txn_(std::move(t)) { }
+
+/// Returns true if the future refers to a transaction.
+inline bool
+Reply_future::valid() const { return (bool)txn_; }
+
+/// Returns true if the transaction has completed, failed or expired.
+inline bool
+Reply_future::ready() const {
+  assert(valid());
+  return not txn_->pending();
+}
+
+/// Returns true if the switch replied with an error.
+inline bool
+Reply_future::failed() const {
+  assert(valid());
+  return txn_->failed();
+}
+
+/// Returns true if the transaction expired.
+inline bool
+Reply_future::expired() const {
+  assert(valid());
+  return txn_->expired();
+}
+
+/// Returns the reply of a completed transaction, or the error message
+/// of a failed one.
+inline const Buffer&
+Reply_future::get() const {
+  assert(ready());
+  return txn_->reply();
+}
+
+/// Set the handler to be called when the transaction is ready.
+inline void
+Reply_future::then(Transaction::Handler h) {
+  assert(valid());
+  txn_->then(std::move(h));
+}
+
+} // namespace freeflow
@@ -0,0 +1,147 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+#include <cstdint>
+#include <new>
+
+#include "arena.hpp"
+
+namespace freeflow {
+
+namespace {
+
+/// The heap resource allocates memory using operator new.
+struct Heap_resource : Memory_resource {
+  void* do_allocate(std::size_t n, std::size_t) override {
+    return ::operator new(n);
+  }
+
+  void do_deallocate(void* p, std::size_t, std::size_t) override {
+    ::operator delete(p);
+  }
+};
+
+// The current resource for the calling thread. When null, the heap
+// resource is current.
+thread_local Memory_resource* current_ = nullptr;
+
+// Returns p rounded up to a multiple of a, which is a power of two.
+inline char*
+align_up(char* p, std::size_t a) {
+  std::uintptr_t n = reinterpret_cast<std::uintptr_t>(p);
+  return reinterpret_cast<char*>((n + a - 1) & ~std::uintptr_t(a - 1));
+}
+
+} // namespace
+
+/// Returns the resource that allocates from the free store.
+Memory_resource*
+heap_resource() {
+  static Heap_resource heap_;
+  return &heap_;
+}
+
+/// Returns the resource that is current for the calling thread. This is
+/// the heap resource unless a Resource_scope has been entered.
+Memory_resource*
+current_resource() { return current_ ? current_ : heap_resource(); }
+
+// -------------------------------------------------------------------------- //
+// Arena
+
+/// Each block is a header followed by its storage.
+struct Arena::Block {
+  Block*      next;
+  std::size_t size;
+};
+
+constexpr std::size_t Arena::default_size;
+
+/// Initialize the arena so that its first block has at least n bytes.
+/// No memory is allocated until the first request.
+Arena::Arena(std::size_t n)
+  : head_(nullptr), first_(nullptr), last_(nullptr)
+  , next_(std::max<std::size_t>(n, 64)), allocated_(0)
+{ }
+
+Arena::~Arena() {
+  release();
+}
+
+/// Returns the number of blocks allocated by the arena.
+std::size_t
+Arena::blocks() const {
+  std::size_t n = 0;
+  for (Block* b = head_; b; b = b->next)
+    ++n;
+  return n;
+}
+
+/// Free all memory allocated by the arena, and start a new generation.
+/// Objects allocated from the arena must have been destroyed.
+///
+/// \todo Retain the largest block for reuse.
+void
+Arena::release() {
+  while (head_) {
+    Block* b = head_;
+    head_ = b->next;
+    ::operator delete(b);
+  }
+  first_ = last_ = nullptr;
+  allocated_ = 0;
+  ++generation_;
+}
+
+void*
+Arena::do_allocate(std::size_t n, std::size_t a) {
+  char* p = align_up(first_, a);
+  if (not first_ or p + n > last_) {
+    grow(n, a);
+    p = align_up(first_, a);
+  }
+  first_ = p + n;
+  allocated_ += n;
+  return p;
+}
+
+/// Allocate a new block with at least n bytes aligned to a. Block sizes
+/// double, so the number of blocks is logarithmic in the total amount
+/// of memory allocated.
+void
+Arena::grow(std::size_t n, std::size_t a) {
+  std::size_t size = std::max(next_, n + a);
+  void* p = ::operator new(sizeof(Block) + size);
+  Block* b = new (p) Block{head_, size};
+  head_ = b;
+  first_ = reinterpret_cast<char*>(b + 1);
+  last_ = first_ + size;
+  next_ = size * 2;
+}
+
+// -------------------------------------------------------------------------- //
+// Resource scope
+
+Resource_scope::Resource_scope(Memory_resource& r)
+  : prev_(current_)
+{
+  current_ = &r;
+}
+
+Resource_scope::~Resource_scope() {
+  current_ = prev_;
+}
+
+} // namespace freeflow
@@ -0,0 +1,177 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_ARENA_HPP
+#define FREEFLOW_ARENA_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+/// \file arena.hpp
+/// Memory resources and arena allocation.
+///
+/// A memory resource is a source of memory that can be shared by many
+/// containers. The Arena is a monotonic resource: allocation advances
+/// a pointer through large blocks, deallocation does nothing, and all
+/// memory is released at once. Arenas are used to decode messages whose
+/// lifetimes end together (e.g., all messages read in a single burst).
+///
+/// Containers allocate from a resource through the Resource_allocator.
+/// A default-constructed allocator uses the current resource, which is
+/// established for a thread by a Resource_scope:
+///
+///   Arena arena;
+///   {
+///     Resource_scope s(arena);
+///     from_view(v, msg);  // Sequences in msg allocate from the arena
+///   }
+///   // ... use and destroy msg
+///   arena.release();
+///
+/// Objects allocated from an arena must be destroyed before it is
+/// released. Each release starts a new generation of the arena, and an
+/// allocator asserts that its resource is still in the generation in
+/// which the allocator was created. A container moved out of the scope
+/// and destroyed (or grown) after the release is caught in debug builds.
+
+namespace freeflow {
+
+// -------------------------------------------------------------------------- //
+// Memory resources
+
+/// The Memory_resource class is the abstract interface of memory sources.
+/// The generation of a resource changes whenever its memory is reclaimed
+/// in bulk.
+class Memory_resource {
+public:
+  Memory_resource();
+  virtual ~Memory_resource() { }
+
+  void* allocate(std::size_t n, std::size_t a = alignof(std::max_align_t));
+  void deallocate(void* p, std::size_t n, 
+                  std::size_t a = alignof(std::max_align_t));
+
+  std::size_t generation() const;
+
+protected:
+  virtual void* do_allocate(std::size_t, std::size_t) = 0;
+  virtual void do_deallocate(void*, std::size_t, std::size_t) = 0;
+
+  std::size_t generation_;
+};
+
+Memory_resource* heap_resource();
+Memory_resource* current_resource();
+
+
+/// The Arena is a monotonic memory resource. Memory is allocated from
+/// a list of blocks, each twice the size of the last, and is freed only
+/// when the arena is released or destroyed.
+class Arena : public Memory_resource {
+  struct Block;
+public:
+  static constexpr std::size_t default_size = 4096;
+
+  explicit Arena(std::size_t n = default_size);
+  ~Arena();
+
+  // Not copyable
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  // Observers
+  std::size_t allocated() const;
+  std::size_t blocks() const;
+
+  // Mutators
+  void release();
+
+protected:
+  void* do_allocate(std::size_t, std::size_t) override;
+  void do_deallocate(void*, std::size_t, std::size_t) override;
+
+private:
+  void grow(std::size_t, std::size_t);
+
+  Block*      head_;      // The most recently allocated block
+  char*       first_;     // The next free byte in the current block
+  char*       last_;      // The end of the current block
+  std::size_t next_;      // The size of the next block
+  std::size_t allocated_; // The number of bytes allocated
+};
+
+
+/// A Resource_scope makes a memory resource current for the calling
+/// thread for its lifetime. Scopes nest; the previously current
+/// resource is restored when the scope ends.
+class Resource_scope {
+public:
+  explicit Resource_scope(Memory_resource&);
+  ~Resource_scope();
+
+  Resource_scope(const Resource_scope&) = delete;
+  Resource_scope& operator=(const Resource_scope&) = delete;
+
+private:
+  Memory_resource* prev_;
+};
+
+// -------------------------------------------------------------------------- //
+// Allocator
+
+/// The Resource_allocator allocates objects of type T from a memory
+/// resource. A default-constructed allocator uses the current resource.
+/// Allocators are not propagated when containers are copied or assigned,
+/// and a copy of a container uses the resource current at that time.
+template<typename T>
+  class Resource_allocator {
+  public:
+    using value_type = T;
+
+    using propagate_on_container_copy_assignment = std::false_type;
+    using propagate_on_container_move_assignment = std::false_type;
+    using propagate_on_container_swap = std::false_type;
+
+    Resource_allocator();
+    Resource_allocator(Memory_resource*);
+
+    template<typename U>
+      Resource_allocator(const Resource_allocator<U>&);
+
+    T* allocate(std::size_t);
+    void deallocate(T*, std::size_t);
+
+    Resource_allocator select_on_container_copy_construction() const;
+
+    Memory_resource* resource() const;
+    std::size_t generation() const;
+
+  private:
+    Memory_resource* res_;
+    std::size_t      gen_; // The generation of res_ when created
+  };
+
+// Equality comparison
+template<typename T, typename U>
+  bool operator==(const Resource_allocator<T>&, const Resource_allocator<U>&);
+
+template<typename T, typename U>
+  bool operator!=(const Resource_allocator<T>&, const Resource_allocator<U>&);
+
+} // namespace freeflow
+
+#include "arena.ipp"
+
+#endif
@@ -0,0 +1,118 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+// -------------------------------------------------------------------------- //
+// Memory resource
+
+inline
+Memory_resource::Memory_resource() : generation_(0) { }
+
+/// Allocate n bytes aligned to a. Throws bad_alloc if the memory cannot
+/// be allocated.
+inline void*
+Memory_resource::allocate(std::size_t n, std::size_t a) {
+  return do_allocate(n, a);
+}
+
+/// Return the memory allocated at p to the resource.
+inline void
+Memory_resource::deallocate(void* p, std::size_t n, std::size_t a) {
+  do_deallocate(p, n, a);
+}
+
+/// Returns the current generation of the resource.
+inline std::size_t
+Memory_resource::generation() const { return generation_; }
+
+// -------------------------------------------------------------------------- //
+// Arena
+
+/// Returns the number of bytes allocated from the arena since it
+/// was last released.
+inline std::size_t
+Arena::allocated() const { return allocated_; }
+
+/// Memory allocated from an arena is not reclaimed until the arena
+/// is released.
+inline void
+Arena::do_deallocate(void*, std::size_t, std::size_t) { }
+
+// -------------------------------------------------------------------------- //
+// Resource allocator
+
+template<typename T>
+  inline
+  Resource_allocator<T>::Resource_allocator()
+    : res_(current_resource()), gen_(res_->generation())
+  { }
+
+template<typename T>
+  inline
+  Resource_allocator<T>::Resource_allocator(Memory_resource* r)
+    : res_(r), gen_(r->generation())
+  { }
+
+template<typename T>
+  template<typename U>
+    inline
+    Resource_allocator<T>::Resource_allocator(const Resource_allocator<U>& a)
+      : res_(a.resource()), gen_(a.generation())
+    { }
+
+template<typename T>
+  inline T*
+  Resource_allocator<T>::allocate(std::size_t n) {
+    assert(res_->generation() == gen_);
+    return static_cast<T*>(res_->allocate(n * sizeof(T), alignof(T)));
+  }
+
+template<typename T>
+  inline void
+  Resource_allocator<T>::deallocate(T* p, std::size_t n) {
+    assert(res_->generation() == gen_);
+    res_->deallocate(p, n * sizeof(T), alignof(T));
+  }
+
+template<typename T>
+  inline Resource_allocator<T>
+  Resource_allocator<T>::select_on_container_copy_construction() const {
+    return Resource_allocator();
+  }
+
+template<typename T>
+  inline Memory_resource*
+  Resource_allocator<T>::resource() const { return res_; }
+
+/// Returns the generation of the resource when the allocator was created.
+/// Memory may only be allocated or returned while the resource remains
+/// in that generation.
+template<typename T>
+  inline std::size_t
+  Resource_allocator<T>::generation() const { return gen_; }
+
+template<typename T, typename U>
+  inline bool
+  operator==(const Resource_allocator<T>& a, const Resource_allocator<U>& b) {
+    return a.resource() == b.resource();
+  }
+
+template<typename T, typename U>
+  inline bool
+  operator!=(const Resource_allocator<T>& a, const Resource_allocator<U>& b) {
+    return a.resource() != b.resource();
+  }
+
+} // namespace freeflow
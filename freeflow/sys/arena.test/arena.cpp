@@ -0,0 +1,85 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+#include <freeflow/sys/arena.hpp>
+
+using namespace freeflow;
+
+using Vec = std::vector<int, Resource_allocator<int>>;
+
+int main() {
+  // Allocations are aligned and grow the arena by blocks.
+  {
+    Arena a(64);
+    void* p = a.allocate(3, 1);
+    void* q = a.allocate(8, 8);
+    assert(reinterpret_cast<std::uintptr_t>(q) % 8 == 0);
+    assert(p != q);
+    assert(a.blocks() == 1);
+    a.allocate(1000);
+    assert(a.blocks() == 2);
+    assert(a.allocated() == 1011);
+    a.release();
+    assert(a.blocks() == 0);
+    assert(a.allocated() == 0);
+  }
+
+  // Containers allocate from the current resource.
+  {
+    Arena a;
+    assert(current_resource() == heap_resource());
+    {
+      Resource_scope s(a);
+      assert(current_resource() == &a);
+      Vec v;
+      for (int i = 0; i < 100; ++i)
+        v.push_back(i);
+      assert(v.get_allocator().resource() == &a);
+      assert(a.allocated() >= 100 * sizeof(int));
+
+      // Copies use the resource that is current when they are made.
+      Arena b;
+      Resource_scope t(b);
+      Vec w = v;
+      assert(w.get_allocator().resource() == &b);
+    }
+    assert(current_resource() == heap_resource());
+    Vec v;
+    assert(v.get_allocator().resource() == heap_resource());
+  }
+
+  // Allocators record the generation of their resource. Releasing an
+  // arena starts a new generation, so containers created before the
+  // release may no longer allocate from it.
+  {
+    Arena a;
+    std::size_t g = a.generation();
+    {
+      Resource_scope s(a);
+      Vec v(10);
+      assert(v.get_allocator().generation() == g);
+      Vec w = std::move(v);
+      assert(w.get_allocator().resource() == &a);
+      assert(w.get_allocator().generation() == g);
+    }
+    a.release();
+    assert(a.generation() != g);
+    Resource_scope s(a);
+    Vec v(10);
+    assert(v.get_allocator().generation() == a.generation());
+  }
+}
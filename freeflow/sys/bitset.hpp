@@ -0,0 +1,96 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_BITSET_HPP
+#define FREEFLOW_BITSET_HPP
+
+#include <cstddef>
+#include <initializer_list>
+
+#include <freeflow/sys/data.hpp>
+
+/// \file bitset.hpp
+/// Packed sets of flags.
+///
+/// A Bitset stores a set of boolean flags, each identified by an
+/// enumerator, in an array of 64-bit words. Set operations and subset
+/// tests operate a word at a time. For example, checking that a switch
+/// supports every action required by a flow is a single AND and compare:
+///
+///   enum class Color { RED, GREEN, BLUE };
+///   using Colors = Bitset<Color, 3>;
+///
+///   Colors have {Color::RED, Color::BLUE};
+///   have.contains({Color::RED}); // true
+
+namespace freeflow {
+
+/// A Bitset is a set of N flags indexed by the enumeration E. The
+/// enumerators of E must have values in the range [0, N).
+template<typename E, std::size_t N>
+  class Bitset {
+  public:
+    static constexpr std::size_t size = N;
+    static constexpr std::size_t words = (N + 63) / 64;
+
+    Bitset();
+    explicit Bitset(Uint64);
+    Bitset(std::initializer_list<E>);
+
+    // Observers
+    bool test(E) const;
+    bool any() const;
+    bool none() const;
+    std::size_t count() const;
+    bool contains(const Bitset&) const;
+    Uint64 word(std::size_t) const;
+
+    // Mutators
+    Bitset& set(E, bool = true);
+    Bitset& reset(E);
+    Bitset& clear();
+
+    Bitset& operator&=(const Bitset&);
+    Bitset& operator|=(const Bitset&);
+
+  private:
+    static std::size_t index(E);
+    static Uint64 bit(E);
+
+    Uint64 bits_[words];
+  };
+
+// Equality comparison
+template<typename E, std::size_t N>
+  bool operator==(const Bitset<E, N>&, const Bitset<E, N>&);
+
+template<typename E, std::size_t N>
+  bool operator!=(const Bitset<E, N>&, const Bitset<E, N>&);
+
+// Ordering
+template<typename E, std::size_t N>
+  bool operator<(const Bitset<E, N>&, const Bitset<E, N>&);
+
+// Set operations
+template<typename E, std::size_t N>
+  Bitset<E, N> operator&(const Bitset<E, N>&, const Bitset<E, N>&);
+
+template<typename E, std::size_t N>
+  Bitset<E, N> operator|(const Bitset<E, N>&, const Bitset<E, N>&);
+
+} // namespace freeflow
+
+#include <freeflow/sys/bitset.ipp>
+
+#endif
@@ -0,0 +1,183 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <algorithm>
+
+namespace freeflow {
+
+template<typename E, std::size_t N>
+  constexpr std::size_t Bitset<E, N>::size;
+
+template<typename E, std::size_t N>
+  constexpr std::size_t Bitset<E, N>::words;
+
+/// Initialize an empty set.
+template<typename E, std::size_t N>
+  inline
+  Bitset<E, N>::Bitset() { clear(); }
+
+/// Initialize the set from the low-order bits of n. The ith bit of n
+/// gives the flag whose enumerator has the value i. This is used to
+/// initialize sets from the bitmasks of protocol messages.
+template<typename E, std::size_t N>
+  inline
+  Bitset<E, N>::Bitset(Uint64 n) {
+    clear();
+    bits_[0] = N >= 64 ? n : n & ((Uint64(1) << N) - 1);
+  }
+
+/// Initialize the set with the given flags.
+template<typename E, std::size_t N>
+  inline
+  Bitset<E, N>::Bitset(std::initializer_list<E> list) {
+    clear();
+    for (E e : list)
+      set(e);
+  }
+
+/// Returns true if the flag e is set.
+template<typename E, std::size_t N>
+  inline bool
+  Bitset<E, N>::test(E e) const { return bits_[index(e)] & bit(e); }
+
+/// Returns true if any flag is set.
+template<typename E, std::size_t N>
+  inline bool
+  Bitset<E, N>::any() const { return not none(); }
+
+/// Returns true if no flag is set.
+template<typename E, std::size_t N>
+  inline bool
+  Bitset<E, N>::none() const {
+    for (Uint64 w : bits_)
+      if (w)
+        return false;
+    return true;
+  }
+
+/// Returns the number of flags that are set.
+template<typename E, std::size_t N>
+  inline std::size_t
+  Bitset<E, N>::count() const {
+    std::size_t n = 0;
+    for (Uint64 w : bits_)
+      for (; w; w &= w - 1)
+        ++n;
+    return n;
+  }
+
+/// Returns true if every flag set in s is also set in this set.
+template<typename E, std::size_t N>
+  inline bool
+  Bitset<E, N>::contains(const Bitset& s) const {
+    for (std::size_t i = 0; i < words; ++i)
+      if ((bits_[i] & s.bits_[i]) != s.bits_[i])
+        return false;
+    return true;
+  }
+
+/// Returns the ith word of the set.
+template<typename E, std::size_t N>
+  inline Uint64
+  Bitset<E, N>::word(std::size_t i) const { return bits_[i]; }
+
+/// Set the flag e to the value b.
+template<typename E, std::size_t N>
+  inline Bitset<E, N>&
+  Bitset<E, N>::set(E e, bool b) {
+    if (b)
+      bits_[index(e)] |= bit(e);
+    else
+      bits_[index(e)] &= ~bit(e);
+    return *this;
+  }
+
+/// Clear the flag e.
+template<typename E, std::size_t N>
+  inline Bitset<E, N>&
+  Bitset<E, N>::reset(E e) { return set(e, false); }
+
+/// Clear all flags.
+template<typename E, std::size_t N>
+  inline Bitset<E, N>&
+  Bitset<E, N>::clear() {
+    std::fill(bits_, bits_ + words, 0);
+    return *this;
+  }
+
+template<typename E, std::size_t N>
+  inline Bitset<E, N>&
+  Bitset<E, N>::operator&=(const Bitset& s) {
+    for (std::size_t i = 0; i < words; ++i)
+      bits_[i] &= s.bits_[i];
+    return *this;
+  }
+
+template<typename E, std::size_t N>
+  inline Bitset<E, N>&
+  Bitset<E, N>::operator|=(const Bitset& s) {
+    for (std::size_t i = 0; i < words; ++i)
+      bits_[i] |= s.bits_[i];
+    return *this;
+  }
+
+template<typename E, std::size_t N>
+  inline std::size_t
+  Bitset<E, N>::index(E e) { return std::size_t(e) / 64; }
+
+template<typename E, std::size_t N>
+  inline Uint64
+  Bitset<E, N>::bit(E e) { return Uint64(1) << (std::size_t(e) % 64); }
+
+template<typename E, std::size_t N>
+  inline bool
+  operator==(const Bitset<E, N>& a, const Bitset<E, N>& b) {
+    for (std::size_t i = 0; i < Bitset<E, N>::words; ++i)
+      if (a.word(i) != b.word(i))
+        return false;
+    return true;
+  }
+
+template<typename E, std::size_t N>
+  inline bool
+  operator!=(const Bitset<E, N>& a, const Bitset<E, N>& b) {
+    return not (a == b);
+  }
+
+/// Sets are ordered lexicographically by their words. This allows sets
+/// to be used as keys of ordered containers.
+template<typename E, std::size_t N>
+  inline bool
+  operator<(const Bitset<E, N>& a, const Bitset<E, N>& b) {
+    for (std::size_t i = 0; i < Bitset<E, N>::words; ++i)
+      if (a.word(i) != b.word(i))
+        return a.word(i) < b.word(i);
+    return false;
+  }
+
+template<typename E, std::size_t N>
+  inline Bitset<E, N>
+  operator&(const Bitset<E, N>& a, const Bitset<E, N>& b) {
+    Bitset<E, N> r = a;
+    return r &= b;
+  }
+
+template<typename E, std::size_t N>
+  inline Bitset<E, N>
+  operator|(const Bitset<E, N>& a, const Bitset<E, N>& b) {
+    Bitset<E, N> r = a;
+    return r |= b;
+  }
+
+} // namespace freeflow
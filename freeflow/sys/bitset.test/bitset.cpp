@@ -0,0 +1,63 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+
+#include <freeflow/sys/bitset.hpp>
+
+// Test set operations on bitsets spanning several words.
+
+using namespace freeflow;
+
+enum class Flag { A = 0, B = 1, C = 63, D = 64, E = 99 };
+
+using Flags = Bitset<Flag, 100>;
+
+int main() {
+  static_assert(Flags::words == 2, "");
+
+  Flags a;
+  assert(a.none());
+  assert(a.count() == 0);
+
+  a.set(Flag::A).set(Flag::C).set(Flag::E);
+  assert(a.test(Flag::A));
+  assert(not a.test(Flag::B));
+  assert(a.test(Flag::C));
+  assert(not a.test(Flag::D));
+  assert(a.count() == 3);
+
+  // Subsets
+  Flags b {Flag::C, Flag::E};
+  assert(a.contains(b));
+  assert(not b.contains(a));
+  b.set(Flag::D);
+  assert(not a.contains(b));
+  assert((a & b) == Flags({Flag::C, Flag::E}));
+  assert((a | b).count() == 4);
+
+  b.reset(Flag::D);
+  assert(a != b);
+  assert(b < a or a < b);
+  a.set(Flag::A, false);
+  assert(a == b);
+  assert(not (a < b) and not (b < a));
+
+  // Initialization from a bitmask
+  Flags c(0x3);
+  assert(c == Flags({Flag::A, Flag::B}));
+  assert(c.word(1) == 0);
+  c.clear();
+  assert(c.none());
+}
@@ -115,7 +115,7 @@ Constrained_view::~Constrained_view() {
 }
 
 inline
-Constrained_view::operator View&() { return constraint.view; }
+Constrained_view::operator View&() { return view; }
 
 inline
 Constrained_view::operator bool() const { 
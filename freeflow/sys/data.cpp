@@ -13,3 +13,115 @@
 // permissions and limitations under the License.
 
 #include "data.hpp"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define FREEFLOW_X86_SIMD
+#  include <immintrin.h>
+#endif
+
+namespace freeflow {
+
+namespace {
+
+// -------------------------------------------------------------------------- //
+// Scalar conversions
+
+template<typename T>
+  void
+  msbf_copy_scalar(void* out, const void* in, std::size_t n) {
+    const char* p = static_cast<const char*>(in);
+    char* q = static_cast<char*>(out);
+    for (; n != 0; --n, p += sizeof(T), q += sizeof(T)) {
+      T x;
+      std::memcpy(&x, p, sizeof(T));
+      x = Byte_order::msbf(x);
+      std::memcpy(q, &x, sizeof(T));
+    }
+  }
+
+using Copy_fn = void (*)(void*, const void*, std::size_t);
+
+#if defined(FREEFLOW_LITTLE_ENDIAN) && defined(FREEFLOW_X86_SIMD)
+
+// -------------------------------------------------------------------------- //
+// Vectorized conversions
+//
+// Each function reverses the bytes of every W-byte lane of a vector
+// using a byte shuffle. Any remaining values are converted by the
+// scalar loop.
+
+template<typename T>
+  __attribute__((target("ssse3"))) void
+  msbf_copy_ssse3(void* out, const void* in, std::size_t n) {
+    const __m128i mask = sizeof(T) == 8
+      ? _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7)
+      : _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    constexpr std::size_t k = 16 / sizeof(T);
+    const char* p = static_cast<const char*>(in);
+    char* q = static_cast<char*>(out);
+    for (; n >= k; n -= k, p += 16, q += 16) {
+      __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+      x = _mm_shuffle_epi8(x, mask);
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(q), x);
+    }
+    msbf_copy_scalar<T>(q, p, n);
+  }
+
+template<typename T>
+  __attribute__((target("avx2"))) void
+  msbf_copy_avx2(void* out, const void* in, std::size_t n) {
+    const __m256i mask = sizeof(T) == 8
+      ? _mm256_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7,
+                        8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7)
+      : _mm256_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+                        12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+    constexpr std::size_t k = 32 / sizeof(T);
+    const char* p = static_cast<const char*>(in);
+    char* q = static_cast<char*>(out);
+    for (; n >= k; n -= k, p += 32, q += 32) {
+      __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+      x = _mm256_shuffle_epi8(x, mask);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(q), x);
+    }
+    msbf_copy_scalar<T>(q, p, n);
+  }
+
+// Select the best conversion supported by the host.
+template<typename T>
+  Copy_fn
+  select_msbf_copy() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+      return msbf_copy_avx2<T>;
+    if (__builtin_cpu_supports("ssse3"))
+      return msbf_copy_ssse3<T>;
+    return msbf_copy_scalar<T>;
+  }
+
+#else
+
+// On big endian hosts, this is just a copy. Otherwise, there is no
+// vector support, and the scalar conversion is used.
+template<typename T>
+  Copy_fn
+  select_msbf_copy() { return msbf_copy_scalar<T>; }
+
+#endif
+
+} // namespace
+
+void
+msbf_copy_32(void* out, const void* in, std::size_t n) {
+  static const Copy_fn copy = select_msbf_copy<Uint32>();
+  copy(out, in, n);
+}
+
+void
+msbf_copy_64(void* out, const void* in, std::size_t n) {
+  static const Copy_fn copy = select_msbf_copy<Uint64>();
+  copy(out, in, n);
+}
+
+} // namespace freeflow
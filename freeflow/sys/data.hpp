@@ -15,6 +15,7 @@
 #ifndef FREEFLOW_DATA_HPP
 #define FREEFLOW_DATA_HPP
 
+#include <cstddef>
 #include <cstdint>
 
 #include <freeflow/sys/meta.hpp>
@@ -71,6 +72,17 @@ struct Byte_order {
   static Uint64 lsbf(Uint64 v) { return ff_lsbf_16(v); }
 };
 
+// Bulk byte order
+//
+// These functions reorder arrays of values in a single pass. They are
+// used to decode long runs of integers (e.g., statistics counters)
+// from network buffers. The input and output need not be aligned, but
+// shall not overlap unless they are the same. When the host supports
+// it, the conversion is vectorized (SSSE3 or AVX2), and the best
+// available implementation is chosen at run time.
+void msbf_copy_32(void* out, const void* in, std::size_t n);
+void msbf_copy_64(void* out, const void* in, std::size_t n);
+
 } // namespace freeflow
 
 #endif
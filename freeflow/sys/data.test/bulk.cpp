@@ -0,0 +1,53 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+#include <cstring>
+#include <freeflow/sys/data.hpp>
+
+using namespace freeflow;
+
+// Test the bulk byte-order conversions against the scalar conversions.
+// Sizes are chosen to exercise both the vector and the remaining scalar
+// parts of the conversion.
+
+template<typename T>
+  void
+  test(void (*copy)(void*, const void*, std::size_t)) {
+    for (std::size_t n = 0; n < 40; ++n) {
+      T in[40];
+      T out[40];
+      for (std::size_t i = 0; i < n; ++i)
+        in[i] = static_cast<T>(0x0102030405060708ull * (i + 1));
+      copy(out, in, n);
+      for (std::size_t i = 0; i < n; ++i)
+        assert(out[i] == Byte_order::msbf(in[i]));
+
+      // Conversion in place.
+      copy(in, in, n);
+      assert(std::memcmp(in, out, n * sizeof(T)) == 0);
+    }
+  }
+
+int main() {
+  test<Uint32>(msbf_copy_32);
+  test<Uint64>(msbf_copy_64);
+
+  // Unaligned input.
+  unsigned char buf[17] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 6, 7, 8};
+  Uint64 x[2];
+  msbf_copy_64(x, buf + 1, 2);
+  assert(x[0] == 0x0102030405060708ull);
+  assert(x[1] == 0x0102030405060708ull);
+}
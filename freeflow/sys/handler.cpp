@@ -54,7 +54,7 @@ Handler_registry::remove(Event_handler* h) {
 
   // Update internal tables based on the handler's current subscriptions,
   // but do not modfiy the handler.
-  on_unsubscribe(h);
+  on_unsubscribe(h, h->events());
   
   // Remove the handler.
   reg_[h->fd()] = nullptr;
@@ -81,7 +81,7 @@ void
 Handler_registry::unsubscribe(Event_handler* h, Event_mask m) {
   assert(reg_[h->fd()] == h);
   h->unsubscribe(m);
-  on_unsubscribe(h);
+  on_unsubscribe(h, m);
 }
 
 /// Update internal tables based on subscriptions.
@@ -95,14 +95,15 @@ Handler_registry::on_subscribe(Event_handler* h) {
     wait_.except.insert(h->fd());
 }
 
-/// Update internal tables based on subscriptions.
+/// Update internal tables when the handler no longer waits for the
+/// events in m. Other subscriptions are unaffected.
 void
-Handler_registry::on_unsubscribe(Event_handler* h) {
-  if (h->events() & READ_EVENTS)
+Handler_registry::on_unsubscribe(Event_handler* h, Event_mask m) {
+  if (m & READ_EVENTS)
     wait_.read.remove(h->fd());
-  if (h->events() & WRITE_EVENTS)
+  if (m & WRITE_EVENTS)
     wait_.write.remove(h->fd());
-  if (h->events() & EXCEPT_EVENTS)
+  if (m & EXCEPT_EVENTS)
     wait_.except.remove(h->fd());
 }
 
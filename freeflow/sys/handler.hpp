@@ -198,7 +198,7 @@ public:
 
 private:
   void on_subscribe(Event_handler*);
-  void on_unsubscribe(Event_handler*);
+  void on_unsubscribe(Event_handler*, Event_mask);
 
 private:
   Registry  reg_;   // The registry
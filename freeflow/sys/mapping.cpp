@@ -0,0 +1,60 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "mapping.hpp"
+
+namespace freeflow {
+
+/// Map the file designated by the path name. The file is closed after
+/// it is mapped.
+Mapping::Mapping(const char* p) 
+  : data_(nullptr), size_(0)
+{
+  int fd = ::open(p, O_RDONLY);
+  if (fd < 0)
+    throw system_error();
+  struct stat s;
+  if (::fstat(fd, &s)) {
+    Error err = system_error();
+    ::close(fd);
+    throw err;
+  }
+  if (s.st_size > 0) {
+    void* m = ::mmap(nullptr, s.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (m == MAP_FAILED) {
+      Error err = system_error();
+      ::close(fd);
+      throw err;
+    }
+    data_ = static_cast<const Byte*>(m);
+    size_ = s.st_size;
+  }
+  ::close(fd);
+}
+
+/// Release the mapping, if any.
+void
+Mapping::unmap() {
+  if (data_)
+    ::munmap(const_cast<Byte*>(data_), size_);
+  data_ = nullptr;
+  size_ = 0;
+}
+
+} // namespace freeflow
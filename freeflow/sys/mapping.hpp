@@ -0,0 +1,66 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_MAPPING_HPP
+#define FREEFLOW_MAPPING_HPP
+
+#include <string>
+
+#include <freeflow/sys/buffer.hpp>
+#include <freeflow/sys/error.hpp>
+
+namespace freeflow {
+
+/// The Mapping class is a read-only memory mapping of an entire file.
+/// Pages of the file are loaded on first access, so mapping a large
+/// file is cheap and only the parts that are read cost I/O. The file
+/// may be removed or replaced while it is mapped.
+///
+/// A default constructed mapping, or one of an empty file, maps nothing.
+class Mapping {
+public:
+  Mapping();
+  ~Mapping();
+
+  // Move semantics
+  Mapping(Mapping&&);
+  Mapping& operator=(Mapping&&);
+
+  // Mappings are non-copyable
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  // Map a file
+  explicit Mapping(const char*);
+  explicit Mapping(const std::string&);
+
+  explicit operator bool() const;
+
+  // Observers
+  const Byte* data() const;
+  std::size_t size() const;
+
+  // Mutators
+  void unmap();
+
+private:
+  const Byte* data_;
+  std::size_t size_;
+};
+
+} // namespace freeflow
+
+#include <freeflow/sys/mapping.ipp>
+
+#endif
@@ -0,0 +1,58 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+inline
+Mapping::Mapping() : data_(nullptr), size_(0) { }
+
+inline
+Mapping::~Mapping() { unmap(); }
+
+inline
+Mapping::Mapping(Mapping&& x) 
+  : data_(x.data_), size_(x.size_) 
+{
+  x.data_ = nullptr;
+  x.size_ = 0;
+}
+
+inline Mapping&
+Mapping::operator=(Mapping&& x) {
+  if (this != &x) {
+    unmap();
+    data_ = x.data_;
+    size_ = x.size_;
+    x.data_ = nullptr;
+    x.size_ = 0;
+  }
+  return *this;
+}
+
+inline
+Mapping::Mapping(const std::string& p) : Mapping(p.c_str()) { }
+
+/// Evaluates to true when part of a file is mapped.
+inline
+Mapping::operator bool() const { return data_; }
+
+/// Returns the first byte of the mapped file.
+inline const Byte*
+Mapping::data() const { return data_; }
+
+/// Returns the number of mapped bytes.
+inline std::size_t
+Mapping::size() const { return size_; }
+
+} // namespace freeflow
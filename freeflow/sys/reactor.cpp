@@ -185,6 +185,9 @@ Reactor::run() {
   remove_handlers();
 }
 
+/// Run one iteration of the event loop, waiting at most us for resource
+/// events. Expired timers are dispatched even if no resources have events,
+/// so timers fire no later than us after their expiration.
 void
 Reactor::run(Microseconds us) {
   Resource_set close;
@@ -204,8 +207,9 @@ Reactor::run(Microseconds us) {
   // blocking system calls will actually be interrupted.
   // Signal_set sigs = Signal_set::all();
   
-  // Run select. Return when any event is detected, including signals.
-  int n = select();
+  // Run select. Return when any event is detected, including signals,
+  // or when the time slice has elapsed.
+  int n = select(us);
 
   // Notify handlers if signals are present. This is done 
   notify_signal(close);
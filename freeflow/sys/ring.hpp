@@ -0,0 +1,98 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_RING_HPP
+#define FREEFLOW_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/// \file ring.hpp
+/// Bounded single-producer, single-consumer queues.
+///
+/// A Ring is a fixed-capacity circular queue that may be shared by
+/// exactly two threads: one that pushes and one that pops. Neither side
+/// takes a lock or allocates memory. The producer and consumer indexes
+/// are kept on separate cache lines so that the two threads do not
+/// contend for the same line when the queue is neither empty nor full.
+///
+/// A full ring rejects new elements rather than growing. Callers are
+/// expected to treat a failed push as backpressure.
+
+namespace freeflow {
+
+/// The assumed size of a cache line, used to separate data written by
+/// different threads.
+constexpr std::size_t cache_line = 64;
+
+/// A Ring is a single-producer, single-consumer queue holding at most
+/// N elements of type T. N must be a power of two.
+///
+/// The indexes increase monotonically and are reduced modulo N when
+/// accessing a slot, so a full ring is distinguished from an empty one
+/// without sacrificing a slot.
+template<typename T, std::size_t N>
+  class Ring {
+    static_assert(N != 0 and (N & (N - 1)) == 0, 
+                  "ring capacity must be a power of two");
+  public:
+    Ring();
+    ~Ring();
+
+    Ring(const Ring&) = delete;
+    Ring& operator=(const Ring&) = delete;
+
+    // Observers
+    bool empty() const;
+    bool full() const;
+    std::size_t size() const;
+    static constexpr std::size_t capacity();
+
+    // Producer
+    bool push(const T&);
+    bool push(T&&);
+
+    template<typename... Args>
+      bool emplace(Args&&...);
+
+    // Consumer
+    T* front();
+    void pop();
+    bool pop(T&);
+
+  private:
+    using Slot = typename std::aligned_storage<sizeof(T), alignof(T)>::type;
+
+    T* slot(std::size_t);
+
+    // The consumer's index and its cached copy of the producer's index.
+    std::atomic<std::size_t> head_;
+    std::size_t tail_cache_;
+    char pad1_[cache_line];
+
+    // The producer's index and its cached copy of the consumer's index.
+    std::atomic<std::size_t> tail_;
+    std::size_t head_cache_;
+    char pad2_[cache_line];
+
+    Slot slots_[N];
+  };
+
+} // namespace freeflow
+
+#include <freeflow/sys/ring.ipp>
+
+#endif
@@ -0,0 +1,136 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+template<typename T, std::size_t N>
+  inline
+  Ring<T, N>::Ring()
+    : head_(0), tail_cache_(0), tail_(0), head_cache_(0) { }
+
+/// Destroy any elements remaining in the ring. The ring must not be
+/// in use by either thread.
+template<typename T, std::size_t N>
+  inline
+  Ring<T, N>::~Ring() {
+    while (front())
+      pop();
+  }
+
+/// Returns true if the ring holds no elements. The result may be stale
+/// when observed by the producer.
+template<typename T, std::size_t N>
+  inline bool
+  Ring<T, N>::empty() const {
+    return head_.load(std::memory_order_acquire) 
+        == tail_.load(std::memory_order_acquire);
+  }
+
+/// Returns true if no more elements can be pushed. The result may be
+/// stale when observed by the consumer.
+template<typename T, std::size_t N>
+  inline bool
+  Ring<T, N>::full() const { return size() == N; }
+
+/// Returns the number of elements in the ring.
+template<typename T, std::size_t N>
+  inline std::size_t
+  Ring<T, N>::size() const {
+    std::size_t h = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - h;
+  }
+
+/// Returns the maximum number of elements in the ring.
+template<typename T, std::size_t N>
+  constexpr std::size_t
+  Ring<T, N>::capacity() { return N; }
+
+/// Copy x into the ring. Returns false if the ring is full.
+template<typename T, std::size_t N>
+  inline bool
+  Ring<T, N>::push(const T& x) { return emplace(x); }
+
+/// Move x into the ring. Returns false, leaving x unchanged, if the ring 
+/// is full.
+template<typename T, std::size_t N>
+  inline bool
+  Ring<T, N>::push(T&& x) { return emplace(std::move(x)); }
+
+/// Construct an element at the back of the ring from the given
+/// arguments. Returns false if the ring is full. This must only be
+/// called by the producer.
+///
+/// The consumer's index is re-read only when the cached copy suggests
+/// that the ring is full.
+template<typename T, std::size_t N>
+  template<typename... Args>
+    inline bool
+    Ring<T, N>::emplace(Args&&... args) {
+      std::size_t t = tail_.load(std::memory_order_relaxed);
+      if (t - head_cache_ == N) {
+        head_cache_ = head_.load(std::memory_order_acquire);
+        if (t - head_cache_ == N)
+          return false;
+      }
+      new (slot(t)) T(std::forward<Args>(args)...);
+      tail_.store(t + 1, std::memory_order_release);
+      return true;
+    }
+
+/// Returns a pointer to the element at the front of the ring, or nullptr
+/// if the ring is empty. The element remains in the ring until it is 
+/// popped. This must only be called by the consumer.
+template<typename T, std::size_t N>
+  inline T*
+  Ring<T, N>::front() {
+    std::size_t h = head_.load(std::memory_order_relaxed);
+    if (h == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (h == tail_cache_)
+        return nullptr;
+    }
+    return slot(h);
+  }
+
+/// Destroy the element at the front of the ring. Behavior is undefined
+/// if front() has not returned an element. This must only be called by
+/// the consumer.
+template<typename T, std::size_t N>
+  inline void
+  Ring<T, N>::pop() {
+    std::size_t h = head_.load(std::memory_order_relaxed);
+    slot(h)->~T();
+    head_.store(h + 1, std::memory_order_release);
+  }
+
+/// Move the element at the front of the ring into x and remove it.
+/// Returns false if the ring is empty.
+template<typename T, std::size_t N>
+  inline bool
+  Ring<T, N>::pop(T& x) {
+    if (T* p = front()) {
+      x = std::move(*p);
+      pop();
+      return true;
+    }
+    return false;
+  }
+
+template<typename T, std::size_t N>
+  inline T*
+  Ring<T, N>::slot(std::size_t i) { 
+    return reinterpret_cast<T*>(&slots_[i & (N - 1)]); 
+  }
+
+} // namespace freeflow
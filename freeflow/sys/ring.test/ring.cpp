@@ -0,0 +1,79 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <cassert>
+#include <memory>
+#include <thread>
+
+#include <freeflow/sys/ring.hpp>
+
+using namespace freeflow;
+
+// Test the ring from a single thread: capacity, ordering, wrap-around
+// and destruction of non-trivial elements.
+void test_sequential() {
+  Ring<std::unique_ptr<int>, 4> r;
+  assert(r.empty());
+  assert(r.capacity() == 4);
+
+  for (int i = 0; i < 4; ++i)
+    assert(r.emplace(new int(i)));
+  assert(r.full());
+  assert(not r.push(std::unique_ptr<int>(new int(4))));
+
+  std::unique_ptr<int> x;
+  assert(r.pop(x) and *x == 0);
+  assert(**r.front() == 1);
+  r.pop();
+  assert(r.size() == 2);
+
+  // Wrap around the end of the slots.
+  assert(r.emplace(new int(4)));
+  assert(r.emplace(new int(5)));
+  assert(not r.push(std::unique_ptr<int>(new int(6))));
+  for (int i = 2; i < 6; ++i)
+    assert(r.pop(x) and *x == i);
+  assert(r.empty());
+  assert(r.front() == nullptr);
+
+  // Remaining elements are destroyed with the ring.
+  r.emplace(new int(7));
+}
+
+// Test that elements pushed by one thread are popped in order by
+// another.
+void test_concurrent() {
+  constexpr int count = 1000000;
+  Ring<int, 64> r;
+
+  std::thread producer([&r]() {
+    for (int i = 0; i < count; ++i)
+      while (not r.push(i))
+        std::this_thread::yield();
+  });
+
+  for (int i = 0; i < count; ++i) {
+    int x;
+    while (not r.pop(x))
+      std::this_thread::yield();
+    assert(x == i);
+  }
+  producer.join();
+  assert(r.empty());
+}
+
+int main() {
+  test_sequential();
+  test_concurrent();
+}
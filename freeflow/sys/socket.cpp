@@ -64,6 +64,8 @@ operator<<(std::ostream& os, const Address& a) {
     return os << a.as_ipv4().addr();
   else if (a.family() == Address::IP6)
     return os << a.as_ipv6().addr();
+  else if (a.family() == Address::LOCAL)
+    return os << a.as_local().path();
   else
     return os << "<unknown address family>";
 }
@@ -94,6 +96,8 @@ to_string(const Address& a) {
     ss << ",";
     ss << ntohs(v6->sin6_port) ;
     ss << ")";
+  } else if (a.family() == Address::LOCAL) {
+    ss << "local(" << a.as_local().path() << ")";
   }
 
   return ss.str();
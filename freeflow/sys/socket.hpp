@@ -17,11 +17,13 @@
 
 #include <unistd.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 
 #include <cstring>
 #include <iosfwd>
+#include <string>
 #include <type_traits>
 
 #include <freeflow/sys/error.hpp>
@@ -41,6 +43,7 @@ struct Address_info {
   enum Family : sa_family_t {
     IP4 = AF_INET, 
     IP6 = AF_INET6,
+    LOCAL = AF_UNIX,
 
 #if defined(BSD)
     RAW  = PF_NDRV,             // This is BSD only 
@@ -136,6 +139,25 @@ struct Ipv6_sockaddr : sockaddr_in6, Address_info {
 bool operator==(const Ipv6_sockaddr& a, const Ipv6_sockaddr& b);
 bool operator!=(const Ipv6_sockaddr& a, const Ipv6_sockaddr& b);
 
+// -------------------------------------------------------------------------- //
+// Local
+
+/// A local socket address names a Unix domain socket by its path in the
+/// file system. Paths longer than the underlying structure allows are
+/// truncated.
+struct Local_sockaddr : sockaddr_un, Address_info {
+  static constexpr Family family = LOCAL;
+
+  Local_sockaddr() = default;
+  explicit Local_sockaddr(const std::string&);
+
+  std::string path() const;
+};
+
+// Equality comparison
+bool operator==(const Local_sockaddr& a, const Local_sockaddr& b);
+bool operator!=(const Local_sockaddr& a, const Local_sockaddr& b);
+
 // -------------------------------------------------------------------------- //
 // Socket address
 
@@ -153,6 +175,7 @@ struct Address : Address_info {
   Address(Family t, const std::string& n, Ip_port p);
   Address(const Ipv4_addr& a, Ip_port p = 0);
   Address(const Ipv6_addr& a, Ip_port p = 0);
+  Address(const Local_sockaddr& a);
 
   Family family() const;
 
@@ -164,6 +187,10 @@ struct Address : Address_info {
   Ipv6_sockaddr&       as_ipv6();
   const Ipv6_sockaddr& as_ipv6() const;
 
+  // Returns the underlying local address.
+  Local_sockaddr&       as_local();
+  const Local_sockaddr& as_local() const;
+
   // Returns the underlying general address.
   sockaddr*       addr();
   const sockaddr* addr() const;
@@ -111,6 +111,31 @@ operator!=(const Ipv6_sockaddr& a, const Ipv6_sockaddr& b) {
   return not(a == b);
 }
 
+// -------------------------------------------------------------------------- //
+// Local
+
+inline
+Local_sockaddr::Local_sockaddr(const std::string& p) {
+  ::memset(this, 0, sizeof(sockaddr_un));
+  sun_family = LOCAL;
+  p.copy(sun_path, sizeof(sun_path) - 1);
+}
+
+inline std::string
+Local_sockaddr::path() const { 
+  return std::string(sun_path, ::strnlen(sun_path, sizeof(sun_path)));
+}
+
+inline bool
+operator==(const Local_sockaddr& a, const Local_sockaddr& b) {
+  return a.path() == b.path();
+}
+
+inline bool
+operator!=(const Local_sockaddr& a, const Local_sockaddr& b) {
+  return not(a == b);
+}
+
 // -------------------------------------------------------------------------- //
 // Address
 
@@ -167,6 +192,11 @@ Address::Address(const Ipv6_addr& a, Ip_port p) {
   new (&storage) Ipv6_sockaddr(a, p);
 }
 
+inline
+Address::Address(const Local_sockaddr& a) {
+  new (&storage) Local_sockaddr(a);
+}
+
 inline Address::Family
 Address::family() const { return Family(storage.ss_family); }
 
@@ -200,6 +230,16 @@ Address::addr() const {
   return reinterpret_cast<const sockaddr*>(&storage); 
 }
 
+inline Local_sockaddr&
+Address::as_local() {
+  return *reinterpret_cast<Local_sockaddr*>(&storage);
+}
+
+inline const Local_sockaddr&
+Address::as_local() const {
+  return *reinterpret_cast<const Local_sockaddr*>(&storage);
+}
+
 /// If the address is an internet address, this returns a pointer to the 
 // underlying address definition. Otherwise, an exception is thrown.
 inline void*
@@ -238,6 +278,8 @@ Address::len() const {
     return sizeof(Ipv4_sockaddr);
   else if (family() == Address::IP6)
     return sizeof(Ipv6_sockaddr);
+  else if (family() == Address::LOCAL)
+    return sizeof(Local_sockaddr);
   else
     throw std::runtime_error("unknown address family");
 }
@@ -252,6 +294,8 @@ operator==(const Address& a, const Address& b) {
       return a.as_ipv4() == b.as_ipv4();
     else if (a.family() == Address::IP6)
       return a.as_ipv6() == b.as_ipv6();
+    else if (a.family() == Address::LOCAL)
+      return a.as_local() == b.as_local();
     else
       throw std::runtime_error("unknown address family");
   } else {
@@ -274,7 +318,7 @@ Socket_info::Socket_info(Family f, Transport t)
 
 inline
 Socket_info::Socket_info(Transport t, const Address& l, const Address& p)
-  : transport(t), local(l), peer(p)
+  : family(l.family()), transport(t), local(l), peer(p)
 { }
 
 /// Return the socket type 
@@ -324,8 +368,12 @@ Socket_info::protocol(Transport t)
   }
 }
 
+/// Returns the protocol of the socket. Local sockets have no protocol;
+/// their transport determines only the socket type.
 inline int
-Socket_info::protocol() const { return protocol(transport); }
+Socket_info::protocol() const { 
+  return family == LOCAL ? 0 : protocol(transport); 
+}
 
 inline
 Socket::Socket()
@@ -0,0 +1,35 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#include <mutex>
+#include <unordered_set>
+
+#include "symbol.hpp"
+
+namespace freeflow {
+
+/// Returns the unique copy of the string s, adding it to the table if
+/// needed. The returned string is never destroyed. Interning is
+/// synchronized, so symbols can be created by any thread.
+const std::string*
+intern(const std::string& s) {
+  // Elements of an unordered set are never moved by rehashing.
+  static std::unordered_set<std::string> strings;
+  static std::mutex mutex;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  return &*strings.insert(s).first;
+}
+
+} // namespace freeflow
@@ -0,0 +1,61 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+#ifndef FREEFLOW_SYMBOL_HPP
+#define FREEFLOW_SYMBOL_HPP
+
+#include <string>
+
+/// \file symbol.hpp
+/// Interned strings.
+///
+/// A Symbol refers to a unique copy of a string stored in a process-wide
+/// table. Many objects share descriptive strings (e.g., the names of
+/// ports such as "eth0" on thousands of switches). Storing a Symbol
+/// costs a single pointer, and symbols compare equal by comparing
+/// pointers.
+
+namespace freeflow {
+
+/// A Symbol is an interned string. The default symbol is the empty
+/// string.
+class Symbol {
+public:
+  Symbol();
+  explicit Symbol(const std::string&);
+  explicit Symbol(const char*);
+
+  // Observers
+  const std::string& str() const;
+  bool empty() const;
+
+private:
+  const std::string* str_;
+};
+
+// Equality comparison
+bool operator==(Symbol, Symbol);
+bool operator!=(Symbol, Symbol);
+
+// Ordering
+bool operator<(Symbol, Symbol);
+
+// Interning
+const std::string* intern(const std::string&);
+
+} // namespace freeflow
+
+#include <freeflow/sys/symbol.ipp>
+
+#endif
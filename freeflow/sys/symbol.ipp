@@ -0,0 +1,45 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+namespace freeflow {
+
+inline
+Symbol::Symbol() : str_(intern(std::string())) { }
+
+inline
+Symbol::Symbol(const std::string& s) : str_(intern(s)) { }
+
+inline
+Symbol::Symbol(const char* s) : str_(intern(s)) { }
+
+/// Returns the interned string.
+inline const std::string&
+Symbol::str() const { return *str_; }
+
+/// Returns true if the symbol is the empty string.
+inline bool
+Symbol::empty() const { return str_->empty(); }
+
+/// Symbols are equal when they refer to the same interned string.
+inline bool
+operator==(Symbol a, Symbol b) { return &a.str() == &b.str(); }
+
+inline bool
+operator!=(Symbol a, Symbol b) { return not (a == b); }
+
+/// Symbols are ordered by their strings.
+inline bool
+operator<(Symbol a, Symbol b) { return a.str() < b.str(); }
+
+} // namespace freeflow
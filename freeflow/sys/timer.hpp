@@ -31,7 +31,7 @@ using Timer_id = int;
 /// structure binds together information about an event handler, the
 /// time point at which the timer triggers, and the timer's identifier.
 struct Timer {
-  struct Less;
+  struct Later;
 
   Timer(Event_handler*, Time_point, Timer_id);
 
@@ -23,11 +23,13 @@ inline
 Timer::Timer(Event_handler* h, Time_point t, Timer_id id) 
   : handler(h), time(t), id(id) { }
 
-// Defines default ordering for timers based on their time point
-struct Timer::Less {
+// Orders timers so that the earliest time point is at the top of a
+// heap. Note that the standard heap algorithms place the greatest
+// element at the top.
+struct Timer::Later {
   bool 
   operator()(const Timer& a, const Timer& b) const {
-    return a.time < b.time;
+    return b.time < a.time;
   }
 };
 
@@ -72,7 +74,7 @@ Timer_queue::cancel(Event_handler* h, int id) {
   });
   if (i != heap_.end()) {
     heap_.erase(i);
-    std::make_heap(heap_.begin(), heap_.end(), Timer::Less{});
+    std::make_heap(heap_.begin(), heap_.end(), Timer::Later{});
   }
 }
 
@@ -84,7 +86,7 @@ Timer_queue::cancel(Event_handler* h) {
   });
   if (i != heap_.end()) {
     heap_.erase(i, heap_.end());
-    std::make_heap(heap_.begin(), heap_.end(), Timer::Less{});
+    std::make_heap(heap_.begin(), heap_.end(), Timer::Later{});
   }
 }
 
@@ -118,12 +120,12 @@ Timer_queue::top() const { return heap_.front(); }
 inline void
 Timer_queue::push(Event_handler* h, int id, Time_point t) {
   heap_.emplace_back(h, t, id);
-  std::push_heap(heap_.begin(), heap_.end(), Timer::Less{});
+  std::push_heap(heap_.begin(), heap_.end(), Timer::Later{});
 }
 
 inline void
 Timer_queue::pop() {
-  std::pop_heap(heap_.begin(), heap_.end(), Timer::Less{});
+  std::pop_heap(heap_.begin(), heap_.end(), Timer::Later{});
   heap_.pop_back();
 }
 
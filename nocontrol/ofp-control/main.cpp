@@ -61,11 +61,19 @@ main(int argc, char* argv[]) {
   // FIXME: All of this information needs to come from
   // the configuration (files, command line, etc).
   constexpr ff::Socket::Transport tcp = ff::Socket::TCP;
+  const std::string snapshot = "ofp-control.snapshot";
   Address ofp_addr {Ipv4_addr::any, 9000};
   Address ncp_addr {Ipv4_addr::any, 9001};
+  Address ncp_local {Local_sockaddr("/tmp/nocontrol.sock")};
 
   Ncp_acceptor ncp(c);
   c.add_acceptor(&ncp, ncp_addr, tcp);
+
+  // Local clients may also connect through a Unix domain socket. A
+  // socket left by a previous run is removed first.
+  ::unlink(ncp_local.as_local().sun_path);
+  Ncp_acceptor ncp_unix(c);
+  c.add_acceptor(&ncp_unix, ncp_local, tcp);
   
   Ofp_acceptor ofp(c);
   c.add_acceptor(&ofp, ofp_addr, tcp);
@@ -78,7 +86,16 @@ main(int argc, char* argv[]) {
   c.start("flog_noflow.app");
   c.start("flog_noflow.app"); // Yes, I'm loading this twice.
   
+  // Switches that are unchanged since the last run are restored from
+  // the snapshot instead of being rediscovered.
+  if (c.load_snapshot(snapshot))
+    std::cout << "* loaded snapshot\n";
+
   c.run();
 
+  if (not c.save_snapshot(snapshot))
+    std::cerr << "error: could not save snapshot\n";
+  ::unlink(ncp_local.as_local().sun_path);
+
   return 0;
 }
@@ -1,53 +1,283 @@
-// Copyright (c) 2013-2014 Flowgrammable.org
-// 
-// Licensed under the Apache License, Version 2.0 (the "License");
-// you may not use this file except in compliance with the License.
-// You may obtain a copy of the License at:
-// 
-// http://www.apache.org/licenses/LICENSE-2.0
-// 
-// Unless required by applicable law or agreed to in writing,
-// software distributed under the License is distributed on an "AS IS"
-// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
-// or implied. See the License for the specific language governing
-// permissions and limitations under the License.
-
+#include <cstdio>
 #include <iostream>
+#include <vector>
 
-#include <freeflow/sys/json.hpp>
+#include <freeflow/sdn/switch.hpp>
 
 #include "nocontrol.hpp"
 
 namespace nocontrol {
 
 using namespace freeflow;
+using namespace freeflow::ncp;
+
+namespace {
+
+// The number of bytes requested by each read.
+constexpr std::size_t read_size = 65536;
+
+// The amount of unwritten output at which reading stops until the
+// client has received some of it.
+constexpr std::size_t max_output = 1 << 22;
+
+// The OpenFlow message type of flow modifications. This is the same in
+// every protocol version.
+constexpr Byte ofp_flow_mod = 14;
+
+// Append an empty successful reply to the request.
+void
+put_reply(Buffer& out, const Frame& f) {
+  if (f.header.format == JSON)
+    put_frame(out, REPLY, f.header.id, json::Object());
+  else
+    put_frame(out, REPLY, BINARY, f.header.id);
+}
 
+// Returns the string member k of the JSON object v, or the empty string
+// if there is none.
+std::string
+get_string(const json::Value& v, const std::string& k) {
+  if (v.type() != json::Value::OBJECT)
+    return {};
+  const json::Object& o = v.as_object();
+  auto iter = o.find(quote(k));
+  if (iter == o.end() or iter->second.type() != json::Value::STRING)
+    return {};
+  return unquote(iter->second.as_string());
+}
+
+// Returns the datapath id as a JSON string.
+std::string
+dpid_string(Uint64 n) {
+  char buf[20];
+  std::snprintf(buf, sizeof(buf), "0x%016llx", (unsigned long long)n);
+  return buf;
+}
+
+} // namespace
+
+/// Read the available bytes and execute every complete request. A
+/// malformed frame cannot be skipped, since its length is not known,
+/// so it is answered with an error and the connection is closed.
 bool
 Ncp_handler::on_read() {
-  System_result res = rc().read(buf_);
-
-  // Check for failures.
-  // FIXME: Improve error handling.
+  System_result res = rc().read(in_.prepare(read_size), read_size);
+  if (res.deferred())
+    return true;
   if (res.failed()) {
-    std::cerr << "failed to read from client\n";
-    return false; 
+    std::cerr << "error: failed to read from client\n";
+    return false;
   }
 
-  // If we read 0, bytes, the connection is closed.
+  // If we read 0 bytes, the connection is closed.
   if (res.value() == 0)
     return false;
+  in_.commit(res.value());
 
-  // Decode and dispatch the command.
-  // FIXME: Actually do something here! Also improve error handling.
-  try {
-    json::Value v = json::parse(buf_);
-    std::cout << v << '\n';
-  } catch (...) {
-    std::cerr << "error: ill-formed command\n";
+  Frame f;
+  while (in_.next(f))
+    execute(f, out_);
+  if (in_.bad()) {
+    put_error(out_, BINARY, 0, BAD_FRAME, "malformed frame");
+    flush();
     return false;
   }
+  return flush();
+}
 
+/// Continue writing replies when the socket becomes writable.
+bool
+Ncp_handler::on_write() { return flush(); }
+
+// Write as much pending output as the socket accepts. If output
+// remains, the handler waits for the socket to become writable, and
+// stops reading requests if too much remains.
+bool
+Ncp_handler::flush() {
+  while (sent_ != out_.size()) {
+    System_result res = rc().write(out_.data() + sent_, out_.size() - sent_);
+    if (res.deferred())
+      break;
+    if (res.failed()) {
+      std::cerr << "error: failed to write to client\n";
+      return false;
+    }
+    sent_ += res.value();
+  }
+  if (sent_ == out_.size()) {
+    out_.clear();
+    sent_ = 0;
+    if (is_subscribed(WRITE_EVENTS))
+      reactor().unsubscribe_events(this, WRITE_EVENTS);
+  } else if (not is_subscribed(WRITE_EVENTS)) {
+    reactor().subscribe_events(this, WRITE_EVENTS);
+  }
+
+  bool full = out_.size() - sent_ >= max_output;
+  if (full and is_subscribed(READ_EVENTS))
+    reactor().unsubscribe_events(this, READ_EVENTS);
+  else if (not full and not is_subscribed(READ_EVENTS))
+    reactor().subscribe_events(this, READ_EVENTS);
   return true;
 }
 
+// Execute the request, appending its reply to out.
+void
+Ncp_handler::execute(const Frame& f, Buffer& out) {
+  const Header& h = f.header;
+  switch (h.type) {
+  case ECHO:
+    put_frame(out, REPLY, h.format, h.id, f.payload, f.size);
+    break;
+  case BATCH:
+    execute_batch(f, out);
+    break;
+  case LOAD:
+  case UNLOAD:
+  case START:
+    execute_app(f, out);
+    break;
+  case SWITCHES:
+    execute_switches(f, out);
+    break;
+  case FLOWS:
+    execute_flows(f, out);
+    break;
+  default:
+    put_error(out, h.format, h.id, BAD_TYPE, "not a request");
+    break;
+  }
+}
+
+// Execute each request of the batch, in order. The replies are nested
+// in a single batch reply. The batch is checked before any request is
+// executed, so a malformed batch has no effect.
+void
+Ncp_handler::execute_batch(const Frame& f, Buffer& out) {
+  const Header& h = f.header;
+  const Byte* last = f.payload + f.size;
+  Frame g;
+  for (const Byte* p = f.payload; p != last; ) {
+    if (split_frame(p, last, g) != Split::FRAME) {
+      put_error(out, h.format, h.id, BAD_PAYLOAD, "malformed batch");
+      return;
+    }
+  }
+
+  std::size_t k = begin_frame(out, BATCH, h.format, h.id);
+  for (const Byte* p = f.payload; p != last; ) {
+    split_frame(p, last, g);
+    if (g.header.type == BATCH)
+      put_error(out, g.header.format, g.header.id, BAD_TYPE, "nested batch");
+    else
+      execute(g, out);
+  }
+  end_frame(out, k);
+}
+
+// Load, unload or start the named application.
+void
+Ncp_handler::execute_app(const Frame& f, Buffer& out) {
+  const Header& h = f.header;
+  std::string name;
+  if (h.format == JSON)
+    name = get_string(parse_payload(f), "name");
+  else
+    name.assign(f.payload, f.payload + f.size);
+  if (name.empty()) {
+    put_error(out, h.format, h.id, BAD_PAYLOAD, "no application name");
+    return;
+  }
+
+  try {
+    if (h.type == LOAD) {
+      ctrl_.load(name);
+    } else if (h.type == UNLOAD) {
+      if (not ctrl_.is_loaded(name)) {
+        put_error(out, h.format, h.id, FAILED, name + " is not loaded");
+        return;
+      }
+      ctrl_.unload(name);
+    } else if (not ctrl_.start(name)) {
+      put_error(out, h.format, h.id, FAILED, "cannot start " + name);
+      return;
+    }
+  } catch (...) {
+    put_error(out, h.format, h.id, FAILED, "cannot load " + name);
+    return;
+  }
+  put_reply(out, f);
+}
+
+// Reply with the datapath ids of the connected switches.
+void
+Ncp_handler::execute_switches(const Frame& f, Buffer& out) {
+  const Header& h = f.header;
+  std::vector<const Datapath*> dps;
+  ctrl_.switches().datapaths(dps);
+  std::vector<Uint64> ids;
+  for (const Datapath* dp : dps)
+    if (ctrl_.find_switch(dp->datapath_id))
+      ids.push_back(dp->datapath_id);
+
+  if (h.format == JSON) {
+    json::Array a;
+    for (Uint64 id : ids)
+      a.push_back(quote(dpid_string(id)));
+    put_frame(out, REPLY, h.id, {{quote("switches"), std::move(a)}});
+  } else {
+    std::size_t k = begin_frame(out, REPLY, BINARY, h.id);
+    put_uint32(out, ids.size());
+    for (Uint64 id : ids)
+      put_uint64(out, id);
+    end_frame(out, k);
+  }
+}
+
+// Queue the OpenFlow flow modifications on the switch's flow channel,
+// which sends them in batches behind barriers. Queuing wakes the
+// switch's session, so they are sent without waiting for the switch.
+// The messages are checked before any is queued, so a malformed
+// request has no effect.
+void
+Ncp_handler::execute_flows(const Frame& f, Buffer& out) {
+  const Header& h = f.header;
+  if (h.format != BINARY) {
+    put_error(out, h.format, h.id, BAD_FORMAT, "flows must be binary");
+    return;
+  }
+  if (f.size < 8) {
+    put_error(out, h.format, h.id, BAD_PAYLOAD, "no datapath id");
+    return;
+  }
+  Switch* sw = ctrl_.find_switch(get_uint64(f.payload));
+  if (not sw) {
+    put_error(out, h.format, h.id, NO_SWITCH, "no such switch");
+    return;
+  }
+
+  const Byte* first = f.payload + 8;
+  const Byte* last = f.payload + f.size;
+  Uint32 n = 0;
+  for (const Byte* p = first; p != last; ++n) {
+    std::size_t len = last - p < 8 ? 0 : p[2] << 8 | p[3];
+    if (len < 8 or len > std::size_t(last - p) or p[1] != ofp_flow_mod) {
+      put_error(out, h.format, h.id, BAD_PAYLOAD, "malformed flow mod");
+      return;
+    }
+    p += len;
+  }
+
+  Flow_channel& fc = sw->flows();
+  for (const Byte* p = first; p != last; ) {
+    std::size_t len = p[2] << 8 | p[3];
+    fc.push(Buffer(p, p + len));
+    p += len;
+  }
+
+  std::size_t k = begin_frame(out, REPLY, BINARY, h.id);
+  put_uint32(out, n);
+  end_frame(out, k);
+}
+
 } // namesapce nocontrol
@@ -17,29 +17,39 @@
 
 #include <freeflow/sys/acceptor.hpp>
 #include <freeflow/sdn/controller.hpp>
+#include <freeflow/proto/ncp/ncp.hpp>
 
 #include "prelude.hpp"
 
 namespace nocontrol {
 
-/// NOTE: The abbreviation NCP means "NoControl Protocol".
-
-/// The Ncp_handler is responsible for implementing queries and commands 
-/// sent to this service. When data is available for reading, it reads 
-/// the value, parses it into JSON, and dispatches the appropriate commands.
+/// The Ncp_handler serves a northbound control protocol connection. Each
+/// read appends to the connection's frame reader, and every complete
+/// request received is executed in order. Replies are accumulated and
+/// written together, so a client that pipelines requests receives its
+/// replies in as few writes as possible. Output that cannot be written
+/// immediately is kept until the socket is writable; while too much is
+/// kept, no more requests are read.
 struct Ncp_handler : ff::Socket_handler {
   inline Ncp_handler(ff::Reactor&, ff::Socket&&, ff::Controller&);
 
   bool on_read();
+  bool on_write();
 
 private:
-  ff::Controller& ctrl_;  // The controller
-  ff::Buffer buf_;        // A pre-allocated read buffer.
+  void execute(const ff::ncp::Frame&, ff::Buffer&);
+  void execute_batch(const ff::ncp::Frame&, ff::Buffer&);
+  void execute_app(const ff::ncp::Frame&, ff::Buffer&);
+  void execute_switches(const ff::ncp::Frame&, ff::Buffer&);
+  void execute_flows(const ff::ncp::Frame&, ff::Buffer&);
+  bool flush();
+
+  ff::Controller&        ctrl_; // The controller
+  ff::ncp::Frame_reader  in_;   // Received requests
+  ff::Buffer             out_;  // Replies not yet written
+  std::size_t            sent_; // Bytes of out_ already written
 };
 
-/// The Ncp_acceptor is resposnble for accepting connections
-/// on the management port and construcitng service handlers to
-/// manage that connection.
 using Ncp_acceptor = ff::Controller::Acceptor<Ncp_handler>;
 
 } // namesapce nocontrol
@@ -19,7 +19,9 @@ namespace nocontrol {
 /// \todo Pre-allocate 1 page worth memory.
 inline
 Ncp_handler::Ncp_handler(ff::Reactor& r, ff::Socket&& s, ff::Controller& c)
-  : ff::Socket_handler(r, ff::READ_EVENTS, std::move(s)), ctrl_(c), buf_(4096)
-{ }
+  : ff::Socket_handler(r, ff::READ_EVENTS, std::move(s)), ctrl_(c), sent_(0)
+{ 
+  rc().set_nonblocking();
+}
 
 } // namesapce nocontrol
@@ -19,55 +19,37 @@
 #include <freeflow/sys/handler.hpp>
 #include <freeflow/sys/acceptor.hpp>
 #include <freeflow/sdn/controller.hpp>
+#include <freeflow/proto/ofp/protocol.hpp>
 
 #include "prelude.hpp"
-#include "queue.hpp"
-#include "machine.hpp"
 
 namespace nocontrol {
 
-/// Represents an OpenFlow connection with a switch. This class acts as a 
-/// small shim that buffers messages and hands them to a state machine for
-/// further processing.
-///
-/// \todo We're required to TLS for switch connections. This
-/// seems like the likely integration point for that work.
+/// The Ofp_handler connects an OpenFlow switch to the controller. The
+/// handler moves bytes between the socket and the message queues of
+/// its protocol session, which implements the protocol. Messages queued
+/// by the session are written after each event; any that cannot be
+/// written immediately are sent when the socket becomes writable.
 class Ofp_handler : public ff::Socket_handler {
-  struct Write_on_exit;
 public:
   Ofp_handler(ff::Reactor&, ff::Socket&&, ff::Controller&);
 
   bool on_open();
   bool on_close();
   bool on_read();
+  bool on_write();
   bool on_time(int);
 
 private:
-  bool check_version(ff::Error);
-  bool change_version(int);
+  bool flush();
 
-private:
-  bool read();
-  bool write();
-
-  ff::Controller&         ctrl_;
-  ff::ofp::Channel        ch_;
-  ff::ofp::v1_0::Machine* sm_;
+  ff::ofp::Protocol proto_; // The protocol session
+  std::size_t       sent_;  // Bytes of the front message already written
 };
 
 
-/// The Ofp_acceptor is responsible for accepting connections from
-/// switches and constructing service handlers to manage the OpenFlow
-/// protocol.
 using Ofp_acceptor = ff::Controller::Acceptor<Ofp_handler>;
 
-void set_mac_addr(freeflow::Mac_addr, const freeflow::ofp::Mac_addr&);
-
-bool get_bit(int, int);
-void features_config(ff::Port::Features&, const ff::ofp::v1_0::Port::Features&);
-void datapath_config(ff::Datapath&, const ff::ofp::v1_0::Feature_reply&);
-
-
 } // namespace nocontrol
 
 #include "openflow.ipp"
@@ -12,10 +12,284 @@
 // or implied. See the License for the specific language governing
 // permissions and limitations under the License.
 
+
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
 #include "command.hpp"
 
 namespace freeflow {
 namespace cli {
 
+namespace {
+
+// The size at which the flow-mods of a FLOWS command are split into
+// another request.
+constexpr std::size_t flows_per_request = 1 << 20;
+
+// Returns the ith positional argument, or the empty string.
+std::string
+get_arg(const Arguments& args, int i) {
+  if (i >= args.get_listed_size())
+    return {};
+  return args.get_listed(i).as_string();
+}
+
+// Returns the positional arguments from the ith, joined by spaces.
+std::string
+get_args(const Arguments& args, int i) {
+  std::string s;
+  for (; i < args.get_listed_size(); ++i) {
+    if (not s.empty())
+      s += ' ';
+    s += get_arg(args, i);
+  }
+  return s;
+}
+
+// Append a request of type t with the text as its payload.
+Uint32
+request_text(Session& s, ncp::Message_type t, const std::string& text) {
+  if (s.format() == ncp::JSON)
+    return s.request(t, {{ncp::quote("name"), ncp::quote(text)}});
+  else
+    return s.request(t, text.data(), text.size());
+}
+
+// Print the reply to a request of type t.
+void
+print_reply(ncp::Message_type t, const ncp::Frame& f) {
+  if (f.header.type == ncp::ERROR) {
+    std::cerr << "error: " << error_message(f) << '\n';
+  } else if (f.header.format == ncp::JSON) {
+    std::cout << std::string(f.payload, f.payload + f.size) << '\n';
+  } else if (t == ncp::ECHO) {
+    std::cout << std::string(f.payload, f.payload + f.size) << '\n';
+  } else if (t == ncp::SWITCHES and f.size >= 4) {
+    Uint32 n = ncp::get_uint32(f.payload);
+    for (Uint32 i = 0; i < n and 4 + 8 * (i + 1) <= f.size; ++i) {
+      char buf[20];
+      Uint64 id = ncp::get_uint64(f.payload + 4 + 8 * i);
+      std::snprintf(buf, sizeof(buf), "0x%016llx", (unsigned long long)id);
+      std::cout << buf << '\n';
+    }
+  } else {
+    std::cout << "ok\n";
+  }
+}
+
+// Returns the request type named by a command in a batch file.
+bool
+batch_type(const std::string& s, ncp::Message_type& t) {
+  if (s == "echo") t = ncp::ECHO;
+  else if (s == "load") t = ncp::LOAD;
+  else if (s == "unload") t = ncp::UNLOAD;
+  else if (s == "start") t = ncp::START;
+  else if (s == "switches") t = ncp::SWITCHES;
+  else return false;
+  return true;
+}
+
+} // namespace
+
+// Wait for the next reply.
+bool
+Session_command::wait(ncp::Frame& f) {
+  if (session_.receive(f))
+    return true;
+  std::cerr << "error: connection to the controller was lost\n";
+  return false;
+}
+
+// Returns true if the reply is not an error.
+bool
+Session_command::check(const ncp::Frame& f) {
+  return f.header.type != ncp::ERROR;
+}
+
+/// Usage: echo text...
+bool
+Echo_command::run(const Arguments& args) {
+  std::string text = get_args(args, 0);
+  if (session_.format() == ncp::JSON)
+    session_.request(ncp::ECHO, {{ncp::quote("text"), ncp::quote(text)}});
+  else
+    session_.request(ncp::ECHO, text.data(), text.size());
+
+  ncp::Frame f;
+  if (not session_.flush() or not wait(f))
+    return false;
+  print_reply(ncp::ECHO, f);
+  return check(f);
+}
+
+/// Usage: load|unload|start name
+bool
+App_command::run(const Arguments& args) {
+  std::string name = get_arg(args, 0);
+  if (name.empty()) {
+    std::cerr << "error: an application name must be given\n";
+    return false;
+  }
+  request_text(session_, type_, name);
+
+  ncp::Frame f;
+  if (not session_.flush() or not wait(f))
+    return false;
+  print_reply(type_, f);
+  return check(f);
+}
+
+/// Usage: switches
+bool
+Switches_command::run(const Arguments& args) {
+  if (session_.format() == ncp::JSON)
+    session_.request(ncp::SWITCHES, json::Object());
+  else
+    session_.request(ncp::SWITCHES);
+
+  ncp::Frame f;
+  if (not session_.flush() or not wait(f))
+    return false;
+  print_reply(ncp::SWITCHES, f);
+  return check(f);
+}
+
+/// Usage: flows dpid file
+///
+/// The file holds encoded OpenFlow flow-mod messages, one after another.
+/// They are sent in as few requests as the frame size allows, all
+/// pipelined on the session, and the number queued is reported.
+bool
+Flows_command::run(const Arguments& args) {
+  std::string path = get_arg(args, 1);
+  Uint64 dpid;
+  try {
+    dpid = std::stoull(get_arg(args, 0), nullptr, 0);
+  } catch (...) {
+    std::cerr << "error: a datapath id must be given\n";
+    return false;
+  }
+  std::ifstream in(path, std::ios::binary);
+  if (not in) {
+    std::cerr << "error: cannot open '" << path << "'\n";
+    return false;
+  }
+  std::vector<char> msgs{std::istreambuf_iterator<char>(in), 
+                         std::istreambuf_iterator<char>()};
+
+  // Split the messages into requests at message boundaries.
+  Buffer& out = session_.output();
+  std::size_t reqs = 0;
+  std::size_t k = 0;
+  for (std::size_t i = 0; i < msgs.size(); ) {
+    if (msgs.size() - i < 8) {
+      std::cerr << "error: '" << path << "' is truncated\n";
+      return false;
+    }
+    std::size_t len = Byte(msgs[i + 2]) << 8 | Byte(msgs[i + 3]);
+    if (len < 8 or len > msgs.size() - i) {
+      std::cerr << "error: '" << path << "' is malformed\n";
+      return false;
+    }
+    if (reqs == 0 or out.size() - k + len > flows_per_request) {
+      if (reqs != 0)
+        ncp::end_frame(out, k);
+      k = ncp::begin_frame(out, ncp::FLOWS, ncp::BINARY, session_.next_id());
+      ncp::put_uint64(out, dpid);
+      ++reqs;
+    }
+    out.insert(out.end(), msgs.begin() + i, msgs.begin() + i + len);
+    i += len;
+  }
+  if (reqs == 0) {
+    std::cerr << "error: '" << path << "' holds no flow-mods\n";
+    return false;
+  }
+  ncp::end_frame(out, k);
+  if (not session_.flush())
+    return false;
+
+  Uint64 total = 0;
+  bool ok = true;
+  for (std::size_t i = 0; i < reqs; ++i) {
+    ncp::Frame f;
+    if (not wait(f))
+      return false;
+    if (check(f) and f.size >= 4) {
+      total += ncp::get_uint32(f.payload);
+    } else {
+      print_reply(ncp::FLOWS, f);
+      ok = false;
+    }
+  }
+  std::cout << "queued " << total << " flow-mods\n";
+  return ok;
+}
+
+/// Usage: batch file
+///
+/// Each line of the file is a command (echo, load, unload, start or
+/// switches) and its arguments. Blank lines and lines starting with '#'
+/// are ignored. The commands are sent as one batch request and their
+/// replies are printed in order.
+bool
+Batch_command::run(const Arguments& args) {
+  std::string path = get_arg(args, 0);
+  std::ifstream in(path);
+  if (not in) {
+    std::cerr << "error: cannot open '" << path << "'\n";
+    return false;
+  }
+
+  Buffer& out = session_.output();
+  std::vector<ncp::Message_type> types;
+  std::size_t k = ncp::begin_frame(out, ncp::BATCH, session_.format(), 
+                                   session_.next_id());
+  std::string line;
+  while (std::getline(in, line)) {
+    std::istringstream ss(line);
+    std::string cmd;
+    std::string arg;
+    ss >> cmd;
+    std::getline(ss >> std::ws, arg);
+    if (cmd.empty() or cmd[0] == '#')
+      continue;
+    ncp::Message_type t;
+    if (not batch_type(cmd, t)) {
+      std::cerr << "error: unknown command '" << cmd << "'\n";
+      return false;
+    }
+    request_text(session_, t, arg);
+    types.push_back(t);
+  }
+  ncp::end_frame(out, k);
+
+  ncp::Frame f;
+  if (not session_.flush() or not wait(f))
+    return false;
+  if (not check(f)) {
+    print_reply(ncp::BATCH, f);
+    return false;
+  }
+
+  // Print the nested replies.
+  bool ok = true;
+  const Byte* p = f.payload;
+  const Byte* last = f.payload + f.size;
+  ncp::Frame g;
+  for (ncp::Message_type t : types) {
+    if (ncp::split_frame(p, last, g) != ncp::Split::FRAME) {
+      std::cerr << "error: malformed batch reply\n";
+      return false;
+    }
+    print_reply(t, g);
+    ok &= check(g);
+  }
+  return ok;
+}
+
 } // namespace cli
-} // namespace freeflow
\ No newline at end of file
+} // namespace freeflow
@@ -12,24 +12,66 @@
 // or implied. See the License for the specific language governing
 // permissions and limitations under the License.
 
+
 #ifndef FREEFLOW_COMMAND_HPP
 #define FREEFLOW_COMMAND_HPP
 
 #include <iostream>
-#include <sstream>
-#include <fstream>
-#include <iterator>
 #include <string>
 #include <vector>
-#include <map>
 
 #include <freeflow/sys/cli.hpp>
+
+#include "session.hpp"
+
 namespace freeflow {
 namespace cli {
 
-struct Add { void operator()(const Arguments&) const; };
-struct Remove { void operator()(const Arguments&) const; };
-struct Help { void operator()(const Arguments&) const; };
+/// A Session_command sends requests through the program's session to
+/// the controller and reports the replies.
+struct Session_command : Command {
+  Session_command(Session&, const std::string&, const std::string&);
+
+protected:
+  bool wait(ncp::Frame&);
+  bool check(const ncp::Frame&);
+
+  Session& session_;
+};
+
+/// Echo text through the controller.
+struct Echo_command : Session_command {
+  explicit Echo_command(Session&);
+  bool run(const Arguments&);
+};
+
+/// Load, unload or start an application.
+struct App_command : Session_command {
+  App_command(Session&, ncp::Message_type, const std::string&, 
+              const std::string&);
+  bool run(const Arguments&);
+
+private:
+  ncp::Message_type type_;
+};
+
+/// List the connected switches.
+struct Switches_command : Session_command {
+  explicit Switches_command(Session&);
+  bool run(const Arguments&);
+};
+
+/// Install the OpenFlow flow-mods in a file on a switch.
+struct Flows_command : Session_command {
+  explicit Flows_command(Session&);
+  bool run(const Arguments&);
+};
+
+/// Run a file of commands as a single batch.
+struct Batch_command : Session_command {
+  explicit Batch_command(Session&);
+  bool run(const Arguments&);
+};
 
 } // namespace cli
 } // namespace freeflow
@@ -12,25 +12,35 @@
 // or implied. See the License for the specific language governing
 // permissions and limitations under the License.
 
+
 namespace freeflow {
 namespace cli {
 
+inline
+Session_command::Session_command(Session& s, const std::string& n, 
+                                 const std::string& d)
+  : Command(n, d), session_(s) { }
 
-inline void
-Add::operator()(const Arguments& args) const {
-  std::cout << "Ran add" << "\n";
-}
+inline
+Echo_command::Echo_command(Session& s)
+  : Session_command(s, "echo", "Echo text through the controller") { }
 
-inline void
-Remove::operator()(const Arguments& args) const {
-  std::cout << "Ran remove" << "\n";
-}
+inline
+App_command::App_command(Session& s, ncp::Message_type t, 
+                         const std::string& n, const std::string& d)
+  : Session_command(s, n, d), type_(t) { }
 
-// no-op
-inline void
-Help::operator()(const Arguments& args) const { }
+inline
+Switches_command::Switches_command(Session& s)
+  : Session_command(s, "switches", "List the connected switches") { }
 
+inline
+Flows_command::Flows_command(Session& s)
+  : Session_command(s, "flows", "Install a file of flow-mods on a switch") { }
 
+inline
+Batch_command::Batch_command(Session& s)
+  : Session_command(s, "batch", "Run a file of commands as one batch") { }
 
 } // namespace cli
-} // namespace freeflow
\ No newline at end of file
+} // namespace freeflow
@@ -23,52 +23,13 @@
 using namespace std;
 using namespace freeflow;
 
-struct Add_command : cli::Command {
-  Add_command() 
-    : Command("add", "Add something to something else")
-  {
-    declare("name", cli::String_typed(), cli::REQUIRED, "The name of the thing added");
-    declare("path", cli::String_typed(), cli::REQUIRED, "The path to the thing added");
-    declare("config", cli::String_typed(), cli::REQUIRED, "Path to a configuration file");
-    declare("version", cli::String_typed(), cli::REQUIRED, "The version of the thing added");
-    declare("flag", cli::Bool_typed(), cli::REQUIRED, "A mysterious flag");
-  }
-
-  bool run(const cli::Arguments& args) { 
-    std::cout << "Adding...\n";
-    return true; 
-  }
-};
-
-struct Del_command : cli::Command {
-  Del_command() 
-    : Command("del", "Remove something from something else")
-  {
-    declare("name", cli::String_typed(), cli::REQUIRED, "The name of the thing removed");
-    declare("path", cli::String_typed(), cli::REQUIRED, "The path to the thing being removed");
-    declare("config", cli::String_typed(), cli::REQUIRED, "Path to a configuration file");
-  }
-
-  bool run(const cli::Arguments& args) {
-    std::cout << "Removing...\n";
-    return true;
-  }
-};
-
 int
 main(int argc, char *argv[]) {
   cli::Parameters parms;
-  parms.declare("flag, f", cli::Bool_typed(), cli::REQUIRED, "Just a flag");
-  parms.declare("number", cli::Real_typed(), "42", "Just a number");
-  parms.declare("name", cli::String_typed(), "some value", "The name of something");
-  parms.declare("config", cli::String_typed(), cli::OPTIONAL, "The path to a configuration file");
-  parms.declare("path", cli::String_typed(), "*default path*", "Path to something");
-  parms.declare("version, v", cli::Real_typed(), cli::REQUIRED, "Version of something");
-
-  // Create commands.
-  cli::Commands cmds;
-  cmds.declare<Add_command>();
-  cmds.declare<Del_command>();
+  parms.declare("server, s", cli::String_typed(), "127.0.0.1:9001", 
+                "The controller's address, or the path of its socket");
+  parms.declare("json, j", cli::Bool_typed(), cli::OPTIONAL, 
+                "Send requests and print replies as JSON");
 
   // Initialize the parse state
   cli::Parse_state ps(argc, 1, argv);
@@ -91,6 +52,23 @@ main(int argc, char *argv[]) {
   if (not check_args(parms, program_args))
     program_args.display_errors(prefix);
 
+  // Create commands. Every command uses the same session, so a single
+  // connection carries all of its requests.
+  bool json = program_args.has_named("json") and 
+              program_args.get_named_value("json").as_bool();
+  cli::Session session(json ? ncp::JSON : ncp::BINARY);
+  cli::Commands cmds;
+  cmds.declare<cli::Echo_command>(session);
+  cmds.declare<cli::App_command>(session, ncp::LOAD, "load", 
+                                 "Load an application library");
+  cmds.declare<cli::App_command>(session, ncp::UNLOAD, "unload", 
+                                 "Unload an application library");
+  cmds.declare<cli::App_command>(session, ncp::START, "start", 
+                                 "Start an application");
+  cmds.declare<cli::Switches_command>(session);
+  cmds.declare<cli::Flows_command>(session);
+  cmds.declare<cli::Batch_command>(session);
+
   // Make sure a command name was provided
   if (ps.current == ps.argc) {
     std::cerr << "error: a command must be provided\n";
@@ -104,9 +82,9 @@ main(int argc, char *argv[]) {
     return -1;
   }
 
-  // FIXME: If this returns null, it will crash.
   cli::Command* cmd = cmds.find(cmd_name)->second;
   cli::Arguments command_args;
+  ++ps.current;
   
   // Parse command args
   parse_args(cmd->parms(), command_args, ps);
@@ -117,6 +95,12 @@ main(int argc, char *argv[]) {
     return -1;
   }
 
-  // FIXME: Return from this?
-  cmd->run(command_args);
+  // Connect to the controller.
+  std::string server = program_args.get_named_value("server").as_string();
+  if (not session.connect(server)) {
+    std::cerr << "error: cannot connect to '" << server << "'\n";
+    return -1;
+  }
+
+  return cmd->run(command_args) ? 0 : -1;
 }
@@ -0,0 +1,103 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+
+#include "session.hpp"
+
+namespace freeflow {
+namespace cli {
+
+/// Connect to the controller at the given address. An address that
+/// contains a '/' is the path of a Unix domain socket; otherwise it is
+/// an IPv4 host and port, separated by a colon. Returns false if the
+/// address is invalid or the connection fails.
+bool
+Session::connect(const std::string& addr) {
+  try {
+    Address a;
+    if (addr.find('/') != std::string::npos) {
+      a = Address(Local_sockaddr(addr));
+    } else {
+      std::size_t n = addr.rfind(':');
+      if (n == std::string::npos)
+        return false;
+      a = Address(Address::IP4, addr.substr(0, n), 
+                  Ip_port(std::stoul(addr.substr(n + 1))));
+    }
+    sock_ = Socket(a.family(), Socket::TCP);
+    return not sock_.connect(a).failed();
+  } catch (...) {
+    return false;
+  }
+}
+
+/// Append a request with a binary payload. Returns its id.
+Uint32
+Session::request(ncp::Message_type t, const void* p, std::size_t n) {
+  Uint32 id = next_id();
+  ncp::put_frame(out_, t, fmt_, id, p, n);
+  return id;
+}
+
+/// Append a request with a JSON payload. Returns its id.
+Uint32
+Session::request(ncp::Message_type t, const json::Value& v) {
+  Uint32 id = next_id();
+  ncp::put_frame(out_, t, id, v);
+  return id;
+}
+
+/// Send every queued request. Returns false if the connection fails.
+bool
+Session::flush() {
+  std::size_t n = 0;
+  while (n != out_.size()) {
+    System_result r = sock_.write(out_.data() + n, out_.size() - n);
+    if (r.failed() or r.value() == 0)
+      return false;
+    n += r.value();
+  }
+  out_.clear();
+  return true;
+}
+
+/// Wait for the next reply. Returns false if the connection is closed
+/// or a malformed frame is received. The frame is valid until the next
+/// call to receive.
+bool
+Session::receive(ncp::Frame& f) {
+  constexpr std::size_t n = 65536;
+  while (not in_.next(f)) {
+    if (in_.bad())
+      return false;
+    System_result r = sock_.read(in_.prepare(n), n);
+    if (r.failed() or r.value() == 0)
+      return false;
+    in_.commit(r.value());
+  }
+  return true;
+}
+
+/// Returns the message of an error reply.
+std::string
+error_message(const ncp::Frame& f) {
+  if (f.header.format == ncp::JSON)
+    return std::string(f.payload, f.payload + f.size);
+  if (f.size < 2)
+    return "unknown error";
+  return std::string(f.payload + 2, f.payload + f.size);
+}
+
+} // namespace cli
+} // namespace freeflow
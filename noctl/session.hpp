@@ -0,0 +1,68 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+
+#ifndef NOCTL_SESSION_HPP
+#define NOCTL_SESSION_HPP
+
+#include <string>
+
+#include <freeflow/sys/socket.hpp>
+#include <freeflow/sys/json.hpp>
+#include <freeflow/proto/ncp/ncp.hpp>
+
+namespace freeflow {
+namespace cli {
+
+/// A Session is a connection to the controller's northbound interface.
+/// Requests are appended to an output buffer and sent together by
+/// flush, so any number of requests may be outstanding. Replies arrive
+/// in the order of the requests.
+class Session {
+public:
+  explicit Session(ncp::Format = ncp::BINARY);
+
+  // Connection
+  bool connect(const std::string&);
+
+  // Observers
+  ncp::Format format() const;
+
+  // Requests
+  Uint32 next_id();
+  Buffer& output();
+  Uint32 request(ncp::Message_type, const void* = nullptr, std::size_t = 0);
+  Uint32 request(ncp::Message_type, const json::Value&);
+  bool flush();
+
+  // Replies
+  bool receive(ncp::Frame&);
+
+private:
+  Socket            sock_;
+  ncp::Format       fmt_; // The format of requests
+  ncp::Frame_reader in_;  // Received replies
+  Buffer            out_; // Requests not yet sent
+  Uint32            id_;  // The id of the next request
+};
+
+// Errors
+std::string error_message(const ncp::Frame&);
+
+} // namespace cli
+} // namespace freeflow
+
+#include "session.ipp"
+
+#endif
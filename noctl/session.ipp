@@ -0,0 +1,36 @@
+// Copyright (c) 2013-2014 Flowgrammable, LLC.
+// 
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at:
+// 
+// http://www.apache.org/licenses/LICENSE-2.0
+// 
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an "AS IS"
+// BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing
+// permissions and limitations under the License.
+
+
+namespace freeflow {
+namespace cli {
+
+inline
+Session::Session(ncp::Format f) : fmt_(f), id_(1) { }
+
+/// Returns the format of requests sent by the session.
+inline ncp::Format
+Session::format() const { return fmt_; }
+
+/// Returns a new request id.
+inline Uint32
+Session::next_id() { return id_++; }
+
+/// Returns the buffer of unsent requests. Requests whose payloads are
+/// large, such as batches, are built directly in this buffer.
+inline Buffer&
+Session::output() { return out_; }
+
+} // namespace cli
+} // namespace freeflow